@@ -0,0 +1,1830 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include <rl/kin/Kinematics.h>
+#include <rl/math/Constants.h>
+#include <rl/math/Rotation.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/UrdfFactory.h>
+#include <rl/mdl/XmlFactory.h>
+#include <rl/plan/AddRrtConCon.h>
+#include <rl/plan/BridgeSampler.h>
+#include <rl/plan/ConcurrentNearestNeighbors.h>
+#include <rl/plan/DistanceField.h>
+#include <rl/plan/DistanceModel.h>
+#include <rl/plan/Eet.h>
+#include <rl/plan/GaussianSampler.h>
+#include <rl/plan/HaltonSampler.h>
+#include <rl/plan/GnatNearestNeighbors.h>
+#include <rl/plan/KdtreeBoundingBoxNearestNeighbors.h>
+#include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/LinearBlockNearestNeighbors.h>
+#include <rl/plan/LinearNearestNeighbors.h>
+#include <rl/plan/Prm.h>
+#include <rl/plan/PrmUtilityGuided.h>
+#include <rl/plan/Profiler.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/Rrt.h>
+#include <rl/plan/RrtCon.h>
+#include <rl/plan/RrtConCon.h>
+#include <rl/plan/RrtDual.h>
+#include <rl/plan/RrtExtCon.h>
+#include <rl/plan/RrtExtExt.h>
+#include <rl/plan/RrtGoalBias.h>
+#include <rl/plan/SequentialVerifier.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/SobolSampler.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/plan/WorkspaceSphereExplorer.h>
+#include <rl/sg/DistanceScene.h>
+#include <rl/sg/SimpleScene.h>
+#include <rl/sg/UrdfFactory.h>
+#include <rl/sg/XmlFactory.h>
+#include <rl/xml/Attribute.h>
+#include <rl/xml/Document.h>
+#include <rl/xml/DomParser.h>
+#include <rl/xml/Node.h>
+#include <rl/xml/Object.h>
+#include <rl/xml/Path.h>
+#include <rl/xml/Stylesheet.h>
+
+#ifdef RL_SG_BULLET
+#include <rl/sg/bullet/Scene.h>
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+#include <rl/sg/fcl/Scene.h>
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+#include <rl/sg/ode/Scene.h>
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+#include <rl/sg/pqp/Scene.h>
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+#include <rl/sg/solid/Scene.h>
+#endif // RL_SG_SOLID
+
+struct Options
+{
+	std::string csv;
+	
+	std::shared_ptr<rl::math::Real> duration;
+	
+	std::vector<std::string> engines;
+	
+	std::vector<std::string> filenames;
+	
+	std::size_t jobs;
+	
+	std::string json;
+	
+	std::vector<std::string> nearestNeighbors;
+	
+	bool quiet;
+	
+	std::size_t runs;
+	
+	std::vector<std::string> samplers;
+	
+	std::mt19937::result_type seed;
+	
+	std::string summary;
+};
+
+struct Result
+{
+	/** Calls of profiled operations. */
+	std::vector<std::size_t> calls;
+	
+	double duration;
+	
+	/** Durations of profiled operations in seconds. */
+	std::vector<double> durations;
+	
+	std::size_t edges;
+	
+	std::string engine;
+	
+	/** Duration of workspace exploration of EET in seconds. */
+	double explorationDuration;
+	
+	std::string filename;
+	
+	std::size_t freeQueries;
+	
+	rl::math::Real length;
+	
+	std::string nearestNeighbors;
+	
+	std::string planner;
+	
+	std::string sampler;
+	
+	std::mt19937::result_type seed;
+	
+	bool solved;
+	
+	/** Number of workspace spheres explored by EET. */
+	std::size_t spheres;
+	
+	std::size_t totalQueries;
+	
+	std::size_t vertices;
+};
+
+/**
+ * Objects of one planner setup, members are destroyed in reverse order.
+ */
+struct Scenario
+{
+	std::shared_ptr<rl::sg::Scene> scene;
+	
+	std::shared_ptr<rl::kin::Kinematics> kin;
+	
+	std::shared_ptr<rl::mdl::Kinematic> mdl;
+	
+	std::shared_ptr<rl::plan::SimpleModel> model;
+	
+	/** Copies of scene, kinematics, and model for worker threads. */
+	std::vector<std::shared_ptr<rl::sg::Scene>> scenes;
+	
+	std::vector<std::shared_ptr<rl::kin::Kinematics>> kins;
+	
+	std::vector<std::shared_ptr<rl::mdl::Kinematic>> mdls;
+	
+	std::vector<std::shared_ptr<rl::plan::SimpleModel>> models;
+	
+	/** Models for worker threads of batch queries. */
+	std::vector<rl::plan::SimpleModel*> workerModels;
+	
+	std::shared_ptr<rl::math::Vector> goal;
+	
+	std::shared_ptr<rl::math::Vector> sigma;
+	
+	std::shared_ptr<rl::math::Vector> start;
+	
+	std::shared_ptr<rl::plan::Sampler> sampler;
+	
+	std::shared_ptr<rl::plan::Verifier> verifier;
+	
+	std::vector<std::shared_ptr<rl::plan::NearestNeighbors>> nearestNeighbors;
+	
+	std::vector<std::shared_ptr<rl::math::Vector3>> explorerGoals;
+	
+	std::vector<std::shared_ptr<rl::math::Vector3>> explorerStarts;
+	
+	std::vector<std::shared_ptr<rl::plan::WorkspaceSphereExplorer>> explorers;
+	
+	std::shared_ptr<rl::plan::DistanceField> distanceField;
+	
+	std::shared_ptr<rl::plan::Planner> planner;
+};
+
+std::vector<std::string>
+availableEngines()
+{
+	std::vector<std::string> engines;
+#ifdef RL_SG_BULLET
+	engines.push_back("bullet");
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+	engines.push_back("fcl");
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+	engines.push_back("ode");
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+	engines.push_back("pqp");
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+	engines.push_back("solid");
+#endif // RL_SG_SOLID
+	return engines;
+}
+
+std::shared_ptr<rl::sg::Scene>
+createScene(const std::string& engine)
+{
+#ifdef RL_SG_BULLET
+	if ("bullet" == engine)
+	{
+		return std::make_shared<rl::sg::bullet::Scene>();
+	}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+	if ("fcl" == engine)
+	{
+		return std::make_shared<rl::sg::fcl::Scene>();
+	}
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+	if ("ode" == engine)
+	{
+		return std::make_shared<rl::sg::ode::Scene>();
+	}
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+	if ("pqp" == engine)
+	{
+		return std::make_shared<rl::sg::pqp::Scene>();
+	}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+	if ("solid" == engine)
+	{
+		return std::make_shared<rl::sg::solid::Scene>();
+	}
+#endif // RL_SG_SOLID
+	throw std::runtime_error("unknown engine '" + engine + "'");
+}
+
+rl::math::Real
+evalAngle(rl::xml::Path& path, const std::string& expression, const rl::math::Real& value)
+{
+	rl::math::Real angle = path.eval("number(" + expression + ")").getValue<rl::math::Real>(value);
+	
+	if ("deg" == path.eval("string(" + expression + "/@unit)").getValue<std::string>())
+	{
+		angle *= rl::math::constants::deg2rad;
+	}
+	
+	return angle;
+}
+
+void
+evalLimits(rl::xml::Path& path, const std::string& expression, rl::math::Vector& limits)
+{
+	rl::xml::NodeSet q = path.eval(expression).getValue<rl::xml::NodeSet>();
+	
+	for (int i = 0; i < q.size() && i < limits.size(); ++i)
+	{
+		std::string content = q[i].getContent();
+		
+		if (!content.empty())
+		{
+			limits(i) = std::atof(content.c_str());
+			
+			if ("deg" == q[i].getProperty("unit"))
+			{
+				limits(i) *= rl::math::constants::deg2rad;
+			}
+		}
+	}
+}
+
+std::shared_ptr<rl::math::Vector>
+evalVector(rl::xml::Path& path, const std::string& expression)
+{
+	rl::xml::NodeSet q = path.eval(expression).getValue<rl::xml::NodeSet>();
+	std::shared_ptr<rl::math::Vector> vector = std::make_shared<rl::math::Vector>(q.size());
+	
+	for (int i = 0; i < q.size(); ++i)
+	{
+		(*vector)(i) = std::atof(q[i].getContent().c_str());
+		
+		if ("deg" == q[i].getProperty("unit"))
+		{
+			(*vector)(i) *= rl::math::constants::deg2rad;
+		}
+	}
+	
+	return vector;
+}
+
+std::string
+detectNearestNeighbors(rl::xml::Path& path)
+{
+	const char* names[] = {
+		"concurrent",
+		"gnat",
+		"kdtreeBoundingBox",
+		"kdtree",
+		"linearBlock"
+	};
+	
+	for (std::size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+	{
+		if (path.eval("count((/rl/plan|/rlplan)//" + std::string(names[i]) + "NearestNeighbors) > 0").getValue<bool>())
+		{
+			return names[i];
+		}
+	}
+	
+	return "linear";
+}
+
+std::shared_ptr<rl::plan::NearestNeighbors>
+createNearestNeighbors(rl::xml::Path& path, const std::string& name, rl::plan::Model* model, const std::mt19937::result_type& seed)
+{
+	std::string prefix = "(/rl/plan|/rlplan)//" + name + "NearestNeighbors";
+	
+	if ("concurrent" == name)
+	{
+		return std::make_shared<rl::plan::ConcurrentNearestNeighbors>(
+			model,
+			path.eval("number(" + prefix + "/buffer/@size)").getValue<std::size_t>(64)
+		);
+	}
+	else if ("gnat" == name)
+	{
+		std::shared_ptr<rl::plan::GnatNearestNeighbors> gnatNearestNeighbors = std::make_shared<rl::plan::GnatNearestNeighbors>(model);
+		
+		if (path.eval("count(" + prefix + "/checks) > 0").getValue<bool>())
+		{
+			gnatNearestNeighbors->setChecks(path.eval("number(" + prefix + "/checks)").getValue<std::size_t>(0));
+		}
+		
+		gnatNearestNeighbors->setNodeDataMax(path.eval("number(" + prefix + "/node/data/@max)").getValue<std::size_t>(50));
+		gnatNearestNeighbors->setNodeDegree(path.eval("number(" + prefix + "/node/degree)").getValue<std::size_t>(8));
+		gnatNearestNeighbors->setNodeDegreeMax(path.eval("number(" + prefix + "/node/degree/@max)").getValue<std::size_t>(12));
+		gnatNearestNeighbors->setNodeDegreeMin(path.eval("number(" + prefix + "/node/degree/@min)").getValue<std::size_t>(4));
+		gnatNearestNeighbors->seed(seed);
+		return gnatNearestNeighbors;
+	}
+	else if ("kdtreeBoundingBox" == name)
+	{
+		std::shared_ptr<rl::plan::KdtreeBoundingBoxNearestNeighbors> kdtreeBoundingBoxNearestNeighbors = std::make_shared<rl::plan::KdtreeBoundingBoxNearestNeighbors>(model);
+		
+		if (path.eval("count(" + prefix + "/checks) > 0").getValue<bool>())
+		{
+			kdtreeBoundingBoxNearestNeighbors->setChecks(path.eval("number(" + prefix + "/checks)").getValue<std::size_t>(0));
+		}
+		
+		kdtreeBoundingBoxNearestNeighbors->setNodeDataMax(path.eval("number(" + prefix + "/node/data/@max)").getValue<std::size_t>(10));
+		return kdtreeBoundingBoxNearestNeighbors;
+	}
+	else if ("kdtree" == name)
+	{
+		std::shared_ptr<rl::plan::KdtreeNearestNeighbors> kdtreeNearestNeighbors = std::make_shared<rl::plan::KdtreeNearestNeighbors>(model);
+		
+		if (path.eval("count(" + prefix + "/checks) > 0").getValue<bool>())
+		{
+			kdtreeNearestNeighbors->setChecks(path.eval("number(" + prefix + "/checks)").getValue<std::size_t>(0));
+		}
+		
+		kdtreeNearestNeighbors->setSamples(path.eval("number(" + prefix + "/samples)").getValue<std::size_t>(100));
+		return kdtreeNearestNeighbors;
+	}
+	else if ("linearBlock" == name)
+	{
+		return std::make_shared<rl::plan::LinearBlockNearestNeighbors>(model);
+	}
+	else if ("linear" == name)
+	{
+		return std::make_shared<rl::plan::LinearNearestNeighbors>(model);
+	}
+	
+	throw std::runtime_error("unknown nearest neighbors '" + name + "'");
+}
+
+std::string
+detectSampler(rl::xml::Path& path)
+{
+	const char* names[] = {
+		"bridge",
+		"gaussian",
+		"halton",
+		"sobol"
+	};
+	
+	for (std::size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+	{
+		if (path.eval("count((/rl/plan|/rlplan)//" + std::string(names[i]) + "Sampler) > 0").getValue<bool>())
+		{
+			return names[i];
+		}
+	}
+	
+	return "uniform";
+}
+
+std::shared_ptr<rl::plan::Sampler>
+createSampler(rl::xml::Path& path, const std::string& name, rl::math::Vector* sigma, const std::mt19937::result_type& seed)
+{
+	std::string prefix = "(/rl/plan|/rlplan)//" + name + "Sampler";
+	bool scrambled = !path.eval("translate(string(" + prefix + "/scrambled), 'FALSE', 'false') = 'false' or string(" + prefix + "/scrambled) = '0'").getValue<bool>();
+	
+	if (("bridge" == name || "gaussian" == name) && nullptr == sigma)
+	{
+		throw std::runtime_error("sampler '" + name + "' requires sigma");
+	}
+	
+	if ("bridge" == name)
+	{
+		std::shared_ptr<rl::plan::BridgeSampler> bridgeSampler = std::make_shared<rl::plan::BridgeSampler>();
+		bridgeSampler->setRatio(path.eval("number(" + prefix + "/ratio)").getValue<rl::math::Real>(static_cast<rl::math::Real>(5) / static_cast<rl::math::Real>(6)));
+		bridgeSampler->seed(seed);
+		bridgeSampler->setSigma(sigma);
+		return bridgeSampler;
+	}
+	else if ("gaussian" == name)
+	{
+		std::shared_ptr<rl::plan::GaussianSampler> gaussianSampler = std::make_shared<rl::plan::GaussianSampler>();
+		gaussianSampler->seed(seed);
+		gaussianSampler->setSigma(sigma);
+		return gaussianSampler;
+	}
+	else if ("halton" == name)
+	{
+		std::shared_ptr<rl::plan::HaltonSampler> haltonSampler = std::make_shared<rl::plan::HaltonSampler>();
+		haltonSampler->setScrambled(scrambled);
+		haltonSampler->seed(seed);
+		return haltonSampler;
+	}
+	else if ("sobol" == name)
+	{
+		std::shared_ptr<rl::plan::SobolSampler> sobolSampler = std::make_shared<rl::plan::SobolSampler>();
+		sobolSampler->setScrambled(scrambled);
+		sobolSampler->seed(seed);
+		return sobolSampler;
+	}
+	else if ("uniform" == name)
+	{
+		std::shared_ptr<rl::plan::UniformSampler> uniformSampler = std::make_shared<rl::plan::UniformSampler>();
+		uniformSampler->seed(seed);
+		return uniformSampler;
+	}
+	
+	throw std::runtime_error("unknown sampler '" + name + "'");
+}
+
+void
+loadExplorers(rl::xml::Document& document, rl::xml::Path& path, Scenario& scenario, rl::plan::Eet* eet, const std::mt19937::result_type& seed)
+{
+	rl::plan::DistanceModel* model = dynamic_cast<rl::plan::DistanceModel*>(scenario.model.get());
+	
+	if (nullptr == model)
+	{
+		throw std::runtime_error("selected engine does not support distance queries");
+	}
+	
+	rl::xml::NodeSet explorers = path.eval("explorer").getValue<rl::xml::NodeSet>();
+	
+	for (int i = 0; i < explorers.size(); ++i)
+	{
+		rl::xml::Path path(document, explorers[i]);
+		
+		std::shared_ptr<rl::plan::WorkspaceSphereExplorer> explorer = std::make_shared<rl::plan::WorkspaceSphereExplorer>();
+		scenario.explorers.push_back(explorer);
+		eet->addExplorer(explorer.get());
+		
+		rl::plan::Eet::ExplorerSetup explorerSetup;
+		explorerSetup.goalConfiguration = nullptr;
+		explorerSetup.goalFrame = -1;
+		explorerSetup.startConfiguration = nullptr;
+		explorerSetup.startFrame = -1;
+		
+		std::shared_ptr<rl::math::Vector3> explorerStart = std::make_shared<rl::math::Vector3>(
+			path.eval("number(start/x)").getValue<rl::math::Real>(0),
+			path.eval("number(start/y)").getValue<rl::math::Real>(0),
+			path.eval("number(start/z)").getValue<rl::math::Real>(0)
+		);
+		scenario.explorerStarts.push_back(explorerStart);
+		explorer->setStart(explorerStart.get());
+		
+		if (path.eval("count(start/goal) > 0").getValue<bool>())
+		{
+			explorerSetup.startConfiguration = scenario.goal.get();
+		}
+		else if (path.eval("count(start/start) > 0").getValue<bool>())
+		{
+			explorerSetup.startConfiguration = scenario.start.get();
+		}
+		
+		if (path.eval("count(start//frame) > 0").getValue<bool>())
+		{
+			explorerSetup.startFrame = path.eval("number(start//frame)").getValue<std::size_t>();
+		}
+		
+		std::shared_ptr<rl::math::Vector3> explorerGoal = std::make_shared<rl::math::Vector3>(
+			path.eval("number(goal/x)").getValue<rl::math::Real>(0),
+			path.eval("number(goal/y)").getValue<rl::math::Real>(0),
+			path.eval("number(goal/z)").getValue<rl::math::Real>(0)
+		);
+		scenario.explorerGoals.push_back(explorerGoal);
+		explorer->setGoal(explorerGoal.get());
+		
+		if (path.eval("count(goal/goal) > 0").getValue<bool>())
+		{
+			explorerSetup.goalConfiguration = scenario.goal.get();
+		}
+		else if (path.eval("count(goal/start) > 0").getValue<bool>())
+		{
+			explorerSetup.goalConfiguration = scenario.start.get();
+		}
+		
+		if (path.eval("count(goal//frame) > 0").getValue<bool>())
+		{
+			explorerSetup.goalFrame = path.eval("number(goal//frame)").getValue<std::size_t>();
+		}
+		
+		explorer->setBoundingBox(
+			rl::math::AlignedBox3(
+				rl::math::Vector3(
+					path.eval("number(boundingBox/min/x)").getValue<rl::math::Real>(-std::numeric_limits<rl::math::Real>::max()),
+					path.eval("number(boundingBox/min/y)").getValue<rl::math::Real>(-std::numeric_limits<rl::math::Real>::max()),
+					path.eval("number(boundingBox/min/z)").getValue<rl::math::Real>(-std::numeric_limits<rl::math::Real>::max())
+				),
+				rl::math::Vector3(
+					path.eval("number(boundingBox/max/x)").getValue<rl::math::Real>(std::numeric_limits<rl::math::Real>::max()),
+					path.eval("number(boundingBox/max/y)").getValue<rl::math::Real>(std::numeric_limits<rl::math::Real>::max()),
+					path.eval("number(boundingBox/max/z)").getValue<rl::math::Real>(std::numeric_limits<rl::math::Real>::max())
+				)
+			)
+		);
+		
+		if (path.eval("count(distance) > 0").getValue<bool>())
+		{
+			explorer->setGreedy(rl::plan::WorkspaceSphereExplorer::Greedy::distance);
+		}
+		else if (path.eval("count(sourceDistance) > 0").getValue<bool>())
+		{
+			explorer->setGreedy(rl::plan::WorkspaceSphereExplorer::Greedy::sourceDistance);
+		}
+		else if (path.eval("count(space) > 0").getValue<bool>())
+		{
+			explorer->setGreedy(rl::plan::WorkspaceSphereExplorer::Greedy::space);
+		}
+		
+		explorer->setModel(model);
+		explorer->setRadius(path.eval("number(radius)").getValue<rl::math::Real>(0));
+		explorer->setRange(path.eval("number(range)").getValue<rl::math::Real>(std::numeric_limits<rl::math::Real>::max()));
+		explorer->setSamples(path.eval("number(samples)").getValue<std::size_t>(10));
+		explorer->seed(seed);
+		
+		eet->addExplorerSetup(explorerSetup);
+	}
+	
+	if (path.eval("count(distanceField) > 0").getValue<bool>())
+	{
+		scenario.distanceField = std::make_shared<rl::plan::DistanceField>();
+		scenario.distanceField->setBoundingBox(rl::math::AlignedBox3(eet->getMin(), eet->getMax()));
+		scenario.distanceField->setResolution(path.eval("number(distanceField/resolution)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.05)));
+		
+		std::string distanceFieldFilename;
+		
+		if (path.eval("count(distanceField/@href) > 0").getValue<bool>())
+		{
+			rl::xml::NodeSet distanceField = path.eval("distanceField").getValue<rl::xml::NodeSet>();
+			distanceFieldFilename = distanceField[0].getLocalPath(distanceField[0].getProperty("href"));
+			
+			try
+			{
+				scenario.distanceField->load(distanceFieldFilename, model);
+			}
+			catch (const std::exception&)
+			{
+				// missing or outdated file is rebuilt
+			}
+		}
+		
+		if (scenario.distanceField->empty())
+		{
+			std::vector<rl::plan::SimpleModel*> models = scenario.workerModels;
+			
+			if (models.empty())
+			{
+				models.push_back(model);
+			}
+			
+			scenario.distanceField->build(models);
+			
+			if (!distanceFieldFilename.empty())
+			{
+				scenario.distanceField->save(distanceFieldFilename);
+			}
+		}
+		
+		model->field = scenario.distanceField.get();
+	}
+}
+
+/**
+ * Loads scene, kinematics, and collision model.
+ *
+ * Called once per worker thread for copies used in batch queries, as
+ * collision queries modify the state of scene and kinematics.
+ */
+void
+loadModel(rl::xml::Path& path, const std::string& engine, std::shared_ptr<rl::sg::Scene>& scene, std::shared_ptr<rl::kin::Kinematics>& kin, std::shared_ptr<rl::mdl::Kinematic>& mdl, std::shared_ptr<rl::plan::SimpleModel>& model)
+{
+	scene = createScene(engine);
+	
+	rl::xml::NodeSet modelScene = path.eval("(/rl/plan|/rlplan)//model/scene").getValue<rl::xml::NodeSet>();
+	std::string modelSceneFilename = modelScene[0].getLocalPath(modelScene[0].getProperty("href"));
+	
+	if ("urdf" == modelSceneFilename.substr(modelSceneFilename.length() - 4, 4))
+	{
+		rl::sg::UrdfFactory sceneFactory;
+		sceneFactory.load(modelSceneFilename, scene.get());
+	}
+	else
+	{
+		rl::sg::XmlFactory sceneFactory;
+		sceneFactory.load(modelSceneFilename, scene.get());
+	}
+	
+	rl::xml::NodeSet modelKinematics = path.eval("(/rl/plan|/rlplan)//model/kinematics").getValue<rl::xml::NodeSet>();
+	std::string modelKinematicsFilename = modelKinematics[0].getLocalPath(modelKinematics[0].getProperty("href"));
+	
+	if ("urdf" == modelKinematicsFilename.substr(modelKinematicsFilename.length() - 4, 4))
+	{
+		rl::mdl::UrdfFactory modelFactory;
+		mdl = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(modelKinematicsFilename));
+	}
+	else if ("mdl" == modelKinematics[0].getProperty("type"))
+	{
+		rl::mdl::XmlFactory modelFactory;
+		mdl = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(modelKinematicsFilename));
+	}
+	else
+	{
+		kin = rl::kin::Kinematics::create(modelKinematicsFilename);
+	}
+	
+	if (path.eval("count((/rl/plan|/rlplan)//model/kinematics/world) > 0").getValue<bool>())
+	{
+		rl::math::Transform& world = nullptr != kin ? kin->world() : mdl->world();
+		
+		world.linear() = rl::math::AngleAxis(
+			path.eval("number((/rl/plan|/rlplan)//model/kinematics/world/rotation/z)").getValue<rl::math::Real>(0) * rl::math::constants::deg2rad,
+			rl::math::Vector3::UnitZ()
+		) * rl::math::AngleAxis(
+			path.eval("number((/rl/plan|/rlplan)//model/kinematics/world/rotation/y)").getValue<rl::math::Real>(0) * rl::math::constants::deg2rad,
+			rl::math::Vector3::UnitY()
+		) * rl::math::AngleAxis(
+			path.eval("number((/rl/plan|/rlplan)//model/kinematics/world/rotation/x)").getValue<rl::math::Real>(0) * rl::math::constants::deg2rad,
+			rl::math::Vector3::UnitX()
+		).toRotationMatrix();
+		
+		world.translation().x() = path.eval("number((/rl/plan|/rlplan)//model/kinematics/world/translation/x)").getValue<rl::math::Real>(0);
+		world.translation().y() = path.eval("number((/rl/plan|/rlplan)//model/kinematics/world/translation/y)").getValue<rl::math::Real>(0);
+		world.translation().z() = path.eval("number((/rl/plan|/rlplan)//model/kinematics/world/translation/z)").getValue<rl::math::Real>(0);
+	}
+	
+	if (nullptr != kin)
+	{
+		rl::math::Vector maximum(kin->getDof());
+		kin->getMaximum(maximum);
+		evalLimits(path, "(/rl/plan|/rlplan)//model/kinematics/max/q", maximum);
+		kin->setMaximum(maximum);
+		
+		rl::math::Vector minimum(kin->getDof());
+		kin->getMinimum(minimum);
+		evalLimits(path, "(/rl/plan|/rlplan)//model/kinematics/min/q", minimum);
+		kin->setMinimum(minimum);
+	}
+	else
+	{
+		rl::math::Vector maximum = mdl->getMaximum();
+		evalLimits(path, "(/rl/plan|/rlplan)//model/kinematics/max/q", maximum);
+		mdl->setMaximum(maximum);
+		
+		rl::math::Vector minimum = mdl->getMinimum();
+		evalLimits(path, "(/rl/plan|/rlplan)//model/kinematics/min/q", minimum);
+		mdl->setMinimum(minimum);
+	}
+	
+	if (nullptr != dynamic_cast<rl::sg::DistanceScene*>(scene.get()))
+	{
+		model = std::make_shared<rl::plan::DistanceModel>();
+	}
+	else if (nullptr != dynamic_cast<rl::sg::SimpleScene*>(scene.get()))
+	{
+		model = std::make_shared<rl::plan::SimpleModel>();
+	}
+	else
+	{
+		throw std::runtime_error("selected engine does not support collision queries");
+	}
+	
+	model->kin = kin.get();
+	model->mdl = mdl.get();
+	model->model = scene->getModel(
+		path.eval("number((/rl/plan|/rlplan)//model/model)").getValue<std::size_t>()
+	);
+	model->scene = scene.get();
+}
+
+/**
+ * Throws for elements of rlPlanDemo that are not supported, so that results
+ * are never silently based on a different setup than the demo would use.
+ */
+void
+checkSupported(rl::xml::Path& path, const std::string& filename)
+{
+	const char* names[] = {
+		"advancedOptimizer",
+		"chompOptimizer",
+		"shortcutOptimizer",
+		"simpleOptimizer"
+	};
+	
+	for (std::size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i)
+	{
+		if (path.eval("count((/rl/plan|/rlplan)//" + std::string(names[i]) + ") > 0").getValue<bool>())
+		{
+			throw std::runtime_error("element '" + std::string(names[i]) + "' in '" + filename + "' is not supported");
+		}
+	}
+}
+
+/**
+ * Creates all objects of a planner setup in the same way as rlPlanDemo.
+ *
+ * Viewer settings are ignored, optimizers are refused, and all random
+ * number generators are seeded with the seed of the run.
+ */
+void
+load(const std::string& filename, const std::string& engine, const std::string& nearestNeighbors, const std::string& sampler, const std::mt19937::result_type& seed, const Options& options, Scenario& scenario)
+{
+	rl::xml::DomParser parser;
+	
+	rl::xml::Document document = parser.readFile(filename, "", XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+	document.substitute(XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+	
+	if ("stylesheet" == document.getRootElement().getName() || "transform" == document.getRootElement().getName())
+	{
+		if ("1.0" == document.getRootElement().getProperty("version"))
+		{
+			if (document.getRootElement().hasNamespace() && "http://www.w3.org/1999/XSL/Transform" == document.getRootElement().getNamespace().getHref())
+			{
+				rl::xml::Stylesheet stylesheet(document);
+				document = stylesheet.apply();
+			}
+		}
+	}
+	
+	rl::xml::Path path(document);
+	
+	checkSupported(path, filename);
+	
+	loadModel(path, engine, scenario.scene, scenario.kin, scenario.mdl, scenario.model);
+	
+	// ODE is initialized without support for collision queries in multiple threads
+	if ("ode" != engine)
+	{
+		scenario.scenes.resize(std::max(1u, std::thread::hardware_concurrency()));
+		scenario.kins.resize(scenario.scenes.size());
+		scenario.mdls.resize(scenario.scenes.size());
+		scenario.models.resize(scenario.scenes.size());
+		
+		for (std::size_t i = 0; i < scenario.scenes.size(); ++i)
+		{
+			loadModel(path, engine, scenario.scenes[i], scenario.kins[i], scenario.mdls[i], scenario.models[i]);
+			scenario.workerModels.push_back(scenario.models[i].get());
+		}
+	}
+	
+	scenario.start = evalVector(path, "(/rl/plan|/rlplan)//start/q");
+	scenario.goal = evalVector(path, "(/rl/plan|/rlplan)//goal/q");
+	
+	if (path.eval("count((/rl/plan|/rlplan)//sigma) > 0").getValue<bool>())
+	{
+		scenario.sigma = evalVector(path, "(/rl/plan|/rlplan)//sigma/q");
+	}
+	
+	scenario.sampler = createSampler(path, sampler, scenario.sigma.get(), seed);
+	scenario.sampler->setModel(scenario.model.get());
+	scenario.sampler->setModels(scenario.workerModels);
+	
+	if (path.eval("count((/rl/plan|/rlplan)//recursiveVerifier) > 0").getValue<bool>())
+	{
+		scenario.verifier = std::make_shared<rl::plan::RecursiveVerifier>();
+		scenario.verifier->setDelta(evalAngle(path, "(/rl/plan|/rlplan)//recursiveVerifier/delta", 1));
+	}
+	else if (path.eval("count((/rl/plan|/rlplan)//sequentialVerifier) > 0").getValue<bool>())
+	{
+		scenario.verifier = std::make_shared<rl::plan::SequentialVerifier>();
+		scenario.verifier->setDelta(evalAngle(path, "(/rl/plan|/rlplan)//sequentialVerifier/delta", 1));
+	}
+	
+	if (nullptr != scenario.verifier)
+	{
+		scenario.verifier->setModel(scenario.model.get());
+		scenario.verifier->setModels(scenario.workerModels);
+	}
+	
+	rl::xml::NodeSet planners = path.eval("(/rl/plan|/rlplan)//addRrtConCon|(/rl/plan|/rlplan)//eet|(/rl/plan|/rlplan)//prm|(/rl/plan|/rlplan)//prmUtilityGuided|(/rl/plan|/rlplan)//rrt|(/rl/plan|/rlplan)//rrtCon|(/rl/plan|/rlplan)//rrtConCon|(/rl/plan|/rlplan)//rrtDual|(/rl/plan|/rlplan)//rrtGoalBias|(/rl/plan|/rlplan)//rrtExtCon|(/rl/plan|/rlplan)//rrtExtExt").getValue<rl::xml::NodeSet>();
+	
+	if (planners.empty())
+	{
+		throw std::runtime_error("no planner specified in '" + filename + "'");
+	}
+	
+	rl::xml::Path plannerPath(document, planners[0]);
+	std::string name = planners[0].getName();
+	
+	if ("addRrtConCon" == name)
+	{
+		std::shared_ptr<rl::plan::AddRrtConCon> addRrtConCon = std::make_shared<rl::plan::AddRrtConCon>();
+		addRrtConCon->setAlpha(plannerPath.eval("number(alpha)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.05)));
+		addRrtConCon->setLower(evalAngle(plannerPath, "lower", 2));
+		addRrtConCon->setRadius(evalAngle(plannerPath, "radius", 20));
+		scenario.planner = addRrtConCon;
+	}
+	else if ("eet" == name)
+	{
+		std::shared_ptr<rl::plan::Eet> eet = std::make_shared<rl::plan::Eet>();
+		eet->setAlpha(plannerPath.eval("number(alpha)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.01)));
+		eet->setAlternativeDistanceComputation(plannerPath.eval("count(alternativeDistanceComputation) > 0").getValue<bool>());
+		eet->setBeta(plannerPath.eval("number(beta)").getValue<rl::math::Real>(0));
+		eet->setDistanceWeight(plannerPath.eval("number(distanceWeight)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.1)));
+		eet->setGamma(plannerPath.eval("number(gamma)").getValue<rl::math::Real>(static_cast<rl::math::Real>(1) / static_cast<rl::math::Real>(3)));
+		eet->setGoalEpsilon(plannerPath.eval("number(goalEpsilon)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.1)));
+		eet->setGoalEpsilonUseOrientation(plannerPath.eval("translate(string(goalEpsilon/@orientation), 'TRUE', 'true') = 'true' or string(goalEpsilon/@orientation) = '1'").getValue<bool>());
+		eet->setMax(
+			rl::math::Vector3(
+				plannerPath.eval("number(max/x)").getValue<rl::math::Real>(0),
+				plannerPath.eval("number(max/y)").getValue<rl::math::Real>(0),
+				plannerPath.eval("number(max/z)").getValue<rl::math::Real>(0)
+			)
+		);
+		eet->setMin(
+			rl::math::Vector3(
+				plannerPath.eval("number(min/x)").getValue<rl::math::Real>(0),
+				plannerPath.eval("number(min/y)").getValue<rl::math::Real>(0),
+				plannerPath.eval("number(min/z)").getValue<rl::math::Real>(0)
+			)
+		);
+		loadExplorers(document, plannerPath, scenario, eet.get(), seed);
+		scenario.planner = eet;
+	}
+	else if ("prm" == name)
+	{
+		scenario.planner = std::make_shared<rl::plan::Prm>();
+	}
+	else if ("prmUtilityGuided" == name)
+	{
+		std::shared_ptr<rl::plan::PrmUtilityGuided> prmUtilityGuided = std::make_shared<rl::plan::PrmUtilityGuided>();
+		prmUtilityGuided->seed(seed);
+		scenario.planner = prmUtilityGuided;
+	}
+	else if ("rrt" == name)
+	{
+		scenario.planner = std::make_shared<rl::plan::Rrt>();
+	}
+	else if ("rrtCon" == name)
+	{
+		scenario.planner = std::make_shared<rl::plan::RrtCon>();
+	}
+	else if ("rrtConCon" == name)
+	{
+		scenario.planner = std::make_shared<rl::plan::RrtConCon>();
+	}
+	else if ("rrtDual" == name)
+	{
+		scenario.planner = std::make_shared<rl::plan::RrtDual>();
+	}
+	else if ("rrtExtCon" == name)
+	{
+		scenario.planner = std::make_shared<rl::plan::RrtExtCon>();
+	}
+	else if ("rrtExtExt" == name)
+	{
+		scenario.planner = std::make_shared<rl::plan::RrtExtExt>();
+	}
+	else if ("rrtGoalBias" == name)
+	{
+		scenario.planner = std::make_shared<rl::plan::RrtGoalBias>();
+	}
+	
+	if (rl::plan::Prm* prm = dynamic_cast<rl::plan::Prm*>(scenario.planner.get()))
+	{
+		prm->setBatchSize(plannerPath.eval("number(batchSize)").getValue<std::size_t>(1));
+		prm->setMaxDegree(plannerPath.eval("number(degree)").getValue<std::size_t>(std::numeric_limits<std::size_t>::max()));
+		
+		if (plannerPath.eval("count(dijkstra) > 0").getValue<bool>())
+		{
+			prm->setSearch(rl::plan::Prm::Search::dijkstra);
+		}
+		
+		prm->setMaxNeighbors(plannerPath.eval("number(k)").getValue<std::size_t>(30));
+		prm->setMaxRadius(evalAngle(plannerPath, "radius", std::numeric_limits<rl::math::Real>::max()));
+		prm->setSampler(scenario.sampler.get());
+		prm->setVerifier(scenario.verifier.get());
+	}
+	else if (rl::plan::Rrt* rrt = dynamic_cast<rl::plan::Rrt*>(scenario.planner.get()))
+	{
+		rrt->setDelta(evalAngle(plannerPath, "delta", 1));
+		rrt->setEpsilon(evalAngle(plannerPath, "epsilon", static_cast<rl::math::Real>(1.0e-3)));
+		rrt->setSampler(scenario.sampler.get());
+		
+		if (rl::plan::RrtGoalBias* rrtGoalBias = dynamic_cast<rl::plan::RrtGoalBias*>(rrt))
+		{
+			rrtGoalBias->setProbability(plannerPath.eval("number(probability)").getValue<rl::math::Real>(rrtGoalBias->getProbability()));
+			rrtGoalBias->seed(seed);
+		}
+	}
+	
+	std::size_t nearestNeighborsSize = nullptr != dynamic_cast<rl::plan::RrtDual*>(scenario.planner.get()) ? 2 : 1;
+	
+	for (std::size_t i = 0; i < nearestNeighborsSize; ++i)
+	{
+		scenario.nearestNeighbors.push_back(createNearestNeighbors(path, nearestNeighbors, scenario.model.get(), seed));
+		
+		if (rl::plan::Prm* prm = dynamic_cast<rl::plan::Prm*>(scenario.planner.get()))
+		{
+			prm->setNearestNeighbors(scenario.nearestNeighbors.back().get());
+		}
+		else if (rl::plan::Rrt* rrt = dynamic_cast<rl::plan::Rrt*>(scenario.planner.get()))
+		{
+			rrt->setNearestNeighbors(scenario.nearestNeighbors.back().get(), i);
+		}
+	}
+	
+	scenario.planner->setDuration(
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+			std::chrono::duration<float>(
+				nullptr != options.duration ? *options.duration : path.eval("number((/rl/plan|/rlplan)//duration)").getValue<rl::math::Real>(std::numeric_limits<float>::max())
+			)
+		)
+	);
+	
+	scenario.planner->setGoal(scenario.goal.get());
+	scenario.planner->setModel(scenario.model.get());
+	scenario.planner->setStart(scenario.start.get());
+}
+
+Result
+run(const std::string& filename, const std::string& engine, const std::string& nearestNeighbors, const std::string& sampler, const std::mt19937::result_type& seed, const Options& options)
+{
+	rl::plan::Profiler profiler;
+	Scenario scenario;
+	
+	std::string name = nearestNeighbors;
+	std::string samplerName = sampler;
+	
+	if (name.empty() || samplerName.empty())
+	{
+		rl::xml::DomParser parser;
+		rl::xml::Document document = parser.readFile(filename, "", XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+		document.substitute(XML_PARSE_NOENT | XML_PARSE_XINCLUDE);
+		rl::xml::Path path(document);
+		
+		if (name.empty())
+		{
+			name = detectNearestNeighbors(path);
+		}
+		
+		if (samplerName.empty())
+		{
+			samplerName = detectSampler(path);
+		}
+	}
+	
+	load(filename, engine, name, samplerName, seed, options, scenario);
+	
+	Result result;
+	result.engine = engine;
+	result.filename = filename;
+	result.nearestNeighbors = name;
+	result.planner = scenario.planner->getName();
+	result.sampler = samplerName;
+	result.seed = seed;
+	
+	if (!scenario.planner->verify())
+	{
+		throw std::runtime_error("start or goal configuration of '" + filename + "' is invalid");
+	}
+	
+	scenario.model->setProfiler(&profiler);
+	scenario.planner->setProfiler(&profiler);
+	
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	result.solved = scenario.planner->solve();
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	
+	result.duration = std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count();
+	
+	for (std::size_t i = 0; i < rl::plan::Profiler::COUNTERS; ++i)
+	{
+		result.calls.push_back(profiler.getCalls(static_cast<rl::plan::Profiler::Counter>(i)));
+		result.durations.push_back(std::chrono::duration_cast<std::chrono::duration<double>>(profiler.getDuration(static_cast<rl::plan::Profiler::Counter>(i))).count());
+	}
+	
+	result.freeQueries = scenario.model->getFreeQueries();
+	result.totalQueries = scenario.model->getTotalQueries();
+	result.edges = 0;
+	result.explorationDuration = 0;
+	result.spheres = 0;
+	result.vertices = 0;
+	
+	if (rl::plan::Eet* eet = dynamic_cast<rl::plan::Eet*>(scenario.planner.get()))
+	{
+		result.explorationDuration = std::chrono::duration_cast<std::chrono::duration<double>>(eet->getExplorationDuration()).count();
+		
+		for (std::size_t i = 0; i < scenario.explorers.size(); ++i)
+		{
+			result.spheres += scenario.explorers[i]->getNumVertices();
+		}
+	}
+	
+	if (rl::plan::Prm* prm = dynamic_cast<rl::plan::Prm*>(scenario.planner.get()))
+	{
+		result.edges = prm->getNumEdges();
+		result.vertices = prm->getNumVertices();
+	}
+	else if (rl::plan::Rrt* rrt = dynamic_cast<rl::plan::Rrt*>(scenario.planner.get()))
+	{
+		result.edges = rrt->getNumEdges();
+		result.vertices = rrt->getNumVertices();
+	}
+	
+	result.length = 0;
+	
+	if (result.solved)
+	{
+		rl::plan::VectorList path = scenario.planner->getPath();
+		rl::plan::VectorList::iterator i = path.begin();
+		rl::plan::VectorList::iterator j = ++path.begin();
+		
+		for (; i != path.end() && j != path.end(); ++i, ++j)
+		{
+			result.length += scenario.model->distance(*i, *j);
+		}
+	}
+	
+	return result;
+}
+
+std::string
+quote(const std::string& value)
+{
+	if (std::string::npos == value.find_first_of(",\"\n"))
+	{
+		return value;
+	}
+	
+	std::string quoted = "\"";
+	
+	for (std::size_t i = 0; i < value.size(); ++i)
+	{
+		quoted += '"' == value[i] ? "\"\"" : std::string(1, value[i]);
+	}
+	
+	return quoted + "\"";
+}
+
+std::vector<std::string>
+split(const std::string& line)
+{
+	std::vector<std::string> fields(1);
+	bool quoted = false;
+	
+	for (std::size_t i = 0; i < line.size(); ++i)
+	{
+		if ('"' == line[i] && quoted && i + 1 < line.size() && '"' == line[i + 1])
+		{
+			fields.back() += '"';
+			++i;
+		}
+		else if ('"' == line[i])
+		{
+			quoted = !quoted;
+		}
+		else if (',' == line[i] && !quoted)
+		{
+			fields.push_back(std::string());
+		}
+		else
+		{
+			fields.back() += line[i];
+		}
+	}
+	
+	return fields;
+}
+
+void
+writeHeader(std::ostream& stream)
+{
+	stream << "File,Engine,Planner,Nearest Neighbors,Sampler,Seed,Solved,Duration (s),Total CD,Free CD,Vertices,Edges,Path Length,Spheres,Exploration Duration (s)";
+	
+	for (std::size_t i = 0; i < rl::plan::Profiler::COUNTERS; ++i)
+	{
+		std::string name = rl::plan::Profiler::getName(static_cast<rl::plan::Profiler::Counter>(i));
+		stream << "," << name << " Calls," << name << " (s)";
+	}
+	
+	stream << std::endl;
+}
+
+void
+writeResult(std::ostream& stream, const Result& result)
+{
+	stream << quote(result.filename);
+	stream << "," << result.engine;
+	stream << "," << quote(result.planner);
+	stream << "," << result.nearestNeighbors;
+	stream << "," << result.sampler;
+	stream << "," << result.seed;
+	stream << "," << (result.solved ? "true" : "false");
+	stream << "," << result.duration;
+	stream << "," << result.totalQueries;
+	stream << "," << result.freeQueries;
+	stream << "," << result.vertices;
+	stream << "," << result.edges;
+	stream << "," << result.length;
+	stream << "," << result.spheres;
+	stream << "," << result.explorationDuration;
+	
+	for (std::size_t i = 0; i < result.calls.size(); ++i)
+	{
+		stream << "," << result.calls[i] << "," << result.durations[i];
+	}
+	
+	stream << std::endl;
+}
+
+Result
+readResult(const std::string& line)
+{
+	std::vector<std::string> fields = split(line);
+	
+	if (fields.size() < 15)
+	{
+		throw std::runtime_error("invalid result '" + line + "'");
+	}
+	
+	Result result;
+	result.filename = fields[0];
+	result.engine = fields[1];
+	result.planner = fields[2];
+	result.nearestNeighbors = fields[3];
+	result.sampler = fields[4];
+	result.seed = boost::lexical_cast<std::mt19937::result_type>(fields[5]);
+	result.solved = "true" == fields[6];
+	result.duration = boost::lexical_cast<double>(fields[7]);
+	result.totalQueries = boost::lexical_cast<std::size_t>(fields[8]);
+	result.freeQueries = boost::lexical_cast<std::size_t>(fields[9]);
+	result.vertices = boost::lexical_cast<std::size_t>(fields[10]);
+	result.edges = boost::lexical_cast<std::size_t>(fields[11]);
+	result.length = boost::lexical_cast<rl::math::Real>(fields[12]);
+	result.spheres = boost::lexical_cast<std::size_t>(fields[13]);
+	result.explorationDuration = boost::lexical_cast<double>(fields[14]);
+	
+	for (std::size_t i = 15; i + 1 < fields.size(); i += 2)
+	{
+		result.calls.push_back(boost::lexical_cast<std::size_t>(fields[i]));
+		result.durations.push_back(boost::lexical_cast<double>(fields[i + 1]));
+	}
+	
+	return result;
+}
+
+/**
+ * Linear interpolation between closest ranks of sorted values.
+ */
+double
+percentile(const std::vector<double>& values, const double& p)
+{
+	if (values.empty())
+	{
+		return 0;
+	}
+	
+	double rank = p * (values.size() - 1);
+	std::size_t i = static_cast<std::size_t>(rank);
+	std::size_t j = std::min(i + 1, values.size() - 1);
+	return values[i] + (rank - i) * (values[j] - values[i]);
+}
+
+struct Summary
+{
+	/** Mean calls of profiled operations. */
+	std::vector<double> calls;
+	
+	/** Mean durations of profiled operations in seconds. */
+	std::vector<double> durations;
+	
+	std::size_t runs;
+	
+	std::size_t solved;
+	
+	double successRate;
+	
+	double durationMean;
+	
+	double durationMin;
+	
+	double durationMedian;
+	
+	double durationP90;
+	
+	double durationP95;
+	
+	double durationMax;
+	
+	double totalQueries;
+	
+	double freeQueries;
+	
+	double vertices;
+	
+	double edges;
+	
+	double explorationDurationMean;
+	
+	double lengthMedian;
+	
+	double spheres;
+	
+	/** Median number of vertices of solved runs, i.e., roadmap or tree size required for a solution. */
+	double verticesSolvedMedian;
+};
+
+typedef std::tuple<std::string, std::string, std::string, std::string, std::string> Key;
+
+std::map<Key, Summary>
+summarize(const std::vector<Result>& results)
+{
+	std::map<Key, std::vector<const Result*>> groups;
+	
+	for (std::size_t i = 0; i < results.size(); ++i)
+	{
+		groups[Key(results[i].filename, results[i].engine, results[i].planner, results[i].nearestNeighbors, results[i].sampler)].push_back(&results[i]);
+	}
+	
+	std::map<Key, Summary> summaries;
+	
+	for (std::map<Key, std::vector<const Result*>>::const_iterator i = groups.begin(); i != groups.end(); ++i)
+	{
+		Summary summary = Summary();
+		summary.calls.resize(rl::plan::Profiler::COUNTERS, 0);
+		summary.durations.resize(rl::plan::Profiler::COUNTERS, 0);
+		std::vector<double> durations;
+		std::vector<double> lengths;
+		std::vector<double> vertices;
+		
+		for (std::size_t j = 0; j < i->second.size(); ++j)
+		{
+			const Result& result = *i->second[j];
+			durations.push_back(result.duration);
+			
+			if (result.solved)
+			{
+				lengths.push_back(result.length);
+				vertices.push_back(result.vertices);
+				++summary.solved;
+			}
+			
+			summary.durationMean += result.duration;
+			summary.totalQueries += result.totalQueries;
+			summary.freeQueries += result.freeQueries;
+			summary.vertices += result.vertices;
+			summary.edges += result.edges;
+			summary.explorationDurationMean += result.explorationDuration;
+			summary.spheres += result.spheres;
+			
+			for (std::size_t k = 0; k < result.calls.size() && k < summary.calls.size(); ++k)
+			{
+				summary.calls[k] += result.calls[k];
+				summary.durations[k] += result.durations[k];
+			}
+		}
+		
+		std::sort(durations.begin(), durations.end());
+		std::sort(lengths.begin(), lengths.end());
+		std::sort(vertices.begin(), vertices.end());
+		
+		summary.runs = i->second.size();
+		summary.successRate = static_cast<double>(summary.solved) / summary.runs;
+		summary.durationMean /= summary.runs;
+		summary.durationMin = durations.front();
+		summary.durationMedian = percentile(durations, 0.5);
+		summary.durationP90 = percentile(durations, 0.9);
+		summary.durationP95 = percentile(durations, 0.95);
+		summary.durationMax = durations.back();
+		summary.totalQueries /= summary.runs;
+		summary.freeQueries /= summary.runs;
+		summary.vertices /= summary.runs;
+		summary.edges /= summary.runs;
+		summary.explorationDurationMean /= summary.runs;
+		summary.spheres /= summary.runs;
+		summary.lengthMedian = percentile(lengths, 0.5);
+		summary.verticesSolvedMedian = percentile(vertices, 0.5);
+		
+		for (std::size_t k = 0; k < summary.calls.size(); ++k)
+		{
+			summary.calls[k] /= summary.runs;
+			summary.durations[k] /= summary.runs;
+		}
+		
+		summaries[i->first] = summary;
+	}
+	
+	return summaries;
+}
+
+void
+writeSummaries(std::ostream& stream, const std::map<Key, Summary>& summaries)
+{
+	stream << "File,Engine,Planner,Nearest Neighbors,Sampler,Runs,Solved,Success Rate,Mean Duration (s),Min Duration (s),Median Duration (s),P90 Duration (s),P95 Duration (s),Max Duration (s),Mean Total CD,Mean Free CD,Mean Vertices,Mean Edges,Median Path Length,Median Solved Vertices,Mean Spheres,Mean Exploration Duration (s)";
+	
+	for (std::size_t i = 0; i < rl::plan::Profiler::COUNTERS; ++i)
+	{
+		std::string name = rl::plan::Profiler::getName(static_cast<rl::plan::Profiler::Counter>(i));
+		stream << ",Mean " << name << " Calls,Mean " << name << " (s)";
+	}
+	
+	stream << std::endl;
+	
+	for (std::map<Key, Summary>::const_iterator i = summaries.begin(); i != summaries.end(); ++i)
+	{
+		stream << quote(std::get<0>(i->first));
+		stream << "," << std::get<1>(i->first);
+		stream << "," << quote(std::get<2>(i->first));
+		stream << "," << std::get<3>(i->first);
+		stream << "," << std::get<4>(i->first);
+		stream << "," << i->second.runs;
+		stream << "," << i->second.solved;
+		stream << "," << i->second.successRate;
+		stream << "," << i->second.durationMean;
+		stream << "," << i->second.durationMin;
+		stream << "," << i->second.durationMedian;
+		stream << "," << i->second.durationP90;
+		stream << "," << i->second.durationP95;
+		stream << "," << i->second.durationMax;
+		stream << "," << i->second.totalQueries;
+		stream << "," << i->second.freeQueries;
+		stream << "," << i->second.vertices;
+		stream << "," << i->second.edges;
+		stream << "," << i->second.lengthMedian;
+		stream << "," << i->second.verticesSolvedMedian;
+		stream << "," << i->second.spheres;
+		stream << "," << i->second.explorationDurationMean;
+		
+		for (std::size_t j = 0; j < i->second.calls.size(); ++j)
+		{
+			stream << "," << i->second.calls[j] << "," << i->second.durations[j];
+		}
+		
+		stream << std::endl;
+	}
+}
+
+std::string
+escape(const std::string& value)
+{
+	std::string escaped = "\"";
+	
+	for (std::size_t i = 0; i < value.size(); ++i)
+	{
+		if ('"' == value[i] || '\\' == value[i])
+		{
+			escaped += '\\';
+		}
+		
+		escaped += value[i];
+	}
+	
+	return escaped + "\"";
+}
+
+template<typename T>
+void
+writeProfile(std::ostream& stream, const std::vector<T>& calls, const std::vector<double>& durations)
+{
+	stream << ", \"profile\": {";
+	
+	for (std::size_t i = 0; i < calls.size(); ++i)
+	{
+		stream << (i > 0 ? ", " : "") << escape(rl::plan::Profiler::getName(static_cast<rl::plan::Profiler::Counter>(i)));
+		stream << ": {\"calls\": " << calls[i] << ", \"duration\": " << durations[i] << "}";
+	}
+	
+	stream << "}";
+}
+
+void
+writeJson(std::ostream& stream, const std::vector<Result>& results, const std::map<Key, Summary>& summaries)
+{
+	stream << "{" << std::endl;
+	stream << "\t\"runs\": [" << std::endl;
+	
+	for (std::size_t i = 0; i < results.size(); ++i)
+	{
+		stream << "\t\t{";
+		stream << "\"file\": " << escape(results[i].filename);
+		stream << ", \"engine\": " << escape(results[i].engine);
+		stream << ", \"planner\": " << escape(results[i].planner);
+		stream << ", \"nearestNeighbors\": " << escape(results[i].nearestNeighbors);
+		stream << ", \"sampler\": " << escape(results[i].sampler);
+		stream << ", \"seed\": " << results[i].seed;
+		stream << ", \"solved\": " << (results[i].solved ? "true" : "false");
+		stream << ", \"duration\": " << results[i].duration;
+		stream << ", \"totalQueries\": " << results[i].totalQueries;
+		stream << ", \"freeQueries\": " << results[i].freeQueries;
+		stream << ", \"vertices\": " << results[i].vertices;
+		stream << ", \"edges\": " << results[i].edges;
+		stream << ", \"length\": " << results[i].length;
+		stream << ", \"spheres\": " << results[i].spheres;
+		stream << ", \"explorationDuration\": " << results[i].explorationDuration;
+		writeProfile(stream, results[i].calls, results[i].durations);
+		stream << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+	}
+	
+	stream << "\t]," << std::endl;
+	stream << "\t\"summary\": [" << std::endl;
+	
+	for (std::map<Key, Summary>::const_iterator i = summaries.begin(); i != summaries.end(); ++i)
+	{
+		stream << "\t\t{";
+		stream << "\"file\": " << escape(std::get<0>(i->first));
+		stream << ", \"engine\": " << escape(std::get<1>(i->first));
+		stream << ", \"planner\": " << escape(std::get<2>(i->first));
+		stream << ", \"nearestNeighbors\": " << escape(std::get<3>(i->first));
+		stream << ", \"sampler\": " << escape(std::get<4>(i->first));
+		stream << ", \"runs\": " << i->second.runs;
+		stream << ", \"solved\": " << i->second.solved;
+		stream << ", \"successRate\": " << i->second.successRate;
+		stream << ", \"duration\": {";
+		stream << "\"mean\": " << i->second.durationMean;
+		stream << ", \"min\": " << i->second.durationMin;
+		stream << ", \"median\": " << i->second.durationMedian;
+		stream << ", \"p90\": " << i->second.durationP90;
+		stream << ", \"p95\": " << i->second.durationP95;
+		stream << ", \"max\": " << i->second.durationMax;
+		stream << "}";
+		stream << ", \"totalQueries\": " << i->second.totalQueries;
+		stream << ", \"freeQueries\": " << i->second.freeQueries;
+		stream << ", \"vertices\": " << i->second.vertices;
+		stream << ", \"edges\": " << i->second.edges;
+		stream << ", \"lengthMedian\": " << i->second.lengthMedian;
+		stream << ", \"verticesSolvedMedian\": " << i->second.verticesSolvedMedian;
+		stream << ", \"spheres\": " << i->second.spheres;
+		stream << ", \"explorationDuration\": " << i->second.explorationDurationMean;
+		writeProfile(stream, i->second.calls, i->second.durations);
+		stream << "}" << (std::next(i) != summaries.end() ? "," : "") << std::endl;
+	}
+	
+	stream << "\t]" << std::endl;
+	stream << "}" << std::endl;
+}
+
+struct Task
+{
+	std::string engine;
+	
+	std::string filename;
+	
+	std::string nearestNeighbors;
+	
+	std::string sampler;
+	
+	std::mt19937::result_type seed;
+};
+
+std::string
+command(const std::string& executable, const Task& task, const Options& options, const std::string& filename)
+{
+	std::stringstream command;
+	command << "\"" << executable << "\"";
+	
+	if (nullptr != options.duration)
+	{
+		command << " --duration=" << *options.duration;
+	}
+	
+	command << " --engine=" << task.engine;
+	
+	if (!task.nearestNeighbors.empty())
+	{
+		command << " --nearest-neighbors=" << task.nearestNeighbors;
+	}
+	
+	if (!task.sampler.empty())
+	{
+		command << " --sampler=" << task.sampler;
+	}
+	
+	command << " --quiet --runs=1 --seed=" << task.seed;
+	command << " \"--csv=" << filename << "\"";
+	command << " \"" << task.filename << "\"";
+#ifdef _WIN32
+	return "\"" + command.str() + "\"";
+#else // _WIN32
+	return command.str();
+#endif // _WIN32
+}
+
+/**
+ * Runs remaining tasks in child processes, so that collision engines with
+ * global state do not share a process.
+ */
+void
+work(const std::string* executable, const std::vector<Task>* tasks, const Options* options, std::size_t* next, std::mutex* mutex, std::vector<std::string>* filenames)
+{
+	while (true)
+	{
+		std::size_t i;
+		
+		{
+			std::lock_guard<std::mutex> lock(*mutex);
+			
+			if (*next >= tasks->size())
+			{
+				return;
+			}
+			
+			i = (*next)++;
+		}
+		
+		std::string filename = (options->csv.empty() ? std::string("rlPlanBenchmark") : options->csv) + "." + boost::lexical_cast<std::string>(i) + ".tmp";
+		
+		if (0 == std::system(command(*executable, (*tasks)[i], *options, filename).c_str()))
+		{
+			(*filenames)[i] = filename;
+		}
+		else
+		{
+			std::remove(filename.c_str());
+		}
+	}
+}
+
+int
+main(int argc, char** argv)
+{
+	std::vector<std::string> engines = availableEngines();
+	
+	std::stringstream usage;
+	usage << "Usage: rlPlanBenchmark [--csv=<filename>] [--duration=<seconds>] [--engine=<";
+	
+	for (std::size_t i = 0; i < engines.size(); ++i)
+	{
+		usage << (i > 0 ? "|" : "") << engines[i];
+	}
+	
+	usage << ">]... [--jobs=<jobs>] [--json=<filename>] [--nearest-neighbors=<concurrent|gnat|kdtree|kdtreeBoundingBox|linear|linearBlock>]... [--quiet] [--runs=<runs>] [--sampler=<bridge|gaussian|halton|sobol|uniform>]... [--seed=<seed>] [--summary=<filename>] FILENAME...";
+	
+	if (engines.empty())
+	{
+		std::cerr << "No collision engine available." << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	Options options;
+	options.jobs = 1;
+	options.quiet = false;
+	options.runs = 10;
+	options.seed = std::random_device()();
+	
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string argument(argv[i]);
+			std::string value = argument.substr(argument.find('=') + 1);
+			
+			if (0 == argument.find("--csv="))
+			{
+				options.csv = value;
+			}
+			else if (0 == argument.find("--duration="))
+			{
+				options.duration = std::make_shared<rl::math::Real>(boost::lexical_cast<rl::math::Real>(value));
+			}
+			else if (0 == argument.find("--engine="))
+			{
+				if (engines.end() == std::find(engines.begin(), engines.end(), value))
+				{
+					throw std::runtime_error("unknown engine '" + value + "'");
+				}
+				
+				options.engines.push_back(value);
+			}
+			else if (0 == argument.find("--jobs="))
+			{
+				options.jobs = std::max<std::size_t>(1, boost::lexical_cast<std::size_t>(value));
+			}
+			else if (0 == argument.find("--json="))
+			{
+				options.json = value;
+			}
+			else if (0 == argument.find("--nearest-neighbors="))
+			{
+				options.nearestNeighbors.push_back(value);
+			}
+			else if ("--quiet" == argument)
+			{
+				options.quiet = true;
+			}
+			else if (0 == argument.find("--runs="))
+			{
+				options.runs = boost::lexical_cast<std::size_t>(value);
+			}
+			else if (0 == argument.find("--sampler="))
+			{
+				options.samplers.push_back(value);
+			}
+			else if (0 == argument.find("--seed="))
+			{
+				options.seed = boost::lexical_cast<std::mt19937::result_type>(value);
+			}
+			else if (0 == argument.find("--summary="))
+			{
+				options.summary = value;
+			}
+			else if (0 == argument.find("--"))
+			{
+				throw std::runtime_error("unknown option '" + argument + "'");
+			}
+			else
+			{
+				options.filenames.push_back(argument);
+			}
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << std::endl;
+		std::cerr << usage.str() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (options.filenames.empty())
+	{
+		std::cerr << usage.str() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (options.engines.empty())
+	{
+		options.engines.push_back(engines.back());
+	}
+	
+	if (options.nearestNeighbors.empty())
+	{
+		options.nearestNeighbors.push_back(std::string());
+	}
+	
+	if (options.samplers.empty())
+	{
+		options.samplers.push_back(std::string());
+	}
+	
+	std::vector<Task> tasks;
+	
+	for (std::size_t i = 0; i < options.filenames.size(); ++i)
+	{
+		for (std::size_t j = 0; j < options.engines.size(); ++j)
+		{
+			for (std::size_t k = 0; k < options.nearestNeighbors.size(); ++k)
+			{
+				for (std::size_t l = 0; l < options.samplers.size(); ++l)
+				{
+					for (std::size_t m = 0; m < options.runs; ++m)
+					{
+						Task task;
+						task.engine = options.engines[j];
+						task.filename = options.filenames[i];
+						task.nearestNeighbors = options.nearestNeighbors[k];
+						task.sampler = options.samplers[l];
+						task.seed = options.seed + static_cast<std::mt19937::result_type>(m);
+						tasks.push_back(task);
+					}
+				}
+			}
+		}
+	}
+	
+	std::vector<Result> results;
+	int status = EXIT_SUCCESS;
+	
+	if (options.jobs > 1)
+	{
+		std::string executable(argv[0]);
+		std::vector<std::string> filenames(tasks.size());
+		std::mutex mutex;
+		std::size_t next = 0;
+		std::vector<std::thread> threads;
+		
+		for (std::size_t i = 0; i < std::min(options.jobs, tasks.size()); ++i)
+		{
+			threads.push_back(std::thread(work, &executable, &tasks, &options, &next, &mutex, &filenames));
+		}
+		
+		for (std::size_t i = 0; i < threads.size(); ++i)
+		{
+			threads[i].join();
+		}
+		
+		for (std::size_t i = 0; i < tasks.size(); ++i)
+		{
+			std::ifstream file(filenames[i]);
+			std::string line;
+			
+			if (!filenames[i].empty() && std::getline(file, line) && std::getline(file, line))
+			{
+				results.push_back(readResult(line));
+			}
+			else
+			{
+				std::cerr << "Run of '" << tasks[i].filename << "' with seed " << tasks[i].seed << " failed." << std::endl;
+				status = EXIT_FAILURE;
+			}
+			
+			file.close();
+			
+			if (!filenames[i].empty())
+			{
+				std::remove(filenames[i].c_str());
+			}
+		}
+	}
+	else
+	{
+		for (std::size_t i = 0; i < tasks.size(); ++i)
+		{
+			try
+			{
+				results.push_back(run(tasks[i].filename, tasks[i].engine, tasks[i].nearestNeighbors, tasks[i].sampler, tasks[i].seed, options));
+				
+				if (!options.quiet)
+				{
+					std::cerr << results.back().planner << " " << (results.back().solved ? "solved" : "failed") << " '" << tasks[i].filename << "' with seed " << tasks[i].seed << " in " << results.back().duration << " s" << std::endl;
+				}
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "Run of '" << tasks[i].filename << "' with seed " << tasks[i].seed << " failed: " << e.what() << std::endl;
+				status = EXIT_FAILURE;
+			}
+		}
+	}
+	
+	std::map<Key, Summary> summaries = summarize(results);
+	
+	if (!options.csv.empty())
+	{
+		std::ofstream csv(options.csv);
+		writeHeader(csv);
+		
+		for (std::size_t i = 0; i < results.size(); ++i)
+		{
+			writeResult(csv, results[i]);
+		}
+	}
+	
+	if (!options.json.empty())
+	{
+		std::ofstream json(options.json);
+		writeJson(json, results, summaries);
+	}
+	
+	if (!options.summary.empty())
+	{
+		std::ofstream summary(options.summary);
+		writeSummaries(summary, summaries);
+	}
+	
+	if (!options.quiet)
+	{
+		writeSummaries(std::cout, summaries);
+	}
+	
+	return status;
+}
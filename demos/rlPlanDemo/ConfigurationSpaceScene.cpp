@@ -73,9 +73,9 @@ ConfigurationSpaceScene::ConfigurationSpaceScene(QObject* parent) :
 	
 	QObject::connect(
 		this->thread,
-		SIGNAL(addCollision(const int&, const int&, const unsigned char&)),
+		SIGNAL(addCollisions(const int&, const int&, const QByteArray&)),
 		this,
-		SLOT(addCollision(const int&, const int&, const unsigned char&))
+		SLOT(addCollisions(const int&, const int&, const QByteArray&))
 	);
 	
 	QObject::connect(this->thread, SIGNAL(finished()), this, SIGNAL(evalFinished()));
@@ -87,14 +87,19 @@ ConfigurationSpaceScene::~ConfigurationSpaceScene()
 }
 
 void
-ConfigurationSpaceScene::addCollision(const int& x, const int& y, const unsigned char& rgb)
+ConfigurationSpaceScene::addCollisions(const int& y, const int& height, const QByteArray& rgb)
 {
-	this->data[y * this->steps[0] + x] = rgb;
+	if (rgb.size() != height * this->steps[0] || static_cast<std::size_t>((y + height) * this->steps[0]) > this->data.size())
+	{
+		return;
+	}
+	
+	std::copy(rgb.begin(), rgb.end(), this->data.begin() + y * this->steps[0]);
 	this->invalidate(
-		this->minimum[0] + x * this->delta[0],
+		this->minimum[0],
 		this->minimum[1] + y * this->delta[1],
-		this->delta[0],
-		this->delta[1],
+		this->steps[0] * this->delta[0],
+		height * this->delta[1],
 		QGraphicsScene::BackgroundLayer
 	);
 }
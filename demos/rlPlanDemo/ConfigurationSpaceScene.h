@@ -27,6 +27,7 @@
 #ifndef CONFIGURATIONSPACESCENE_H
 #define CONFIGURATIONSPACESCENE_H
 
+#include <QByteArray>
 #include <QGraphicsEllipseItem>
 #include <QGraphicsItemGroup>
 #include <QGraphicsPathItem>
@@ -60,7 +61,7 @@ public:
 	std::array<int, 2> steps;
 	
 public slots:
-	void addCollision(const int& x, const int& y, const unsigned char& rgb);
+	void addCollisions(const int& y, const int& height, const QByteArray& rgb);
 	
 	void clear();
 	
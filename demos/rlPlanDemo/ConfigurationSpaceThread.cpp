@@ -24,8 +24,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <thread>
 #include <QMutexLocker>
-#include <rl/plan/SimpleModel.h>
 
 #include "ConfigurationSpaceScene.h"
 #include "ConfigurationSpaceThread.h"
@@ -33,8 +34,14 @@
 
 ConfigurationSpaceThread::ConfigurationSpaceThread(QObject* parent) :
 	QThread(parent),
+	coarse(32),
 	scene(nullptr),
-	running(false)
+	data(),
+	previous(0),
+	q(),
+	row(0),
+	running(false),
+	stride(1)
 {
 }
 
@@ -56,17 +63,53 @@ ConfigurationSpaceThread::run()
 	
 	if (rl::plan::SimpleModel* model = dynamic_cast<rl::plan::SimpleModel*>(this->scene->model))
 	{
-		rl::math::Vector q(*MainWindow::instance()->q);
+		std::size_t threads = std::max(1, QThread::idealThreadCount());
 		
-		for (int i = 0; i < this->scene->steps[0] && this->running; ++i)
+		// ODE is initialized without support for collision queries in multiple threads
+		if ("ode" == MainWindow::instance()->engine)
 		{
-			q(this->scene->axis[0]) = this->scene->minimum[0] + i * this->scene->delta[0];
+			threads = 1;
+		}
+		
+		std::vector<rl::plan::SimpleModel*> models(1, model);
+		
+		if (model == MainWindow::instance()->model.get())
+		{
+			MainWindow::instance()->createModels(threads - 1);
+			
+			for (std::size_t i = 0; i < threads - 1; ++i)
+			{
+				models.push_back(MainWindow::instance()->models[i].get());
+			}
+		}
+		
+		this->data.assign(this->scene->steps[0] * this->scene->steps[1], 128);
+		this->q = *MainWindow::instance()->q;
+		
+		this->previous = 0;
+		this->stride = 1;
+		
+		while (this->stride * this->coarse < std::max(this->scene->steps[0], this->scene->steps[1]))
+		{
+			this->stride *= 2;
+		}
+		
+		for (; this->stride > 0 && this->running; this->previous = this->stride, this->stride /= 2)
+		{
+			this->row = 0;
+			
+			std::vector<std::thread> workers;
 			
-			for (int j = 0; j < this->scene->steps[1] && this->running; ++j)
+			for (std::size_t i = 1; i < models.size(); ++i)
 			{
-				q(this->scene->axis[1]) = this->scene->minimum[1] + j * this->scene->delta[1];
-				unsigned char rgb = model->isColliding(q) ? 0 : 255;
-				emit addCollision(i, j, rgb);
+				workers.push_back(std::thread(&ConfigurationSpaceThread::work, this, models[i]));
+			}
+			
+			this->work(models[0]);
+			
+			for (std::size_t i = 0; i < workers.size(); ++i)
+			{
+				workers[i].join();
 			}
 		}
 	}
@@ -87,3 +130,44 @@ ConfigurationSpaceThread::stop()
 		}
 	}
 }
+
+void
+ConfigurationSpaceThread::work(rl::plan::SimpleModel* model)
+{
+	rl::math::Vector q(this->q);
+	
+	for (int j = this->row.fetch_add(this->stride); j < this->scene->steps[1] && this->running; j = this->row.fetch_add(this->stride))
+	{
+		q(this->scene->axis[1]) = this->scene->minimum[1] + j * this->scene->delta[1];
+		
+		int height = std::min(this->stride, this->scene->steps[1] - j);
+		
+		for (int i = 0; i < this->scene->steps[0] && this->running; i += this->stride)
+		{
+			// cell has already been computed in the previous pass
+			if (this->previous > 0 && 0 == i % this->previous && 0 == j % this->previous)
+			{
+				continue;
+			}
+			
+			q(this->scene->axis[0]) = this->scene->minimum[0] + i * this->scene->delta[0];
+			unsigned char rgb = model->isColliding(q) ? 0 : 255;
+			
+			int width = std::min(this->stride, this->scene->steps[0] - i);
+			
+			for (int y = j; y < j + height; ++y)
+			{
+				std::fill_n(this->data.begin() + y * this->scene->steps[0] + i, width, rgb);
+			}
+		}
+		
+		if (this->running)
+		{
+			emit addCollisions(
+				j,
+				height,
+				QByteArray(reinterpret_cast<const char*>(this->data.data() + j * this->scene->steps[0]), height * this->scene->steps[0])
+			);
+		}
+	}
+}
@@ -27,10 +27,21 @@
 #ifndef CONFIGURATIONSPACETHREAD_H
 #define CONFIGURATIONSPACETHREAD_H
 
+#include <atomic>
+#include <vector>
+#include <QByteArray>
 #include <QThread>
+#include <rl/plan/SimpleModel.h>
 
 class ConfigurationSpaceScene;
 
+/**
+ * Computes the collision slice of the configuration space.
+ *
+ * Rows are distributed over several threads with separate collision models
+ * and reported in batches. The slice is refined progressively, starting with
+ * a coarse grid and halving the stride in each pass.
+ */
 class ConfigurationSpaceThread : public QThread
 {
 	Q_OBJECT
@@ -44,15 +55,30 @@ public:
 	
 	void stop();
 	
+	/** Number of cells along the longer axis in the first pass. */
+	int coarse;
+	
 	ConfigurationSpaceScene* scene;
 	
 protected:
 	
 private:
-	bool running;
+	void work(rl::plan::SimpleModel* model);
+	
+	std::vector<unsigned char> data;
+	
+	int previous;
+	
+	rl::math::Vector q;
+	
+	std::atomic<int> row;
+	
+	std::atomic<bool> running;
+	
+	int stride;
 	
 signals:
-	void addCollision(const int& x, const int& y, const unsigned char& rgb);
+	void addCollisions(const int& y, const int& height, const QByteArray& rgb);
 };
 
 #endif // CONFIGURATIONSPACETHREAD_H
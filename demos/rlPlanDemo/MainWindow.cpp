@@ -38,6 +38,7 @@
 #include <QPainter>
 #include <QPrinter>
 #include <QStatusBar>
+#include <QThread>
 #include <Inventor/nodes/SoCamera.h>
 #include <Inventor/nodes/SoOrthographicCamera.h>
 #include <Inventor/nodes/SoPerspectiveCamera.h>
@@ -49,12 +50,16 @@
 #include <rl/plan/AddRrtConCon.h>
 #include <rl/plan/AdvancedOptimizer.h>
 #include <rl/plan/BridgeSampler.h>
+#include <rl/plan/ChompOptimizer.h>
+#include <rl/plan/ConcurrentNearestNeighbors.h>
 #include <rl/plan/DistanceModel.h>
 #include <rl/plan/Eet.h>
 #include <rl/plan/GaussianSampler.h>
+#include <rl/plan/HaltonSampler.h>
 #include <rl/plan/GnatNearestNeighbors.h>
 #include <rl/plan/KdtreeBoundingBoxNearestNeighbors.h>
 #include <rl/plan/KdtreeNearestNeighbors.h>
+#include <rl/plan/LinearBlockNearestNeighbors.h>
 #include <rl/plan/LinearNearestNeighbors.h>
 #include <rl/plan/Prm.h>
 #include <rl/plan/PrmUtilityGuided.h>
@@ -68,7 +73,9 @@
 #include <rl/plan/RrtGoalBias.h>
 #include <rl/plan/SequentialVerifier.h>
 #include <rl/plan/SimpleModel.h>
+#include <rl/plan/ShortcutOptimizer.h>
 #include <rl/plan/SimpleOptimizer.h>
+#include <rl/plan/SobolSampler.h>
 #include <rl/plan/UniformSampler.h>
 #include <rl/plan/WorkspaceSphereExplorer.h>
 #include <rl/sg/Body.h>
@@ -121,8 +128,10 @@
 
 MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags f) :
 	QMainWindow(parent, f),
+	asyncViewer(),
 	configurationModel(new ConfigurationModel(this)),
 	configurationSpaceModel(new ConfigurationSpaceModel(this)),
+	distanceField(),
 	engine(),
 	explorerGoals(),
 	explorers(),
@@ -130,10 +139,13 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags f) :
 	goal(),
 	kin(),
 	kin2(),
+	kins(),
 	mdl(),
 	mdl2(),
+	mdls(),
 	model(),
 	model2(),
+	models(),
 	mutex(),
 	nearestNeighbors(),
 	planner(),
@@ -144,6 +156,7 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags f) :
 	sigma(),
 	scene(),
 	scene2(),
+	scenes(),
 	sceneModel(nullptr),
 	sceneModel2(nullptr),
 	start(),
@@ -166,6 +179,8 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags f) :
 	getRandomConfigurationAction(new QAction(this)),
 	getRandomFreeConfigurationAction(new QAction(this)),
 	getStartConfigurationAction(new QAction(this)),
+	modelKinematicsFilename(),
+	modelSceneFilename(),
 	openAction(new QAction(this)),
 	plannerDockWidget(new QDockWidget(this)),
 	plannerView(new QTableView(this)),
@@ -198,6 +213,9 @@ MainWindow::MainWindow(QWidget* parent, Qt::WindowFlags f) :
 {
 	MainWindow::singleton = this;
 	
+	this->asyncViewer = std::make_shared<rl::plan::AsyncViewer>(this->thread);
+	this->asyncViewer->start();
+	
 	SoQt::init(this);
 	SoDB::init();
 	SoGradientBackground::initClass();
@@ -306,16 +324,20 @@ void
 MainWindow::clear()
 {
 	this->configurationSpaceScene->clear();
+	this->distanceField.reset();
 	this->explorerGoals.clear();
 	this->explorers.clear();
 	this->explorerStarts.clear();
 	this->goal.reset();
 	this->kin.reset();
 	this->kin2.reset();
+	this->kins.clear();
 	this->mdl.reset();
 	this->mdl2.reset();
+	this->mdls.clear();
 	this->model.reset();
 	this->model2.reset();
+	this->models.clear();
 	this->nearestNeighbors.clear();
 	this->optimizer.reset();
 	this->planner.reset();
@@ -325,6 +347,7 @@ MainWindow::clear()
 	this->sigma.reset();
 	this->scene.reset();
 	this->scene2.reset();
+	this->scenes.clear();
 	this->sceneModel = nullptr;
 	this->sceneModel2 = nullptr;
 	this->start.reset();
@@ -462,6 +485,148 @@ MainWindow::connect(const QObject* sender, const QObject* receiver)
 	);
 }
 
+void
+MainWindow::createModels(const std::size_t& n)
+{
+	std::size_t index = 0;
+	
+	while (this->scene->getModel(index) != this->sceneModel)
+	{
+		++index;
+	}
+	
+	while (this->models.size() < n)
+	{
+		std::shared_ptr<rl::sg::Scene> scene = this->createScene();
+		
+		if ("urdf" == this->modelSceneFilename.substr(this->modelSceneFilename.length() - 4, 4))
+		{
+			rl::sg::UrdfFactory sceneFactory;
+			sceneFactory.load(this->modelSceneFilename, scene.get());
+		}
+		else
+		{
+			rl::sg::XmlFactory sceneFactory;
+			sceneFactory.load(this->modelSceneFilename, scene.get());
+		}
+		
+		std::shared_ptr<rl::plan::SimpleModel> model;
+		
+		if (nullptr != dynamic_cast<rl::plan::DistanceModel*>(this->model.get()))
+		{
+			model = std::make_shared<rl::plan::DistanceModel>();
+		}
+		else
+		{
+			model = std::make_shared<rl::plan::SimpleModel>();
+		}
+		
+		if (nullptr != this->kin)
+		{
+			std::shared_ptr<rl::kin::Kinematics> kin = rl::kin::Kinematics::create(this->modelKinematicsFilename);
+			
+			rl::math::Vector maximum(this->kin->getDof());
+			this->kin->getMaximum(maximum);
+			kin->setMaximum(maximum);
+			
+			rl::math::Vector minimum(this->kin->getDof());
+			this->kin->getMinimum(minimum);
+			kin->setMinimum(minimum);
+			
+			kin->world() = this->kin->world();
+			
+			model->kin = kin.get();
+			this->kins.push_back(kin);
+		}
+		else if (nullptr != this->mdl)
+		{
+			std::shared_ptr<rl::mdl::Kinematic> mdl;
+			
+			if ("urdf" == this->modelKinematicsFilename.substr(this->modelKinematicsFilename.length() - 4, 4))
+			{
+				rl::mdl::UrdfFactory modelFactory;
+				mdl = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(this->modelKinematicsFilename));
+			}
+			else
+			{
+				rl::mdl::XmlFactory modelFactory;
+				mdl = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(this->modelKinematicsFilename));
+			}
+			
+			mdl->setMaximum(this->mdl->getMaximum());
+			mdl->setMinimum(this->mdl->getMinimum());
+			mdl->world() = this->mdl->world();
+			
+			model->mdl = mdl.get();
+			this->mdls.push_back(mdl);
+		}
+		
+		model->model = scene->getModel(index);
+		model->scene = scene.get();
+		
+		this->models.push_back(model);
+		this->scenes.push_back(scene);
+	}
+}
+
+std::shared_ptr<rl::sg::Scene>
+MainWindow::createScene()
+{
+	std::shared_ptr<rl::sg::Scene> scene;
+	
+#ifdef RL_SG_BULLET
+	if ("bullet" == this->engine)
+	{
+		scene = std::make_shared<rl::sg::bullet::Scene>();
+	}
+#endif // RL_SG_BULLET
+#ifdef RL_SG_FCL
+	if ("fcl" == this->engine)
+	{
+		scene = std::make_shared<rl::sg::fcl::Scene>();
+	}
+#endif // RL_SG_FCL
+#ifdef RL_SG_ODE
+	if ("ode" == this->engine)
+	{
+		scene = std::make_shared<rl::sg::ode::Scene>();
+	}
+#endif // RL_SG_ODE
+#ifdef RL_SG_PQP
+	if ("pqp" == this->engine)
+	{
+		scene = std::make_shared<rl::sg::pqp::Scene>();
+	}
+#endif // RL_SG_PQP
+#ifdef RL_SG_SOLID
+	if ("solid" == this->engine)
+	{
+		scene = std::make_shared<rl::sg::solid::Scene>();
+	}
+#endif // RL_SG_SOLID
+	
+	return scene;
+}
+
+std::vector<rl::plan::SimpleModel*>
+MainWindow::createWorkerModels()
+{
+	std::vector<rl::plan::SimpleModel*> models;
+	
+	// ODE is initialized without support for collision queries in multiple threads
+	if ("ode" != this->engine)
+	{
+		this->createModels(std::max(1, QThread::idealThreadCount()));
+		
+		for (std::size_t i = 0; i < this->models.size(); ++i)
+		{
+			models.push_back(this->models[i].get());
+		}
+	}
+	
+	return models;
+}
+
 void
 MainWindow::disconnect(const QObject* sender, const QObject* receiver)
 {
@@ -826,44 +991,15 @@ MainWindow::load(const QString& filename)
 	
 	rl::xml::Path path(document);
 	
-#ifdef RL_SG_BULLET
-	if ("bullet" == this->engine)
-	{
-		this->scene = std::make_shared<rl::sg::bullet::Scene>();
-	}
-#endif // RL_SG_BULLET
-#ifdef RL_SG_FCL
-	if ("fcl" == this->engine)
-	{
-		this->scene = std::make_shared<rl::sg::fcl::Scene>();
-	}
-#endif // RL_SG_FCL
-#ifdef RL_SG_ODE
-	if ("ode" == this->engine)
-	{
-		this->scene = std::make_shared<rl::sg::ode::Scene>();
-	}
-#endif // RL_SG_ODE
-#ifdef RL_SG_PQP
-	if ("pqp" == this->engine)
-	{
-		this->scene = std::make_shared<rl::sg::pqp::Scene>();
-	}
-#endif // RL_SG_PQP
-#ifdef RL_SG_SOLID
-	if ("solid" == this->engine)
-	{
-		this->scene = std::make_shared<rl::sg::solid::Scene>();
-	}
-#endif // RL_SG_SOLID
+	this->scene = this->createScene();
 	
 	rl::xml::NodeSet modelScene = path.eval("(/rl/plan|/rlplan)//model/scene").getValue<rl::xml::NodeSet>();
-	std::string modelSceneFilename = modelScene[0].getLocalPath(modelScene[0].getProperty("href"));
+	this->modelSceneFilename = modelScene[0].getLocalPath(modelScene[0].getProperty("href"));
 	
-	if ("urdf" == modelSceneFilename.substr(modelSceneFilename.length() - 4, 4))
+	if ("urdf" == this->modelSceneFilename.substr(this->modelSceneFilename.length() - 4, 4))
 	{
 		rl::sg::UrdfFactory sceneFactory;
-		sceneFactory.load(modelSceneFilename, this->scene.get());
+		sceneFactory.load(this->modelSceneFilename, this->scene.get());
 		this->sceneModel = this->scene->getModel(
 			path.eval("number((/rl/plan|/rlplan)//model/model)").getValue<std::size_t>()
 		);
@@ -871,28 +1007,28 @@ MainWindow::load(const QString& filename)
 	else
 	{
 		rl::sg::XmlFactory sceneFactory;
-		sceneFactory.load(modelSceneFilename, this->scene.get());
+		sceneFactory.load(this->modelSceneFilename, this->scene.get());
 		this->sceneModel = this->scene->getModel(
 			path.eval("number((/rl/plan|/rlplan)//model/model)").getValue<std::size_t>()
 		);
 	}
 	
 	rl::xml::NodeSet modelKinematics = path.eval("(/rl/plan|/rlplan)//model/kinematics").getValue<rl::xml::NodeSet>();
-	std::string modelKinematicsFilename = modelKinematics[0].getLocalPath(modelKinematics[0].getProperty("href"));
+	this->modelKinematicsFilename = modelKinematics[0].getLocalPath(modelKinematics[0].getProperty("href"));
 	
-	if ("urdf" == modelKinematicsFilename.substr(modelKinematicsFilename.length() - 4, 4))
+	if ("urdf" == this->modelKinematicsFilename.substr(this->modelKinematicsFilename.length() - 4, 4))
 	{
 		rl::mdl::UrdfFactory modelFactory;
-		this->mdl = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(modelKinematicsFilename));
+		this->mdl = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(this->modelKinematicsFilename));
 	}
 	else if ("mdl" == modelKinematics[0].getProperty("type"))
 	{
 		rl::mdl::XmlFactory modelFactory;
-		this->mdl = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(modelKinematicsFilename));
+		this->mdl = std::dynamic_pointer_cast<rl::mdl::Kinematic>(modelFactory.create(this->modelKinematicsFilename));
 	}
 	else
 	{
-		this->kin = rl::kin::Kinematics::create(modelKinematicsFilename);
+		this->kin = rl::kin::Kinematics::create(this->modelKinematicsFilename);
 	}
 	
 	if (path.eval("count((/rl/plan|/rlplan)//model/kinematics/world) > 0").getValue<bool>())
@@ -1297,10 +1433,53 @@ MainWindow::load(const QString& filename)
 		
 		bridgeSampler->setSigma(this->sigma.get());
 	}
+	else if (path.eval("count((/rl/plan|/rlplan)//haltonSampler) > 0").getValue<bool>())
+	{
+		this->sampler = std::make_shared<rl::plan::HaltonSampler>();
+		rl::plan::HaltonSampler* haltonSampler = static_cast<rl::plan::HaltonSampler*>(this->sampler.get());
+		
+		if (path.eval("translate(string((/rl/plan|/rlplan)//haltonSampler/scrambled), 'FALSE', 'false') = 'false' or string((/rl/plan|/rlplan)//haltonSampler/scrambled) = '0'").getValue<bool>())
+		{
+			haltonSampler->setScrambled(false);
+		}
+		
+		if (path.eval("count((/rl/plan|/rlplan)//haltonSampler/seed) > 0").getValue<bool>())
+		{
+			haltonSampler->seed(
+				path.eval("number((/rl/plan|/rlplan)//haltonSampler/seed)").getValue<std::mt19937::result_type>(std::random_device()())
+			);
+		}
+		else if (this->seed)
+		{
+			haltonSampler->seed(*this->seed);
+		}
+	}
+	else if (path.eval("count((/rl/plan|/rlplan)//sobolSampler) > 0").getValue<bool>())
+	{
+		this->sampler = std::make_shared<rl::plan::SobolSampler>();
+		rl::plan::SobolSampler* sobolSampler = static_cast<rl::plan::SobolSampler*>(this->sampler.get());
+		
+		if (path.eval("translate(string((/rl/plan|/rlplan)//sobolSampler/scrambled), 'FALSE', 'false') = 'false' or string((/rl/plan|/rlplan)//sobolSampler/scrambled) = '0'").getValue<bool>())
+		{
+			sobolSampler->setScrambled(false);
+		}
+		
+		if (path.eval("count((/rl/plan|/rlplan)//sobolSampler/seed) > 0").getValue<bool>())
+		{
+			sobolSampler->seed(
+				path.eval("number((/rl/plan|/rlplan)//sobolSampler/seed)").getValue<std::mt19937::result_type>(std::random_device()())
+			);
+		}
+		else if (this->seed)
+		{
+			sobolSampler->seed(*this->seed);
+		}
+	}
 	
 	if (nullptr != this->sampler)
 	{
 		this->sampler->setModel(this->model.get());
+		this->sampler->setModels(this->createWorkerModels());
 	}
 	
 	this->sampler2 = std::make_shared<rl::plan::UniformSampler>();
@@ -1334,6 +1513,7 @@ MainWindow::load(const QString& filename)
 	if (nullptr != this->verifier)
 	{
 		this->verifier->setModel(this->model.get());
+		this->verifier->setModels(this->createWorkerModels());
 	}
 	
 	if (path.eval("count((/rl/plan|/rlplan)//simpleOptimizer/recursiveVerifier) > 0").getValue<bool>())
@@ -1360,10 +1540,35 @@ MainWindow::load(const QString& filename)
 		
 		this->verifier2->setDelta(delta);
 	}
+	else if (path.eval("count((/rl/plan|/rlplan)//chompOptimizer/recursiveVerifier) > 0").getValue<bool>())
+	{
+		this->verifier2 = std::make_shared<rl::plan::RecursiveVerifier>();
+		rl::math::Real delta = path.eval("number((/rl/plan|/rlplan)//chompOptimizer/recursiveVerifier/delta)").getValue<rl::math::Real>(1);
+		
+		if ("deg" == path.eval("string((/rl/plan|/rlplan)//chompOptimizer/recursiveVerifier/delta/@unit)").getValue<std::string>())
+		{
+			delta *= rl::math::constants::deg2rad;
+		}
+		
+		this->verifier2->setDelta(delta);
+	}
+	else if (path.eval("count((/rl/plan|/rlplan)//shortcutOptimizer/recursiveVerifier) > 0").getValue<bool>())
+	{
+		this->verifier2 = std::make_shared<rl::plan::RecursiveVerifier>();
+		rl::math::Real delta = path.eval("number((/rl/plan|/rlplan)//shortcutOptimizer/recursiveVerifier/delta)").getValue<rl::math::Real>(1);
+		
+		if ("deg" == path.eval("string((/rl/plan|/rlplan)//shortcutOptimizer/recursiveVerifier/delta/@unit)").getValue<std::string>())
+		{
+			delta *= rl::math::constants::deg2rad;
+		}
+		
+		this->verifier2->setDelta(delta);
+	}
 	
 	if (nullptr != this->verifier2)
 	{
 		this->verifier2->setModel(this->model.get());
+		this->verifier2->setModels(this->createWorkerModels());
 	}
 	
 	this->optimizer.reset();
@@ -1386,6 +1591,43 @@ MainWindow::load(const QString& filename)
 		advancedOptimizer->setLength(length);
 		advancedOptimizer->setRatio(path.eval("number((/rl/plan|/rlplan)//advancedOptimizer/ratio)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.1)));
 	}
+	else if (path.eval("count((/rl/plan|/rlplan)//chompOptimizer) > 0").getValue<bool>())
+	{
+		this->optimizer = std::make_shared<rl::plan::ChompOptimizer>();
+		rl::plan::ChompOptimizer* chompOptimizer = static_cast<rl::plan::ChompOptimizer*>(this->optimizer.get());
+		chompOptimizer->setClearance(path.eval("number((/rl/plan|/rlplan)//chompOptimizer/clearance)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.1)));
+		chompOptimizer->setIterations(path.eval("number((/rl/plan|/rlplan)//chompOptimizer/iterations)").getValue<std::size_t>(100));
+		rl::math::Real length = path.eval("number((/rl/plan|/rlplan)//chompOptimizer/length)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.1));
+		
+		if ("deg" == path.eval("string((/rl/plan|/rlplan)//chompOptimizer/length/@unit)").getValue<std::string>())
+		{
+			length *= rl::math::constants::deg2rad;
+		}
+		
+		chompOptimizer->setLength(length);
+		chompOptimizer->setStepSize(path.eval("number((/rl/plan|/rlplan)//chompOptimizer/stepSize)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.1)));
+		chompOptimizer->setWeight(path.eval("number((/rl/plan|/rlplan)//chompOptimizer/weight)").getValue<rl::math::Real>(10));
+		chompOptimizer->setModels(this->createWorkerModels());
+	}
+	else if (path.eval("count((/rl/plan|/rlplan)//shortcutOptimizer) > 0").getValue<bool>())
+	{
+		this->optimizer = std::make_shared<rl::plan::ShortcutOptimizer>();
+		rl::plan::ShortcutOptimizer* shortcutOptimizer = static_cast<rl::plan::ShortcutOptimizer*>(this->optimizer.get());
+		shortcutOptimizer->setBatchSize(path.eval("number((/rl/plan|/rlplan)//shortcutOptimizer/batchSize)").getValue<std::size_t>(32));
+		shortcutOptimizer->setPartialRatio(path.eval("number((/rl/plan|/rlplan)//shortcutOptimizer/partialRatio)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.5)));
+		shortcutOptimizer->setRounds(path.eval("number((/rl/plan|/rlplan)//shortcutOptimizer/rounds)").getValue<std::size_t>(10));
+		
+		if (path.eval("count((/rl/plan|/rlplan)//shortcutOptimizer/seed) > 0").getValue<bool>())
+		{
+			shortcutOptimizer->seed(
+				path.eval("number((/rl/plan|/rlplan)//shortcutOptimizer/seed)").getValue<std::mt19937::result_type>(std::random_device()())
+			);
+		}
+		else if (this->seed)
+		{
+			shortcutOptimizer->seed(*this->seed);
+		}
+	}
 	
 	if (nullptr != this->optimizer)
 	{
@@ -1627,11 +1869,62 @@ MainWindow::load(const QString& filename)
 				
 				eet->addExplorerSetup(explorerSetup);
 			}
+			
+			if (path.eval("count(distanceField) > 0").getValue<bool>())
+			{
+				rl::plan::DistanceModel* model = dynamic_cast<rl::plan::DistanceModel*>(this->model.get());
+				
+				if (nullptr == model)
+				{
+					throw std::runtime_error("selected engine does not support distance queries");
+				}
+				
+				this->distanceField = std::make_shared<rl::plan::DistanceField>();
+				this->distanceField->setBoundingBox(rl::math::AlignedBox3(eet->getMin(), eet->getMax()));
+				this->distanceField->setResolution(path.eval("number(distanceField/resolution)").getValue<rl::math::Real>(static_cast<rl::math::Real>(0.05)));
+				
+				std::string distanceFieldFilename;
+				
+				if (path.eval("count(distanceField/@href) > 0").getValue<bool>())
+				{
+					rl::xml::NodeSet distanceField = path.eval("distanceField").getValue<rl::xml::NodeSet>();
+					distanceFieldFilename = distanceField[0].getLocalPath(distanceField[0].getProperty("href"));
+					
+					try
+					{
+						this->distanceField->load(distanceFieldFilename, model);
+					}
+					catch (const std::exception&)
+					{
+						// missing or outdated file is rebuilt
+					}
+				}
+				
+				if (this->distanceField->empty())
+				{
+					std::vector<rl::plan::SimpleModel*> models = this->createWorkerModels();
+					
+					if (models.empty())
+					{
+						models.push_back(model);
+					}
+					
+					this->distanceField->build(models);
+					
+					if (!distanceFieldFilename.empty())
+					{
+						this->distanceField->save(distanceFieldFilename);
+					}
+				}
+				
+				model->field = this->distanceField.get();
+			}
 		}
 		else if ("prm" == planners[i].getName())
 		{
 			this->planner = std::make_shared<rl::plan::Prm>();
 			rl::plan::Prm* prm = static_cast<rl::plan::Prm*>(this->planner.get());
+			prm->setBatchSize(path.eval("number(batchSize)").getValue<std::size_t>(1));
 			prm->setMaxDegree(path.eval("number(degree)").getValue<std::size_t>(std::numeric_limits<std::size_t>::max()));
 			
 			if (path.eval("count(dijkstra) > 0").getValue<bool>())
@@ -1655,6 +1948,7 @@ MainWindow::load(const QString& filename)
 		{
 			this->planner = std::make_shared<rl::plan::PrmUtilityGuided>();
 			rl::plan::PrmUtilityGuided* prmUtilityGuided = static_cast<rl::plan::PrmUtilityGuided*>(this->planner.get());
+			prmUtilityGuided->setBatchSize(path.eval("number(batchSize)").getValue<std::size_t>(1));
 			prmUtilityGuided->setMaxDegree(path.eval("number(degree)").getValue<std::size_t>(std::numeric_limits<std::size_t>::max()));
 			
 			if (path.eval("count(dijkstra) > 0").getValue<bool>())
@@ -1877,7 +2171,15 @@ MainWindow::load(const QString& filename)
 	{
 		std::shared_ptr<rl::plan::NearestNeighbors> nearestNeighbors;
 		
-		if (path.eval("count((/rl/plan|/rlplan)//gnatNearestNeighbors) > 0").getValue<bool>())
+		if (path.eval("count((/rl/plan|/rlplan)//concurrentNearestNeighbors) > 0").getValue<bool>())
+		{
+			std::shared_ptr<rl::plan::ConcurrentNearestNeighbors> concurrentNearestNeighbors = std::make_shared<rl::plan::ConcurrentNearestNeighbors>(
+				this->model.get(),
+				path.eval("number((/rl/plan|/rlplan)//concurrentNearestNeighbors/buffer/@size)").getValue<std::size_t>(64)
+			);
+			nearestNeighbors = concurrentNearestNeighbors;
+		}
+		else if (path.eval("count((/rl/plan|/rlplan)//gnatNearestNeighbors) > 0").getValue<bool>())
 		{
 			std::shared_ptr<rl::plan::GnatNearestNeighbors> gnatNearestNeighbors = std::make_shared<rl::plan::GnatNearestNeighbors>(this->model.get());
 			
@@ -1969,6 +2271,11 @@ MainWindow::load(const QString& filename)
 			
 			nearestNeighbors = kdtreeNearestNeighbors;
 		}
+		else if (path.eval("count((/rl/plan|/rlplan)//linearBlockNearestNeighbors) > 0").getValue<bool>())
+		{
+			std::shared_ptr<rl::plan::LinearBlockNearestNeighbors> linearBlockNearestNeighbors = std::make_shared<rl::plan::LinearBlockNearestNeighbors>(this->model.get());
+			nearestNeighbors = linearBlockNearestNeighbors;
+		}
 		else
 		{
 			std::shared_ptr<rl::plan::LinearNearestNeighbors> linearNearestNeighbors = std::make_shared<rl::plan::LinearNearestNeighbors>(this->model.get());
@@ -2342,6 +2649,7 @@ MainWindow::reset()
 	QCoreApplication::processEvents();
 	this->planner->setDuration(std::chrono::steady_clock::duration::zero());
 	this->thread->stop();
+	this->asyncViewer->reset();
 	this->planner->setDuration(duration);
 	this->thread->blockSignals(false);
 	
@@ -2569,16 +2877,16 @@ MainWindow::toggleViewActive(const bool& doOn)
 {
 	if (doOn)
 	{
-		this->planner->setViewer(this->thread);
+		this->planner->setViewer(this->asyncViewer.get());
 		
 		if (nullptr != this->optimizer)
 		{
-			this->optimizer->setViewer(this->thread);
+			this->optimizer->setViewer(this->asyncViewer.get());
 		}
 		
 		for (std::vector<std::shared_ptr<rl::plan::WorkspaceSphereExplorer>>::iterator i = this->explorers.begin(); i != this->explorers.end(); ++i)
 		{
-			(*i)->setViewer(this->thread);
+			(*i)->setViewer(this->asyncViewer.get());
 		}
 		
 		this->connect(this->thread, this->viewer);
@@ -36,6 +36,8 @@
 #include <boost/optional.hpp>
 #include <rl/kin/Kinematics.h>
 #include <rl/mdl/Kinematic.h>
+#include <rl/plan/AsyncViewer.h>
+#include <rl/plan/DistanceField.h>
 #include <rl/plan/NearestNeighbors.h>
 #include <rl/plan/Optimizer.h>
 #include <rl/plan/Planner.h>
@@ -64,12 +66,35 @@ class MainWindow : public QMainWindow
 public:
 	virtual ~MainWindow();
 	
+	/**
+	 * Create additional collision models for use in worker threads.
+	 *
+	 * Loads independent copies of scene and kinematics, as collision
+	 * queries modify their state. Copies support distance queries if the
+	 * scene does. Existing copies are reused.
+	 */
+	void createModels(const std::size_t& n);
+	
+	/**
+	 * Create one collision model per ideal thread count for batch queries.
+	 *
+	 * Returns an empty list for engines without support for collision
+	 * queries in multiple threads.
+	 */
+	std::vector<rl::plan::SimpleModel*> createWorkerModels();
+	
 	static MainWindow* instance();
 	
+	/** Forwards draw calls of planners to thread without blocking planning. */
+	std::shared_ptr<rl::plan::AsyncViewer> asyncViewer;
+	
 	ConfigurationModel* configurationModel;
 	
 	ConfigurationSpaceModel* configurationSpaceModel;
 	
+	/** Distance field of static obstacles used by workspace explorers. */
+	std::shared_ptr<rl::plan::DistanceField> distanceField;
+	
 	QString engine;
 	
 	std::vector<std::shared_ptr<rl::math::Vector3>> explorerGoals;
@@ -84,14 +109,20 @@ public:
 	
 	std::shared_ptr<rl::kin::Kinematics> kin2;
 	
+	std::vector<std::shared_ptr<rl::kin::Kinematics>> kins;
+	
 	std::shared_ptr<rl::mdl::Kinematic> mdl;
 	
 	std::shared_ptr<rl::mdl::Kinematic> mdl2;
 	
+	std::vector<std::shared_ptr<rl::mdl::Kinematic>> mdls;
+	
 	std::shared_ptr<rl::plan::SimpleModel> model;
 	
 	std::shared_ptr<rl::plan::Model> model2;
 	
+	std::vector<std::shared_ptr<rl::plan::SimpleModel>> models;
+	
 	QMutex mutex;
 	
 	std::vector<std::shared_ptr<rl::plan::NearestNeighbors>> nearestNeighbors;
@@ -114,6 +145,8 @@ public:
 	
 	std::shared_ptr<rl::sg::so::Scene> scene2;
 	
+	std::vector<std::shared_ptr<rl::sg::Scene>> scenes;
+	
 	rl::sg::Model* sceneModel;
 	
 	rl::sg::so::Model* sceneModel2;
@@ -185,6 +218,8 @@ private:
 	
 	void connect(const QObject* sender, const QObject* receiver);
 	
+	std::shared_ptr<rl::sg::Scene> createScene();
+	
 	void disconnect(const QObject* sender, const QObject* receiver);
 	
 	void init();
@@ -223,6 +258,10 @@ private:
 	
 	QAction* getStartConfigurationAction;
 	
+	std::string modelKinematicsFilename;
+	
+	std::string modelSceneFilename;
+	
 	QAction* openAction;
 	
 	QDockWidget* plannerDockWidget;
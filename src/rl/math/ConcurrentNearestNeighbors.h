@@ -0,0 +1,283 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef RL_MATH_CONCURRENTNEARESTNEIGHBORS_H
+#define RL_MATH_CONCURRENTNEARESTNEIGHBORS_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace rl
+{
+	namespace math
+	{
+		/**
+		 * Nearest neighbor search with concurrent queries and insertions.
+		 *
+		 * Values are collected in a fixed-size buffer. Once the buffer is
+		 * full, it is merged with static nearest neighbor structures of
+		 * doubling size, which are rebuilt in bulk (logarithmic method). Each
+		 * query works on an immutable snapshot and does not block, insertions
+		 * are serialized.
+		 *
+		 * Jon Louis Bentley and James B. Saxe. Decomposable searching problems
+		 * I: Static-to-dynamic transformation. Journal of Algorithms,
+		 * 1(4):301-358, December 1980.
+		 *
+		 * http://dx.doi.org/10.1016/0196-6774(80)90015-2
+		 */
+		template<typename NearestNeighborsT>
+		class ConcurrentNearestNeighbors
+		{
+		public:
+			typedef typename NearestNeighborsT::Distance Distance;
+			
+			typedef typename NearestNeighborsT::Metric Metric;
+			
+			typedef NearestNeighborsT NearestNeighbors;
+			
+			typedef typename NearestNeighborsT::Neighbor Neighbor;
+			
+			typedef typename NearestNeighborsT::Value Value;
+			
+			explicit ConcurrentNearestNeighbors(const Metric& metric, const ::std::size_t& bufferSize = 64) :
+				bufferSize(bufferSize),
+				metric(metric),
+				mutex(),
+				state(::std::make_shared<State>(bufferSize))
+			{
+			}
+			
+			explicit ConcurrentNearestNeighbors(Metric&& metric = Metric(), const ::std::size_t& bufferSize = 64) :
+				bufferSize(bufferSize),
+				metric(::std::move(metric)),
+				mutex(),
+				state(::std::make_shared<State>(bufferSize))
+			{
+			}
+			
+			~ConcurrentNearestNeighbors()
+			{
+			}
+			
+			void clear()
+			{
+				::std::lock_guard<::std::mutex> lock(this->mutex);
+				::std::atomic_store(&this->state, ::std::make_shared<State>(this->bufferSize));
+			}
+			
+			bool empty() const
+			{
+				return 0 == this->size();
+			}
+			
+			::std::size_t getBufferSize() const
+			{
+				return this->bufferSize;
+			}
+			
+			::std::vector<Neighbor> nearest(const Value& query, const ::std::size_t& k, const bool& sorted = true) const
+			{
+				return this->search(query, &k, nullptr, sorted);
+			}
+			
+			/**
+			 * Insert value, may be called concurrently to queries.
+			 *
+			 * A full buffer is merged in the calling thread, concurrent queries
+			 * continue on the previous snapshot meanwhile.
+			 */
+			void push(const Value& value)
+			{
+				::std::lock_guard<::std::mutex> lock(this->mutex);
+				
+				::std::shared_ptr<State> state = ::std::atomic_load(&this->state);
+				::std::size_t size = state->buffer->size.load(::std::memory_order_relaxed);
+				
+				if (size < this->bufferSize)
+				{
+					state->buffer->values[size] = value;
+					state->buffer->size.store(size + 1, ::std::memory_order_release);
+					return;
+				}
+				
+				::std::shared_ptr<State> next = ::std::make_shared<State>(this->bufferSize);
+				next->levels = state->levels;
+				next->size = state->size + size;
+				
+				::std::vector<Value> values(state->buffer->values);
+				
+				for (::std::size_t i = 0; i <= next->levels.size(); ++i)
+				{
+					if (next->levels.size() == i)
+					{
+						next->levels.emplace_back();
+					}
+					
+					if (nullptr == next->levels[i].nearestNeighbors)
+					{
+						next->levels[i].values = ::std::make_shared<::std::vector<Value>>(::std::move(values));
+						next->levels[i].nearestNeighbors = ::std::make_shared<const NearestNeighbors>(next->levels[i].values->begin(), next->levels[i].values->end(), this->metric);
+						break;
+					}
+					
+					values.insert(values.end(), next->levels[i].values->begin(), next->levels[i].values->end());
+					next->levels[i].nearestNeighbors.reset();
+					next->levels[i].values.reset();
+				}
+				
+				next->buffer->values[0] = value;
+				next->buffer->size.store(1, ::std::memory_order_relaxed);
+				
+				::std::atomic_store(&this->state, next);
+			}
+			
+			::std::vector<Neighbor> radius(const Value& query, const Distance& radius, const bool& sorted = true) const
+			{
+				return this->search(query, nullptr, &radius, sorted);
+			}
+			
+			::std::size_t size() const
+			{
+				::std::shared_ptr<State> state = ::std::atomic_load(&this->state);
+				return state->size + state->buffer->size.load(::std::memory_order_acquire);
+			}
+			
+		protected:
+			
+		private:
+			struct Buffer
+			{
+				Buffer(const ::std::size_t& capacity) :
+					size(0),
+					values(capacity)
+				{
+				}
+				
+				::std::atomic<::std::size_t> size;
+				
+				::std::vector<Value> values;
+			};
+			
+			struct Level
+			{
+				::std::shared_ptr<const NearestNeighbors> nearestNeighbors;
+				
+				::std::shared_ptr<::std::vector<Value>> values;
+			};
+			
+			struct NeighborCompare
+			{
+				bool operator()(const Neighbor& lhs, const Neighbor& rhs) const
+				{
+					return lhs.first < rhs.first;
+				}
+			};
+			
+			struct State
+			{
+				State(const ::std::size_t& bufferSize) :
+					buffer(::std::make_shared<Buffer>(bufferSize)),
+					levels(),
+					size(0)
+				{
+				}
+				
+				::std::shared_ptr<Buffer> buffer;
+				
+				::std::vector<Level> levels;
+				
+				::std::size_t size;
+			};
+			
+			void insert(const Neighbor& neighbor, const ::std::size_t* k, ::std::vector<Neighbor>& neighbors) const
+			{
+				if (nullptr == k || neighbors.size() < *k || neighbor.first < neighbors.front().first)
+				{
+					if (nullptr != k && *k == neighbors.size())
+					{
+						::std::pop_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+						neighbors.pop_back();
+					}
+					
+					neighbors.push_back(neighbor);
+					::std::push_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+				}
+			}
+			
+			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+			{
+				::std::shared_ptr<State> state = ::std::atomic_load(&this->state);
+				::std::size_t size = state->buffer->size.load(::std::memory_order_acquire);
+				
+				::std::vector<Neighbor> neighbors;
+				
+				for (::std::size_t i = 0; i < state->levels.size(); ++i)
+				{
+					if (nullptr != state->levels[i].nearestNeighbors)
+					{
+						::std::vector<Neighbor> found = nullptr != k ? state->levels[i].nearestNeighbors->nearest(query, *k, false) : state->levels[i].nearestNeighbors->radius(query, *radius, false);
+						
+						for (::std::size_t j = 0; j < found.size(); ++j)
+						{
+							this->insert(found[j], k, neighbors);
+						}
+					}
+				}
+				
+				for (::std::size_t i = 0; i < size; ++i)
+				{
+					Distance distance = this->metric(query, state->buffer->values[i]);
+					
+					if (nullptr == radius || distance < *radius)
+					{
+						this->insert(Neighbor(distance, state->buffer->values[i]), k, neighbors);
+					}
+				}
+				
+				if (sorted)
+				{
+					::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+				}
+				
+				return neighbors;
+			}
+			
+			::std::size_t bufferSize;
+			
+			Metric metric;
+			
+			::std::mutex mutex;
+			
+			::std::shared_ptr<State> state;
+		};
+	}
+}
+
+#endif // RL_MATH_CONCURRENTNEARESTNEIGHBORS_H
@@ -82,6 +82,8 @@ namespace rl
 				nodeDegree(8),
 				nodeDegreeMax(12),
 				nodeDegreeMin(4),
+				rebuild(false),
+				rebuildSize(0),
 				root(0, 0, nodeDegree, nodeDataMax, true),
 				values(0)
 			{
@@ -95,6 +97,8 @@ namespace rl
 				nodeDegree(8),
 				nodeDegreeMax(12),
 				nodeDegreeMin(4),
+				rebuild(false),
+				rebuildSize(0),
 				root(0, 0, nodeDegree, nodeDataMax, true),
 				values(0)
 			{
@@ -109,6 +113,8 @@ namespace rl
 				nodeDegree(8),
 				nodeDegreeMax(12),
 				nodeDegreeMin(4),
+				rebuild(false),
+				rebuildSize(2 * ::std::distance(first, last)),
 				root(first, last, 0, 0, nodeDegree, nodeDataMax, true),
 				values(::std::distance(first, last))
 			{
@@ -127,7 +133,9 @@ namespace rl
 				nodeDegree(8),
 				nodeDegreeMax(12),
 				nodeDegreeMin(4),
-				root(first, last, nullptr, 0, 0, nodeDegree, nodeDataMax, true),
+				rebuild(false),
+				rebuildSize(2 * ::std::distance(first, last)),
+				root(first, last, 0, 0, nodeDegree, nodeDataMax, true),
 				values(::std::distance(first, last))
 			{
 				if (this->root.data.size() > this->nodeDataMax && this->root.data.size() > this->root.degree)
@@ -146,6 +154,7 @@ namespace rl
 				this->root.children.reserve(this->nodeDegree);
 				this->root.data.clear();
 				this->root.data.reserve(this->nodeDataMax + 1);
+				this->rebuildSize = 0;
 				this->values = 0;
 			}
 			
@@ -187,6 +196,11 @@ namespace rl
 				return this->nodeDegreeMin;
 			}
 			
+			bool getRebuild() const
+			{
+				return this->rebuild;
+			}
+			
 			template<typename InputIterator>
 			void insert(InputIterator first, InputIterator last)
 			{
@@ -200,6 +214,7 @@ namespace rl
 					}
 					
 					this->values += ::std::distance(first, last);
+					this->rebuildSize = 2 * this->values;
 				}
 				else
 				{
@@ -219,6 +234,11 @@ namespace rl
 			{
 				this->push(this->root, value);
 				++this->values;
+				
+				if (this->rebuild && this->values >= this->rebuildSize)
+				{
+					this->build();
+				}
 			}
 			
 			::std::vector<Neighbor> radius(const Value& query, const Distance& radius, const bool& sorted = true) const
@@ -256,6 +276,17 @@ namespace rl
 				this->nodeDegreeMin = nodeDegreeMin;
 			}
 			
+			/**
+			 * Rebuild tree with bulk insertion each time its size doubles.
+			 *
+			 * Pivots of nodes split during push() are chosen from few values,
+			 * a rebuild selects them from all values below each node.
+			 */
+			void setRebuild(const bool& rebuild)
+			{
+				this->rebuild = rebuild;
+			}
+			
 			::std::size_t size() const
 			{
 				return this->values;
@@ -264,12 +295,15 @@ namespace rl
 			void swap(GnatNearestNeighbors& other)
 			{
 				using ::std::swap;
+				swap(this->checks, other.checks);
 				swap(this->generator, other.generator);
 				swap(this->metric, other.metric);
 				swap(this->nodeDegree, other.nodeDegree);
 				swap(this->nodeDegreeMax, other.nodeDegreeMax);
 				swap(this->nodeDegreeMin, other.nodeDegreeMin);
 				swap(this->nodeDataMax, other.nodeDataMax);
+				swap(this->rebuild, other.rebuild);
+				swap(this->rebuildSize, other.rebuildSize);
 				swap(this->root, other.root);
 				swap(this->values, other.values);
 			}
@@ -370,12 +404,23 @@ namespace rl
 				bool removed;
 			};
 			
+			void build()
+			{
+				::std::vector<Value> data = this->data();
+				this->clear();
+				this->insert(data.begin(), data.end());
+			}
+			
 			void choose(const Node& node, ::std::vector<::std::size_t>& centers, ::std::vector<::std::vector<Distance>>& distances)
 			{
 				::std::size_t k = node.degree;
 				::std::vector<Distance> min(node.data.size(), ::std::numeric_limits<Distance>::infinity());
 				
 				::std::uniform_int_distribution<::std::size_t> distribution(0, node.data.size() - 1);
+				
+#ifdef _OPENMP
+#pragma omp critical (RL_MATH_GNATNEARESTNEIGHBORS_GENERATOR)
+#endif
 				centers[0] = distribution(this->generator);
 				
 				for (::std::size_t i = 0; i < k - 1; ++i)
@@ -690,6 +735,10 @@ namespace rl
 			
 			::std::size_t nodeDegreeMin;
 			
+			bool rebuild;
+			
+			::std::size_t rebuildSize;
+			
 			Node root;
 			
 			::std::size_t values;
@@ -41,6 +41,8 @@
 #include <rl/std/iterator.h>
 #include <rl/std/memory.h>
 
+#include "KdtreeScratch.h"
+
 namespace rl
 {
 	namespace math
@@ -86,6 +88,8 @@ namespace rl
 				checks(),
 				metric(metric),
 				nodeDataMax(10),
+				rebuild(false),
+				rebuildSize(0),
 				root(),
 				values(0)
 			{
@@ -96,6 +100,8 @@ namespace rl
 				checks(),
 				metric(::std::move(metric)),
 				nodeDataMax(10),
+				rebuild(false),
+				rebuildSize(0),
 				root(),
 				values(0)
 			{
@@ -107,6 +113,8 @@ namespace rl
 				checks(),
 				metric(metric),
 				nodeDataMax(10),
+				rebuild(false),
+				rebuildSize(0),
 				root(),
 				values(0)
 			{
@@ -119,6 +127,8 @@ namespace rl
 				checks(),
 				metric(::std::move(metric)),
 				nodeDataMax(10),
+				rebuild(false),
+				rebuildSize(0),
 				root(),
 				values(0)
 			{
@@ -135,6 +145,7 @@ namespace rl
 				this->root.children[0].reset(nullptr);
 				this->root.children[1].reset(nullptr);
 				this->root.data.clear();
+				this->rebuildSize = 0;
 				this->values = 0;
 			}
 			
@@ -161,6 +172,11 @@ namespace rl
 				return this->nodeDataMax;
 			}
 			
+			bool getRebuild() const
+			{
+				return this->rebuild;
+			}
+			
 			template<typename InputIterator>
 			void insert(InputIterator first, InputIterator last)
 			{
@@ -174,6 +190,10 @@ namespace rl
 					{
 						this->boundingBox.resize(size(*first));
 						this->computeBoundingBox(first, last, this->boundingBox);
+#ifdef _OPENMP
+#pragma omp parallel if (distance > 1000)
+#pragma omp single
+#endif
 						this->divide(this->root, this->boundingBox, first, last);
 					}
 					else
@@ -182,6 +202,7 @@ namespace rl
 					}
 					
 					this->values += distance;
+					this->rebuildSize = 2 * this->values;
 				}
 				else
 				{
@@ -197,6 +218,16 @@ namespace rl
 				return this->search(query, &k, nullptr, sorted);
 			}
 			
+			/**
+			 * Search k nearest neighbors without allocating memory.
+			 *
+			 * Reuses the capacity of neighbors and a per-thread search buffer.
+			 */
+			void nearest(const Value& query, const ::std::size_t& k, ::std::vector<Neighbor>& neighbors, const bool& sorted = true) const
+			{
+				this->search(query, &k, nullptr, neighbors, sorted);
+			}
+			
 			void push(const Value& value)
 			{
 				using ::std::begin;
@@ -226,6 +257,11 @@ namespace rl
 				this->push(this->root, value);
 				
 				++this->values;
+				
+				if (this->rebuild && this->values >= this->rebuildSize)
+				{
+					this->build();
+				}
 			}
 			
 			::std::vector<Neighbor> radius(const Value& query, const Distance& radius, const bool& sorted = true) const
@@ -233,6 +269,16 @@ namespace rl
 				return this->search(query, nullptr, &radius, sorted);
 			}
 			
+			/**
+			 * Search neighbors within radius without allocating memory.
+			 *
+			 * Reuses the capacity of neighbors and a per-thread search buffer.
+			 */
+			void radius(const Value& query, const Distance& radius, ::std::vector<Neighbor>& neighbors, const bool& sorted = true) const
+			{
+				this->search(query, nullptr, &radius, neighbors, sorted);
+			}
+			
 			void setChecks(const ::boost::optional<::std::size_t>& checks)
 			{
 				this->checks = checks;
@@ -243,6 +289,17 @@ namespace rl
 				this->nodeDataMax = nodeDataMax;
 			}
 			
+			/**
+			 * Rebuild tree with bulk insertion each time its size doubles.
+			 *
+			 * Keeps trees grown by push() balanced, as cuts are otherwise
+			 * chosen from the first values only.
+			 */
+			void setRebuild(const bool& rebuild)
+			{
+				this->rebuild = rebuild;
+			}
+			
 			::std::size_t size() const
 			{
 				return this->values;
@@ -251,12 +308,14 @@ namespace rl
 			void swap(KdtreeBoundingBoxNearestNeighbors& other)
 			{
 				using ::std::swap;
-				swap(this->mean, other.mean);
+				swap(this->boundingBox, other.boundingBox);
+				swap(this->checks, other.checks);
 				swap(this->metric, other.metric);
-				swap(this->samples, other.samples);
+				swap(this->nodeDataMax, other.nodeDataMax);
+				swap(this->rebuild, other.rebuild);
+				swap(this->rebuildSize, other.rebuildSize);
 				swap(this->root, other.root);
 				swap(this->values, other.values);
-				swap(this->var, other.var);
 			}
 			
 			friend void swap(KdtreeBoundingBoxNearestNeighbors& lhs, KdtreeBoundingBoxNearestNeighbors& rhs)
@@ -273,25 +332,18 @@ namespace rl
 			
 			struct Branch
 			{
-				Branch(Distance& dist, ::std::vector<Distance>& sidedist, const Node* node) :
+				Branch(const Distance& dist, const Node* node, const ::std::size_t& sidedist) :
 					dist(dist),
 					node(node),
 					sidedist(sidedist)
 				{
 				}
 				
-				Branch(Distance& dist, ::std::vector<Distance>&& sidedist, const Node* node) :
-					dist(dist),
-					node(node),
-					sidedist(::std::move(sidedist))
-				{
-				}
-				
 				Distance dist;
 				
 				const Node* node;
 				
-				::std::vector<Distance> sidedist;
+				::std::size_t sidedist;
 			};
 			
 			struct BranchCompare
@@ -383,8 +435,17 @@ namespace rl
 				Interval interval;
 			};
 			
+			typedef KdtreeScratch<Branch, Distance> Scratch;
+			
+			void build()
+			{
+				::std::vector<Value> data = this->data();
+				this->clear();
+				this->insert(data.begin(), data.end());
+			}
+			
 			template<typename InputIterator>
-			void computeBoundingBox(InputIterator first, InputIterator last, BoundingBox& boundingBox)
+			void computeBoundingBox(InputIterator first, InputIterator last, BoundingBox& boundingBox) const
 			{
 				using ::std::begin;
 				
@@ -414,7 +475,10 @@ namespace rl
 				
 				for (::std::size_t i = 0; i < node.children.size(); ++i)
 				{
-					this->data(*node.children[i], data);
+					if (nullptr != node.children[i])
+					{
+						this->data(*node.children[i], data);
+					}
 				}
 			}
 			
@@ -446,17 +510,27 @@ namespace rl
 					
 					node.children[i] = ::rl::std14::make_unique<Node>();
 					
+					Node* child = node.children[i].get();
+					BoundingBox* box = &boundingBoxes[i];
+					
 					if (::std::distance(begin, end) > this->nodeDataMax)
 					{
-						this->divide(*node.children[i], boundingBoxes[i], begin, end);
+#ifdef _OPENMP
+#pragma omp task if (::std::distance(begin, end) > 1000)
+#endif
+						this->divide(*child, *box, begin, end);
 					}
 					else
 					{
-						node.children[i]->data.insert(node.children[i]->data.end(), begin, end);
-						this->computeBoundingBox(begin, end, boundingBoxes[i]);
+						child->data.insert(child->data.end(), begin, end);
+						this->computeBoundingBox(begin, end, *box);
 					}
 				}
 				
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+				
 				node.interval.low = boundingBoxes[0][cut.index].high;
 				node.interval.high = boundingBoxes[1][cut.index].low;
 				
@@ -506,15 +580,24 @@ namespace rl
 			}
 			
 			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+			{
+				::std::vector<Neighbor> neighbors;
+				this->search(query, k, radius, neighbors, sorted);
+				return neighbors;
+			}
+			
+			void search(const Value& query, const ::std::size_t* k, const Distance* radius, ::std::vector<Neighbor>& neighbors, const bool& sorted) const
 			{
 				using ::std::begin;
 				using ::rl::std17::size;
 				
-				::std::vector<Neighbor> neighbors;
+				static thread_local Scratch scratch;
+				
+				neighbors.clear();
 				
 				if (this->empty())
 				{
-					return neighbors;
+					return;
 				}
 				
 				if (nullptr != k)
@@ -525,46 +608,43 @@ namespace rl
 				::std::size_t checks = 0;
 				
 				Distance mindist = Distance();
-				::std::vector<Distance> sidedist(size(query), Distance());
+				scratch.reset(size(query));
 				
-				for (::std::size_t i = 0; i < sidedist.size(); ++i)
+				for (::std::size_t i = 0; i < scratch.sidedist.size(); ++i)
 				{
 					Distance value = *(begin(query) + i);
 					
 					if (value < this->boundingBox[i].low)
 					{
-						sidedist[i] = this->metric(value, this->boundingBox[i].low, i);
-						mindist += sidedist[i];
+						scratch.sidedist[i] = this->metric(value, this->boundingBox[i].low, i);
+						mindist += scratch.sidedist[i];
 					}
 					
 					if (value > this->boundingBox[i].high)
 					{
-						sidedist[i] = this->metric(value, this->boundingBox[i].high, i);
-						mindist += sidedist[i];
+						scratch.sidedist[i] = this->metric(value, this->boundingBox[i].high, i);
+						mindist += scratch.sidedist[i];
 					}
 				}
 				
-				::std::vector<Branch> branches;
+				this->search(this->root, query, k, radius, scratch, neighbors, checks, mindist);
 				
-				this->search(this->root, query, k, radius, branches, neighbors, checks, mindist, sidedist);
-				
-				while (!branches.empty() && (!this->checks || checks < this->checks))
+				while (!scratch.branches.empty() && (!this->checks || checks < this->checks))
 				{
-					Branch branch = ::std::move(branches.front());
-					::std::pop_heap(branches.begin(), branches.end(), BranchCompare());
-					branches.pop_back();
-					this->search(*branch.node, query, k, radius, branches, neighbors, checks, branch.dist, branch.sidedist);
+					Branch branch = scratch.branches.front();
+					::std::pop_heap(scratch.branches.begin(), scratch.branches.end(), BranchCompare());
+					scratch.branches.pop_back();
+					scratch.load(branch.sidedist);
+					this->search(*branch.node, query, k, radius, scratch, neighbors, checks, branch.dist);
 				}
 				
 				if (sorted)
 				{
 					::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
 				}
-				
-				return neighbors;
 			}
 			
-			void search(const Node& node, const Value& query, const ::std::size_t* k, const Distance* radius, ::std::vector<Branch>& branches, ::std::vector<Neighbor>& neighbors, ::std::size_t& checks, const Distance& mindist, ::std::vector<Distance>& sidedist) const
+			void search(const Node& node, const Value& query, const ::std::size_t* k, const Distance* radius, Scratch& scratch, ::std::vector<Neighbor>& neighbors, ::std::size_t& checks, const Distance& mindist) const
 			{
 				using ::std::begin;
 				
@@ -605,26 +685,27 @@ namespace rl
 					::std::size_t best = diff < 0 ? 0 : 1;
 					::std::size_t worst = diff < 0 ? 1 : 0;
 					
-					this->search(*node.children[best], query, k, radius, branches, neighbors, checks, mindist, sidedist);
+					this->search(*node.children[best], query, k, radius, scratch, neighbors, checks, mindist);
 					
 					Distance cutdist = this->metric(value, diff < 0 ? node.interval.high : node.interval.low, node.index);
-					Distance newdist = mindist - sidedist[node.index] + cutdist;
+					Distance newdist = mindist - scratch.sidedist[node.index] + cutdist;
 					
 					if (nullptr == k || neighbors.size() < *k || newdist <= neighbors.front().first)
 					{
 						if (!this->checks)
 						{
-							Distance dist = sidedist[node.index];
-							sidedist[node.index] = cutdist;
-							this->search(*node.children[worst], query, k, radius, branches, neighbors, checks, newdist, sidedist);
-							sidedist[node.index] = dist;
+							Distance dist = scratch.sidedist[node.index];
+							scratch.sidedist[node.index] = cutdist;
+							this->search(*node.children[worst], query, k, radius, scratch, neighbors, checks, newdist);
+							scratch.sidedist[node.index] = dist;
 						}
 						else
 						{
-							::std::vector<Distance> newsidedist(sidedist);
-							newsidedist[node.index] = cutdist;
-							branches.emplace_back(newdist, ::std::move(newsidedist), node.children[worst].get());
-							::std::push_heap(branches.begin(), branches.end(), BranchCompare());
+							Distance dist = scratch.sidedist[node.index];
+							scratch.sidedist[node.index] = cutdist;
+							scratch.branches.emplace_back(newdist, node.children[worst].get(), scratch.store());
+							scratch.sidedist[node.index] = dist;
+							::std::push_heap(scratch.branches.begin(), scratch.branches.end(), BranchCompare());
 						}
 					}
 				}
@@ -696,6 +777,10 @@ namespace rl
 			
 			::std::size_t nodeDataMax;
 			
+			bool rebuild;
+			
+			::std::size_t rebuildSize;
+			
 			Node root;
 			
 			::std::size_t values;
@@ -0,0 +1,697 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_MATH_KDTREEBUCKETNEARESTNEIGHBORS_H
+#define RL_MATH_KDTREEBUCKETNEARESTNEIGHBORS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/optional.hpp>
+#include <rl/std/iterator.h>
+
+#include "KdtreeScratch.h"
+
+namespace rl
+{
+	namespace math
+	{
+		/**
+		 * k-d tree with bucket leaves.
+		 *
+		 * Nodes are stored in a flat array and linked via indices. Each leaf
+		 * holds up to a fixed number of values, their coordinates are packed
+		 * contiguously for evaluating the distances of a leaf in one loop.
+		 * The distance is accumulated per coordinate, the metric therefore
+		 * needs to be a sum over coordinates, e.g., a squared Euclidean
+		 * metric.
+		 *
+		 * Jerome H. Friedman, Jon Louis Bentley, and Raphael Ari Finkel. An
+		 * algorithm for finding best matches in logarithmic expected time.
+		 * ACM Transactions on Mathematical Software, 3(3):209-226,
+		 * September 1977.
+		 *
+		 * http://dx.doi.org/10.1145/355744.355745
+		 */
+		template<typename MetricT>
+		class KdtreeBucketNearestNeighbors
+		{
+		private:
+			struct Node;
+			
+		public:
+			typedef const typename MetricT::Value& const_reference;
+			
+			typedef ::std::ptrdiff_t difference_type;
+			
+			typedef typename MetricT::Value& reference;
+			
+			typedef ::std::size_t size_type;
+			
+			typedef typename MetricT::Value value_type;
+			
+			typedef typename MetricT::Distance Distance;
+			
+			typedef MetricT Metric;
+			
+			typedef typename MetricT::Size Size;
+			
+			typedef typename MetricT::Value Value;
+			
+			typedef ::std::pair<Distance, Value> Neighbor;
+			
+			explicit KdtreeBucketNearestNeighbors(const Metric& metric) :
+				bucketSize(16),
+				buckets(),
+				checks(),
+				coordinates(),
+				dim(0),
+				mean(),
+				metric(metric),
+				nodes(),
+				samples(100),
+				scratch(),
+				values(0),
+				var()
+			{
+			}
+			
+			explicit KdtreeBucketNearestNeighbors(Metric&& metric = Metric()) :
+				bucketSize(16),
+				buckets(),
+				checks(),
+				coordinates(),
+				dim(0),
+				mean(),
+				metric(::std::move(metric)),
+				nodes(),
+				samples(100),
+				scratch(),
+				values(0),
+				var()
+			{
+			}
+			
+			template<typename InputIterator>
+			KdtreeBucketNearestNeighbors(InputIterator first, InputIterator last, const Metric& metric) :
+				bucketSize(16),
+				buckets(),
+				checks(),
+				coordinates(),
+				dim(0),
+				mean(),
+				metric(metric),
+				nodes(),
+				samples(100),
+				scratch(),
+				values(0),
+				var()
+			{
+				this->insert(first, last);
+			}
+			
+			template<typename InputIterator>
+			KdtreeBucketNearestNeighbors(InputIterator first, InputIterator last, Metric&& metric = Metric()) :
+				bucketSize(16),
+				buckets(),
+				checks(),
+				coordinates(),
+				dim(0),
+				mean(),
+				metric(::std::move(metric)),
+				nodes(),
+				samples(100),
+				scratch(),
+				values(0),
+				var()
+			{
+				this->insert(first, last);
+			}
+			
+			~KdtreeBucketNearestNeighbors()
+			{
+			}
+			
+			void clear()
+			{
+				this->buckets.clear();
+				this->coordinates.clear();
+				this->dim = 0;
+				this->nodes.clear();
+				this->values = 0;
+			}
+			
+			::std::vector<Value> data() const
+			{
+				::std::vector<Value> data;
+				data.reserve(this->values);
+				
+				for (::std::size_t i = 0; i < this->nodes.size(); ++i)
+				{
+					if (0 == this->nodes[i].children[0])
+					{
+						data.insert(data.end(), this->buckets.begin() + this->nodes[i].bucket * this->bucketSize, this->buckets.begin() + this->nodes[i].bucket * this->bucketSize + this->nodes[i].count);
+					}
+				}
+				
+				return data;
+			}
+			
+			bool empty() const
+			{
+				return 0 == this->values;
+			}
+			
+			::std::size_t getBucketSize() const
+			{
+				return this->bucketSize;
+			}
+			
+			::boost::optional<::std::size_t> getChecks() const
+			{
+				return this->checks;
+			}
+			
+			::std::size_t getSamples() const
+			{
+				return this->samples;
+			}
+			
+			template<typename InputIterator>
+			void insert(InputIterator first, InputIterator last)
+			{
+				using ::rl::std17::size;
+				
+				if (first == last)
+				{
+					return;
+				}
+				
+				if (this->empty())
+				{
+					this->clear();
+					this->dim = size(*first);
+					this->nodes.emplace_back();
+					this->divide(0, first, last);
+					this->values += ::std::distance(first, last);
+				}
+				else
+				{
+					for (InputIterator i = first; i != last; ++i)
+					{
+						this->push(*i);
+					}
+				}
+			}
+			
+			::std::vector<Neighbor> nearest(const Value& query, const ::std::size_t& k, const bool& sorted = true) const
+			{
+				return this->search(query, &k, nullptr, sorted);
+			}
+			
+			/**
+			 * Search k nearest neighbors without allocating memory.
+			 *
+			 * Reuses the capacity of neighbors and a per-thread search buffer.
+			 */
+			void nearest(const Value& query, const ::std::size_t& k, ::std::vector<Neighbor>& neighbors, const bool& sorted = true) const
+			{
+				this->search(query, &k, nullptr, neighbors, sorted);
+			}
+			
+			void push(const Value& value)
+			{
+				using ::std::begin;
+				using ::rl::std17::size;
+				
+				if (this->empty())
+				{
+					this->clear();
+					this->dim = size(value);
+					this->nodes.emplace_back();
+					this->nodes[0].bucket = this->allocate();
+				}
+				
+				::std::size_t node = 0;
+				
+				while (0 != this->nodes[node].children[0])
+				{
+					node = this->nodes[node].children[*(begin(value) + this->nodes[node].cut.index) < this->nodes[node].cut.value ? 0 : 1];
+				}
+				
+				if (this->nodes[node].count < this->bucketSize)
+				{
+					this->store(node, value);
+				}
+				else
+				{
+					this->scratch.assign(this->buckets.begin() + this->nodes[node].bucket * this->bucketSize, this->buckets.begin() + (this->nodes[node].bucket + 1) * this->bucketSize);
+					this->scratch.push_back(value);
+					this->split(node, this->scratch.begin(), this->scratch.end());
+				}
+				
+				++this->values;
+			}
+			
+			::std::vector<Neighbor> radius(const Value& query, const Distance& radius, const bool& sorted = true) const
+			{
+				return this->search(query, nullptr, &radius, sorted);
+			}
+			
+			/**
+			 * Search neighbors within radius without allocating memory.
+			 *
+			 * Reuses the capacity of neighbors and a per-thread search buffer.
+			 */
+			void radius(const Value& query, const Distance& radius, ::std::vector<Neighbor>& neighbors, const bool& sorted = true) const
+			{
+				this->search(query, nullptr, &radius, neighbors, sorted);
+			}
+			
+			/**
+			 * Set maximum number of values per leaf.
+			 *
+			 * Rebuilds the tree if it is not empty.
+			 */
+			void setBucketSize(const ::std::size_t& bucketSize)
+			{
+				assert(bucketSize > 0);
+				
+				::std::vector<Value> data = this->data();
+				this->clear();
+				this->bucketSize = bucketSize;
+				this->insert(data.begin(), data.end());
+			}
+			
+			void setChecks(const ::boost::optional<::std::size_t>& checks)
+			{
+				this->checks = checks;
+			}
+			
+			void setSamples(const ::std::size_t& samples)
+			{
+				this->samples = samples;
+			}
+			
+			::std::size_t size() const
+			{
+				return this->values;
+			}
+			
+			void swap(KdtreeBucketNearestNeighbors& other)
+			{
+				using ::std::swap;
+				swap(this->bucketSize, other.bucketSize);
+				swap(this->buckets, other.buckets);
+				swap(this->checks, other.checks);
+				swap(this->coordinates, other.coordinates);
+				swap(this->dim, other.dim);
+				swap(this->mean, other.mean);
+				swap(this->metric, other.metric);
+				swap(this->nodes, other.nodes);
+				swap(this->samples, other.samples);
+				swap(this->scratch, other.scratch);
+				swap(this->values, other.values);
+				swap(this->var, other.var);
+			}
+			
+			friend void swap(KdtreeBucketNearestNeighbors& lhs, KdtreeBucketNearestNeighbors& rhs)
+			{
+				lhs.swap(rhs);
+			}
+			
+		protected:
+			
+		private:
+			struct Branch
+			{
+				Branch(const Distance& dist, const ::std::size_t& node, const ::std::size_t& sidedist) :
+					dist(dist),
+					node(node),
+					sidedist(sidedist)
+				{
+				}
+				
+				Distance dist;
+				
+				::std::size_t node;
+				
+				::std::size_t sidedist;
+			};
+			
+			struct BranchCompare
+			{
+				bool operator()(const Branch& lhs, const Branch& rhs) const
+				{
+					return lhs.dist > rhs.dist;
+				}
+			};
+			
+			struct Cut
+			{
+				bool operator()(const Value& lhs, const Value& rhs) const
+				{
+					using ::std::begin;
+					return *(begin(lhs) + this->index) < *(begin(rhs) + this->index);
+				}
+				
+				Size index;
+				
+				Distance value;
+			};
+			
+			struct NeighborCompare
+			{
+				bool operator()(const Neighbor& lhs, const Neighbor& rhs) const
+				{
+					return lhs.first < rhs.first;
+				}
+			};
+			
+			struct Node
+			{
+				Node() :
+					bucket(0),
+					children(),
+					count(0),
+					cut()
+				{
+					this->children.fill(0);
+				}
+				
+				::std::size_t bucket;
+				
+				::std::array<::std::size_t, 2> children;
+				
+				::std::size_t count;
+				
+				Cut cut;
+			};
+			
+			typedef KdtreeScratch<Branch, Distance> Scratch;
+			
+			::std::size_t allocate()
+			{
+				this->buckets.resize(this->buckets.size() + this->bucketSize);
+				this->coordinates.resize(this->coordinates.size() + this->bucketSize * this->dim);
+				return this->buckets.size() / this->bucketSize - 1;
+			}
+			
+			template<typename InputIterator>
+			void divide(const ::std::size_t& node, InputIterator first, InputIterator last)
+			{
+				if (static_cast<::std::size_t>(::std::distance(first, last)) > this->bucketSize)
+				{
+					this->split(node, first, last);
+				}
+				else
+				{
+					this->nodes[node].bucket = this->allocate();
+					
+					for (InputIterator i = first; i != last; ++i)
+					{
+						this->store(node, *i);
+					}
+				}
+			}
+			
+			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+			{
+				::std::vector<Neighbor> neighbors;
+				this->search(query, k, radius, neighbors, sorted);
+				return neighbors;
+			}
+			
+			void search(const Value& query, const ::std::size_t* k, const Distance* radius, ::std::vector<Neighbor>& neighbors, const bool& sorted) const
+			{
+				static thread_local Scratch scratch;
+				
+				neighbors.clear();
+				
+				if (this->empty())
+				{
+					return;
+				}
+				
+				if (nullptr != k)
+				{
+					neighbors.reserve(::std::min(*k, this->size()));
+				}
+				
+				::std::size_t checks = 0;
+				
+				scratch.reset(this->dim);
+				this->search(0, query, k, radius, scratch, neighbors, checks, Distance());
+				
+				while (!scratch.branches.empty() && (!this->checks || checks < this->checks))
+				{
+					Branch branch = scratch.branches.front();
+					::std::pop_heap(scratch.branches.begin(), scratch.branches.end(), BranchCompare());
+					scratch.branches.pop_back();
+					scratch.load(branch.sidedist);
+					this->search(branch.node, query, k, radius, scratch, neighbors, checks, branch.dist);
+				}
+				
+				if (sorted)
+				{
+					::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+				}
+			}
+			
+			void search(const ::std::size_t& index, const Value& query, const ::std::size_t* k, const Distance* radius, Scratch& scratch, ::std::vector<Neighbor>& neighbors, ::std::size_t& checks, const Distance& mindist) const
+			{
+				using ::std::begin;
+				
+				const Node& node = this->nodes[index];
+				
+				if (0 == node.children[0])
+				{
+					auto q = begin(query);
+					const Distance* p = this->coordinates.data() + node.bucket * this->bucketSize * this->dim;
+					
+					for (::std::size_t i = 0; i < node.count; ++i, p += this->dim)
+					{
+						bool full = nullptr != k && neighbors.size() == *k;
+						Distance bound = full ? neighbors.front().first : nullptr != radius ? *radius : Distance();
+						bool bounded = full || nullptr != radius;
+						Distance distance = Distance();
+						::std::size_t j = 0;
+						
+						for (; j < this->dim; ++j)
+						{
+							distance += this->metric(*(q + j), p[j], j);
+							
+							if (bounded && distance >= bound)
+							{
+								break;
+							}
+						}
+						
+						if (j == this->dim)
+						{
+							if (full)
+							{
+								::std::pop_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+								neighbors.pop_back();
+							}
+							
+							neighbors.emplace_back(distance, this->buckets[node.bucket * this->bucketSize + i]);
+							::std::push_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+						}
+					}
+					
+					checks += node.count;
+				}
+				else
+				{
+					Distance value = *(begin(query) + node.cut.index);
+					Distance diff = value - node.cut.value;
+					
+					::std::size_t best = diff < 0 ? 0 : 1;
+					::std::size_t worst = diff < 0 ? 1 : 0;
+					
+					this->search(node.children[best], query, k, radius, scratch, neighbors, checks, mindist);
+					
+					Distance cutdist = this->metric(value, node.cut.value, node.cut.index);
+					Distance newdist = mindist - scratch.sidedist[node.cut.index] + cutdist;
+					
+					if (nullptr == k || neighbors.size() < *k || newdist <= neighbors.front().first)
+					{
+						if (!this->checks)
+						{
+							Distance dist = scratch.sidedist[node.cut.index];
+							scratch.sidedist[node.cut.index] = cutdist;
+							this->search(node.children[worst], query, k, radius, scratch, neighbors, checks, newdist);
+							scratch.sidedist[node.cut.index] = dist;
+						}
+						else
+						{
+							Distance dist = scratch.sidedist[node.cut.index];
+							scratch.sidedist[node.cut.index] = cutdist;
+							scratch.branches.emplace_back(newdist, node.children[worst], scratch.store());
+							scratch.sidedist[node.cut.index] = dist;
+							::std::push_heap(scratch.branches.begin(), scratch.branches.end(), BranchCompare());
+						}
+					}
+				}
+			}
+			
+			template<typename InputIterator>
+			Cut select(InputIterator first, InputIterator last)
+			{
+				using ::std::begin;
+				
+				::std::size_t distance = ::std::distance(first, last);
+				assert(distance > 0 || "mean expects at least one element");
+				::std::size_t samples = ::std::min(this->samples, distance);
+				
+				this->mean.resize(this->dim);
+				::std::fill(this->mean.begin(), this->mean.end(), Distance());
+				
+				this->var.resize(this->dim);
+				::std::fill(this->var.begin(), this->var.end(), Distance());
+				
+				for (InputIterator i = first; i < first + samples; ++i)
+				{
+					for (::std::size_t j = 0; j < this->dim; ++j)
+					{
+						this->mean[j] += *(begin(*i) + j);
+					}
+				}
+				
+				for (::std::size_t i = 0; i < this->dim; ++i)
+				{
+					this->mean[i] /= samples;
+				}
+				
+				for (InputIterator i = first; i < first + samples; ++i)
+				{
+					for (::std::size_t j = 0; j < this->dim; ++j)
+					{
+						Distance d = *(begin(*i) + j) - this->mean[j];
+						this->var[j] += d * d;
+					}
+				}
+				
+				typename ::std::vector<Distance>::iterator max = ::std::max_element(this->var.begin(), this->var.end());
+				
+				Cut cut;
+				cut.index = ::std::distance(this->var.begin(), max);
+				cut.value = this->mean[cut.index];
+				return cut;
+			}
+			
+			/**
+			 * Split node at the median of the dimension with largest variance.
+			 *
+			 * Values equal to the cut value may end up on either side, which
+			 * keeps the search bounds valid and guarantees progress for
+			 * duplicate values.
+			 */
+			template<typename InputIterator>
+			void split(const ::std::size_t& node, InputIterator first, InputIterator last)
+			{
+				using ::std::begin;
+				
+				Cut cut = this->select(first, last);
+				InputIterator median = first + ::std::distance(first, last) / 2;
+				::std::nth_element(first, median, last, cut);
+				cut.value = *(begin(*median) + cut.index);
+				
+				::std::size_t bucket = this->nodes[node].bucket;
+				::std::size_t count = this->nodes[node].count;
+				
+				this->nodes[node].children[0] = this->nodes.size();
+				this->nodes[node].children[1] = this->nodes.size() + 1;
+				this->nodes[node].count = 0;
+				this->nodes[node].cut = cut;
+				this->nodes.resize(this->nodes.size() + 2);
+				
+				::std::size_t left = this->nodes[node].children[0];
+				::std::size_t right = this->nodes[node].children[1];
+				
+				if (count > 0)
+				{
+					// reuse bucket of former leaf
+					this->nodes[left].bucket = bucket;
+					
+					for (InputIterator i = first; i != median; ++i)
+					{
+						this->store(left, *i);
+					}
+					
+					this->divide(right, median, last);
+				}
+				else
+				{
+					this->divide(left, first, median);
+					this->divide(right, median, last);
+				}
+			}
+			
+			void store(const ::std::size_t& node, const Value& value)
+			{
+				using ::std::begin;
+				
+				::std::size_t slot = this->nodes[node].bucket * this->bucketSize + this->nodes[node].count;
+				this->buckets[slot] = value;
+				::std::copy(begin(value), begin(value) + this->dim, this->coordinates.begin() + slot * this->dim);
+				++this->nodes[node].count;
+			}
+			
+			::std::size_t bucketSize;
+			
+			::std::vector<Value> buckets;
+			
+			::boost::optional<::std::size_t> checks;
+			
+			::std::vector<Distance> coordinates;
+			
+			::std::size_t dim;
+			
+			::std::vector<Distance> mean;
+			
+			Metric metric;
+			
+			::std::vector<Node> nodes;
+			
+			::std::size_t samples;
+			
+			::std::vector<Value> scratch;
+			
+			::std::size_t values;
+			
+			::std::vector<Distance> var;
+		};
+	}
+}
+
+#endif // RL_MATH_KDTREEBUCKETNEARESTNEIGHBORS_H
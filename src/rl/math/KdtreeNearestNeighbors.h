@@ -38,6 +38,8 @@
 #include <vector>
 #include <boost/optional.hpp>
 #include <rl/std/iterator.h>
+
+#include "KdtreeScratch.h"
 #include <rl/std/memory.h>
 
 namespace rl
@@ -82,35 +84,35 @@ namespace rl
 			
 			explicit KdtreeNearestNeighbors(const Metric& metric) :
 				checks(),
-				mean(),
 				metric(metric),
+				rebuild(false),
+				rebuildSize(0),
 				root(),
 				samples(100),
-				values(0),
-				var()
+				values(0)
 			{
 			}
 			
 			explicit KdtreeNearestNeighbors(Metric&& metric = Metric()) :
 				checks(),
-				mean(),
 				metric(::std::move(metric)),
+				rebuild(false),
+				rebuildSize(0),
 				root(),
 				samples(100),
-				values(0),
-				var()
+				values(0)
 			{
 			}
 			
 			template<typename InputIterator>
 			KdtreeNearestNeighbors(InputIterator first, InputIterator last, const Metric& metric) :
 				checks(),
-				mean(),
 				metric(metric),
+				rebuild(false),
+				rebuildSize(0),
 				root(),
 				samples(100),
-				values(0),
-				var()
+				values(0)
 			{
 				this->insert(first, last);
 			}
@@ -118,12 +120,12 @@ namespace rl
 			template<typename InputIterator>
 			KdtreeNearestNeighbors(InputIterator first, InputIterator last, Metric&& metric = Metric()) :
 				checks(),
-				mean(),
 				metric(::std::move(metric)),
+				rebuild(false),
+				rebuildSize(0),
 				root(),
 				samples(100),
-				values(0),
-				var()
+				values(0)
 			{
 				this->insert(first, last);
 			}
@@ -137,6 +139,7 @@ namespace rl
 				this->root.children[0].reset(nullptr);
 				this->root.children[1].reset(nullptr);
 				this->root.data.reset();
+				this->rebuildSize = 0;
 				this->values = 0;
 			}
 			
@@ -158,6 +161,11 @@ namespace rl
 				return this->checks;
 			}
 			
+			bool getRebuild() const
+			{
+				return this->rebuild;
+			}
+			
 			::std::size_t getSamples() const
 			{
 				return this->samples;
@@ -172,14 +180,19 @@ namespace rl
 					
 					if (size > 1)
 					{
+#ifdef _OPENMP
+#pragma omp parallel if (size > 1000)
+#pragma omp single
+#endif
 						this->divide(this->root, first, last);
 					}
-					else
+					else if (size > 0)
 					{
 						this->root.data = *first;
 					}
 					
-					this->values += ::std::distance(first, last);
+					this->values += size;
+					this->rebuildSize = 2 * this->values;
 				}
 				else
 				{
@@ -195,10 +208,25 @@ namespace rl
 				return this->search(query, &k, nullptr, sorted);
 			}
 			
+			/**
+			 * Search k nearest neighbors without allocating memory.
+			 *
+			 * Reuses the capacity of neighbors and a per-thread search buffer.
+			 */
+			void nearest(const Value& query, const ::std::size_t& k, ::std::vector<Neighbor>& neighbors, const bool& sorted = true) const
+			{
+				this->search(query, &k, nullptr, neighbors, sorted);
+			}
+			
 			void push(const Value& value)
 			{
 				this->push(this->root, value);
 				++this->values;
+				
+				if (this->rebuild && this->values >= this->rebuildSize)
+				{
+					this->build();
+				}
 			}
 			
 			::std::vector<Neighbor> radius(const Value& query, const Distance& radius, const bool& sorted = true) const
@@ -206,11 +234,32 @@ namespace rl
 				return this->search(query, nullptr, &radius, sorted);
 			}
 			
+			/**
+			 * Search neighbors within radius without allocating memory.
+			 *
+			 * Reuses the capacity of neighbors and a per-thread search buffer.
+			 */
+			void radius(const Value& query, const Distance& radius, ::std::vector<Neighbor>& neighbors, const bool& sorted = true) const
+			{
+				this->search(query, nullptr, &radius, neighbors, sorted);
+			}
+			
 			void setChecks(const ::boost::optional<::std::size_t>& checks)
 			{
 				this->checks = checks;
 			}
 			
+			/**
+			 * Rebuild tree with bulk insertion each time its size doubles.
+			 *
+			 * Keeps trees grown by push() balanced, as cuts are otherwise
+			 * chosen from the first values only.
+			 */
+			void setRebuild(const bool& rebuild)
+			{
+				this->rebuild = rebuild;
+			}
+			
 			void setSamples(const ::std::size_t& samples)
 			{
 				this->samples = samples;
@@ -224,12 +273,13 @@ namespace rl
 			void swap(KdtreeNearestNeighbors& other)
 			{
 				using ::std::swap;
-				swap(this->mean, other.mean);
+				swap(this->checks, other.checks);
 				swap(this->metric, other.metric);
+				swap(this->rebuild, other.rebuild);
+				swap(this->rebuildSize, other.rebuildSize);
 				swap(this->samples, other.samples);
 				swap(this->root, other.root);
 				swap(this->values, other.values);
-				swap(this->var, other.var);
 			}
 			
 			friend void swap(KdtreeNearestNeighbors& lhs, KdtreeNearestNeighbors& rhs)
@@ -242,25 +292,18 @@ namespace rl
 		private:
 			struct Branch
 			{
-				Branch(Distance& dist, ::std::vector<Distance>& sidedist, const Node* node) :
+				Branch(const Distance& dist, const Node* node, const ::std::size_t& sidedist) :
 					dist(dist),
 					node(node),
 					sidedist(sidedist)
 				{
 				}
 				
-				Branch(Distance& dist, ::std::vector<Distance>&& sidedist, const Node* node) :
-					dist(dist),
-					node(node),
-					sidedist(::std::move(sidedist))
-				{
-				}
-				
 				Distance dist;
 				
 				const Node* node;
 				
-				::std::vector<Distance> sidedist;
+				::std::size_t sidedist;
 			};
 			
 			struct BranchCompare
@@ -325,13 +368,28 @@ namespace rl
 				::boost::optional<Value> data;
 			};
 			
+			typedef KdtreeScratch<Branch, Distance> Scratch;
+			
+			void build()
+			{
+				::std::vector<Value> data = this->data();
+				this->clear();
+				this->insert(data.begin(), data.end());
+			}
+			
 			void data(const Node& node, ::std::vector<Value>& data) const
 			{
-				data.push_back(*node.data);
+				if (node.data)
+				{
+					data.push_back(*node.data);
+				}
 				
 				for (::std::size_t i = 0; i < node.children.size(); ++i)
 				{
-					this->data(*node.children[i], data);
+					if (nullptr != node.children[i])
+					{
+						this->data(*node.children[i], data);
+					}
 				}
 			}
 			
@@ -345,18 +403,26 @@ namespace rl
 				{
 					node.children[i] = ::rl::std14::make_unique<Node>();
 					
+					Node* child = node.children[i].get();
 					InputIterator begin = 0 == i ? first : split;
 					InputIterator end = 0 == i ? split : last;
 					
 					if (::std::distance(begin, end) > 1)
 					{
-						this->divide(*node.children[i], begin, end);
+#ifdef _OPENMP
+#pragma omp task if (::std::distance(begin, end) > 1000)
+#endif
+						this->divide(*child, begin, end);
 					}
 					else
 					{
-						node.children[i]->data = *begin;
+						child->data = *begin;
 					}
 				}
+				
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
 			}
 			
 			void push(Node& node, const Value& value)
@@ -413,14 +479,23 @@ namespace rl
 			}
 			
 			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+			{
+				::std::vector<Neighbor> neighbors;
+				this->search(query, k, radius, neighbors, sorted);
+				return neighbors;
+			}
+			
+			void search(const Value& query, const ::std::size_t* k, const Distance* radius, ::std::vector<Neighbor>& neighbors, const bool& sorted) const
 			{
 				using ::rl::std17::size;
 				
-				::std::vector<Neighbor> neighbors;
+				static thread_local Scratch scratch;
+				
+				neighbors.clear();
 				
 				if (this->empty())
 				{
-					return neighbors;
+					return;
 				}
 				
 				if (nullptr != k)
@@ -430,27 +505,25 @@ namespace rl
 				
 				::std::size_t checks = 0;
 				
-				::std::vector<Branch> branches;
-				::std::vector<Distance> sidedist(size(query), Distance());
-				this->search(this->root, query, k, radius, branches, neighbors, checks, Distance(), sidedist);
+				scratch.reset(size(query));
+				this->search(this->root, query, k, radius, scratch, neighbors, checks, Distance());
 				
-				while (!branches.empty() && (!this->checks || checks < this->checks))
+				while (!scratch.branches.empty() && (!this->checks || checks < this->checks))
 				{
-					Branch branch = ::std::move(branches.front());
-					::std::pop_heap(branches.begin(), branches.end(), BranchCompare());
-					branches.pop_back();
-					this->search(*branch.node, query, k, radius, branches, neighbors, checks, branch.dist, branch.sidedist);
+					Branch branch = scratch.branches.front();
+					::std::pop_heap(scratch.branches.begin(), scratch.branches.end(), BranchCompare());
+					scratch.branches.pop_back();
+					scratch.load(branch.sidedist);
+					this->search(*branch.node, query, k, radius, scratch, neighbors, checks, branch.dist);
 				}
 				
 				if (sorted)
 				{
 					::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
 				}
-				
-				return neighbors;
 			}
 			
-			void search(const Node& node, const Value& query, const ::std::size_t* k, const Distance* radius, ::std::vector<Branch>& branches, ::std::vector<Neighbor>& neighbors, ::std::size_t& checks, const Distance& mindist, ::std::vector<Distance>& sidedist) const
+			void search(const Node& node, const Value& query, const ::std::size_t* k, const Distance* radius, Scratch& scratch, ::std::vector<Neighbor>& neighbors, ::std::size_t& checks, const Distance& mindist) const
 			{
 				using ::std::begin;
 				
@@ -486,33 +559,34 @@ namespace rl
 					::std::size_t best = diff < 0 ? 0 : 1;
 					::std::size_t worst = diff < 0 ? 1 : 0;
 					
-					this->search(*node.children[best], query, k, radius, branches, neighbors, checks, mindist, sidedist);
+					this->search(*node.children[best], query, k, radius, scratch, neighbors, checks, mindist);
 					
 					Distance cutdist = this->metric(value, node.cut.value, node.cut.index);
-					Distance newdist = mindist - sidedist[node.cut.index] + cutdist;
+					Distance newdist = mindist - scratch.sidedist[node.cut.index] + cutdist;
 					
 					if (nullptr == k || neighbors.size() < *k || newdist <= neighbors.front().first)
 					{
 						if (!this->checks)
 						{
-							Distance dist = sidedist[node.cut.index];
-							sidedist[node.cut.index] = cutdist;
-							this->search(*node.children[worst], query, k, radius, branches, neighbors, checks, newdist, sidedist);
-							sidedist[node.cut.index] = dist;
+							Distance dist = scratch.sidedist[node.cut.index];
+							scratch.sidedist[node.cut.index] = cutdist;
+							this->search(*node.children[worst], query, k, radius, scratch, neighbors, checks, newdist);
+							scratch.sidedist[node.cut.index] = dist;
 						}
 						else
 						{
-							::std::vector<Distance> newsidedist(sidedist);
-							newsidedist[node.cut.index] = cutdist;
-							branches.emplace_back(newdist, ::std::move(newsidedist), node.children[worst].get());
-							::std::push_heap(branches.begin(), branches.end(), BranchCompare());
+							Distance dist = scratch.sidedist[node.cut.index];
+							scratch.sidedist[node.cut.index] = cutdist;
+							scratch.branches.emplace_back(newdist, node.children[worst].get(), scratch.store());
+							scratch.sidedist[node.cut.index] = dist;
+							::std::push_heap(scratch.branches.begin(), scratch.branches.end(), BranchCompare());
 						}
 					}
 				}
 			}
 			
 			template<typename InputIterator>
-			Cut select(InputIterator first, InputIterator last)
+			Cut select(InputIterator first, InputIterator last) const
 			{
 				using ::std::begin;
 				using ::rl::std17::size;
@@ -522,55 +596,52 @@ namespace rl
 				::std::size_t samples = ::std::min(this->samples, distance);
 				::std::size_t dim = size(*first);
 				
-				this->mean.resize(dim);
-				::std::fill(this->mean.begin(), this->mean.end(), Distance());
-				
-				this->var.resize(dim);
-				::std::fill(this->var.begin(), this->var.end(), Distance());
+				::std::vector<Distance> mean(dim, Distance());
+				::std::vector<Distance> var(dim, Distance());
 				
 				for (InputIterator i = first; i < first + samples; ++i)
 				{
 					for (::std::size_t j = 0; j < dim; ++j)
 					{
-						this->mean[j] += *(begin(*i) + j);
+						mean[j] += *(begin(*i) + j);
 					}
 				}
 				
 				for (::std::size_t i = 0; i < dim; ++i)
 				{
-					this->mean[i] /= samples;
+					mean[i] /= samples;
 				}
 				
 				for (InputIterator i = first; i < first + samples; ++i)
 				{
 					for (::std::size_t j = 0; j < dim; ++j)
 					{
-						Distance d = *(begin(*i) + j) - this->mean[j];
-						this->var[j] += d * d;
+						Distance d = *(begin(*i) + j) - mean[j];
+						var[j] += d * d;
 					}
 				}
 				
-				typename ::std::vector<Distance>::iterator max = ::std::max_element(this->var.begin(), this->var.end());
+				typename ::std::vector<Distance>::iterator max = ::std::max_element(var.begin(), var.end());
 				
 				Cut cut;
-				cut.index = ::std::distance(this->var.begin(), max);
-				cut.value = this->mean[cut.index];
+				cut.index = ::std::distance(var.begin(), max);
+				cut.value = mean[cut.index];
 				return cut;
 			}
 			
 			::boost::optional<::std::size_t> checks;
 			
-			::std::vector<Distance> mean;
-			
 			Metric metric;
 			
+			bool rebuild;
+			
+			::std::size_t rebuildSize;
+			
 			Node root;
 			
 			::std::size_t samples;
 			
 			::std::size_t values;
-			
-			::std::vector<Distance> var;
 		};
 	}
 }
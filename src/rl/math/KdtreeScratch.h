@@ -0,0 +1,94 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_MATH_KDTREESCRATCH_H
+#define RL_MATH_KDTREESCRATCH_H
+
+#include <algorithm>
+#include <vector>
+
+namespace rl
+{
+	namespace math
+	{
+		/**
+		 * Per-thread buffers of k-d tree searches reused across queries.
+		 *
+		 * Side distances of pending branches are stored in slots of one
+		 * shared array, released slots are recycled.
+		 */
+		template<typename Branch, typename Distance>
+		struct KdtreeScratch
+		{
+			/**
+			 * Restore side distances of slot and release it.
+			 */
+			void load(const ::std::size_t& slot)
+			{
+				::std::copy(this->sidedists.begin() + slot, this->sidedists.begin() + slot + this->sidedist.size(), this->sidedist.begin());
+				this->free.push_back(slot);
+			}
+			
+			/**
+			 * Clear pending branches and reset side distances for a new query.
+			 */
+			void reset(const ::std::size_t& dim)
+			{
+				this->branches.clear();
+				this->free.clear();
+				this->sidedist.assign(dim, Distance());
+				this->sidedists.clear();
+			}
+			
+			/**
+			 * Store current side distances in a released or new slot.
+			 */
+			::std::size_t store()
+			{
+				if (this->free.empty())
+				{
+					this->sidedists.insert(this->sidedists.end(), this->sidedist.begin(), this->sidedist.end());
+					return this->sidedists.size() - this->sidedist.size();
+				}
+				
+				::std::size_t slot = this->free.back();
+				this->free.pop_back();
+				::std::copy(this->sidedist.begin(), this->sidedist.end(), this->sidedists.begin() + slot);
+				return slot;
+			}
+			
+			::std::vector<Branch> branches;
+			
+			::std::vector<::std::size_t> free;
+			
+			::std::vector<Distance> sidedist;
+			
+			::std::vector<Distance> sidedists;
+		};
+	}
+}
+
+#endif // RL_MATH_KDTREESCRATCH_H
@@ -25,6 +25,7 @@
 //
 
 #include "AddRrtConCon.h"
+#include "Profiler.h"
 #include "SimpleModel.h"
 #include "Viewer.h"
 
@@ -47,6 +48,8 @@ namespace rl
 		Rrt::Vertex
 		AddRrtConCon::addVertex(Tree& tree, const VectorPtr& q)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::insertion);
+			
 			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
 			bundle->index = ::boost::num_vertices(tree) - 1;
 			bundle->q = q;
@@ -59,6 +62,8 @@ namespace rl
 			
 			if (nullptr != this->getViewer())
 			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
 				this->getViewer()->drawConfigurationVertex(*get(tree, v)->q);
 			}
 			
@@ -116,17 +121,17 @@ namespace rl
 		bool
 		AddRrtConCon::solve()
 		{
-			this->time = ::std::chrono::steady_clock::now();
+			this->initialize();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->begin[0] = this->addVertex(this->tree[0], this->pool.allocate(*this->getStart()));
+			this->begin[1] = this->addVertex(this->tree[1], this->pool.allocate(*this->getGoal()));
 			
 			Tree* a = &this->tree[0];
 			Tree* b = &this->tree[1];
 			
 			::rl::math::Vector chosen(this->getModel()->getDofPosition());
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration())
+			while (this->proceed())
 			{
 				for (::std::size_t j = 0; j < 2; ++j)
 				{
@@ -24,6 +24,8 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <vector>
+
 #include "AdvancedOptimizer.h"
 #include "SimpleModel.h"
 #include "Verifier.h"
@@ -58,67 +60,81 @@ namespace rl
 		
 		void
 		AdvancedOptimizer::process(VectorList& path)
+		{
+			Path contiguous(path);
+			this->process(contiguous);
+			path = contiguous.toList();
+		}
+		
+		void
+		AdvancedOptimizer::process(Path& path)
 		{
 			bool changed = true;
 			::rl::math::Vector inter(this->getModel()->getDofPosition());
 			
-			VectorList::iterator i;
-			VectorList::iterator j;
-			VectorList::iterator k;
-			
 			while (changed && path.size() > 2)
 			{
 				while (changed && path.size() > 2)
 				{
 					changed = false;
 					
-					i = path.begin();
-					j = ++path.begin();
-					k = ++++path.begin();
+					::std::vector<::rl::math::Vector> q(path.size());
 					
-					while (i != path.end() && j != path.end() && k != path.end())
+					for (::std::size_t i = 0; i < path.size(); ++i)
 					{
-						::rl::math::Real ik = this->getModel()->distance(*i, *k);
+						q[i] = path[i];
+					}
+					
+					// vertices i + 1 with a sufficient detour are candidates,
+					// shortcuts of all candidates of a pass are verified at once
+					::std::vector<::std::size_t> candidates;
+					::std::vector<Verifier::Segment> segments;
+					
+					for (::std::size_t i = 0; i + 2 < q.size(); ++i)
+					{
+						::rl::math::Real ik = this->getModel()->distance(q[i], q[i + 2]);
+						::rl::math::Real ij = this->getModel()->distance(q[i], q[i + 1]);
+						::rl::math::Real jk = this->getModel()->distance(q[i + 1], q[i + 2]);
+						
+						::rl::math::Real alpha = ij / (ij + jk);
+						
+						this->getModel()->interpolate(q[i], q[i + 2], alpha, inter);
 						
-						if (!this->getVerifier()->isColliding(*i, *k, ik))
+						::rl::math::Real ratio = this->getModel()->distance(q[i + 1], inter) / ik;
+						
+						if (ratio > this->ratio)
 						{
-							::rl::math::Real ij = this->getModel()->distance(*i, *j);
-							::rl::math::Real jk = this->getModel()->distance(*j, *k);
-							
-							::rl::math::Real alpha = ij / (ij + jk);
-							
-							this->getModel()->interpolate(*i, *k, alpha, inter);
-							
-							::rl::math::Real ratio = this->getModel()->distance(*j, inter) / ik;
-							
-							if (ratio > this->ratio)
-							{
-								VectorList::iterator l = j;
-								++j;
-								++k;
-								path.erase(l);
-								
-								if (nullptr != this->getViewer())
-								{
-									this->getViewer()->drawConfigurationPath(path);
-								}
-								
-								changed = true;
-							}
-							else
-							{
-								++i;
-								++j;
-								++k;
-							}
+							candidates.push_back(i);
+							segments.push_back(Verifier::Segment(&q[i], &q[i + 2], ik));
 						}
-						else
+					}
+					
+					if (segments.empty())
+					{
+						break;
+					}
+					
+					::std::vector<bool> colliding = this->getVerifier()->isColliding(segments);
+					
+					// shortcuts of adjacent vertices share a vertex, only the first is applied
+					::std::size_t removed = 0;
+					::std::size_t next = 0;
+					
+					for (::std::size_t j = 0; j < candidates.size(); ++j)
+					{
+						if (!colliding[j] && candidates[j] >= next)
 						{
-							++i;
-							++j;
-							++k;
+							path.erase(candidates[j] + 1 - removed);
+							++removed;
+							next = candidates[j] + 2;
+							changed = true;
 						}
 					}
+					
+					if (changed && nullptr != this->getViewer())
+					{
+						this->getViewer()->drawConfigurationPath(path.toList());
+					}
 				}
 				
 				if (this->subdivide(path, this->length))
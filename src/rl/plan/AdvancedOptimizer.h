@@ -46,6 +46,8 @@ namespace rl
 			
 			void process(VectorList& path);
 			
+			void process(Path& path);
+			
 			void setLength(const ::rl::math::Real& length);
 			
 			void setRatio(const ::rl::math::Real& ratio);
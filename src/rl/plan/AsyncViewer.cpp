@@ -0,0 +1,550 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+#include "AsyncViewer.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		AsyncViewer::AsyncViewer(Viewer* viewer, const ::std::size_t& capacity) :
+			Viewer(),
+			cells(),
+			coalesced(new ::std::atomic<::std::uint64_t>[static_cast<::std::size_t>(Type::workVertex) + 1]),
+			dequeue(0),
+			dropped(0),
+			edges(0),
+			edgeStride(1),
+			enqueue(0),
+			generation(0),
+			mask(1),
+			processed(0),
+			running(false),
+			sequence(0),
+			thread(),
+			vertexStride(1),
+			vertices(0),
+			viewer(viewer)
+		{
+			while (this->mask + 1 < capacity)
+			{
+				this->mask = (this->mask << 1) | 1;
+			}
+			
+			this->cells.reset(new Cell[this->mask + 1]);
+			
+			for (::std::size_t i = 0; i < this->mask + 1; ++i)
+			{
+				this->cells[i].sequence.store(i, ::std::memory_order_relaxed);
+			}
+			
+			for (::std::size_t i = 0; i < static_cast<::std::size_t>(Type::workVertex) + 1; ++i)
+			{
+				this->coalesced[i].store(0, ::std::memory_order_relaxed);
+			}
+		}
+		
+		AsyncViewer::~AsyncViewer()
+		{
+			this->stop();
+		}
+		
+		void
+		AsyncViewer::dispatch(const Event& event)
+		{
+			switch (event.type)
+			{
+			case Type::configuration:
+			case Type::configurationPath:
+			case Type::work:
+			case Type::workPath:
+				if (event.sequence < this->coalesced[static_cast<::std::size_t>(event.type)].load(::std::memory_order_relaxed))
+				{
+					return;
+				}
+				break;
+			default:
+				break;
+			}
+			
+			switch (event.type)
+			{
+			case Type::configuration:
+				this->viewer->drawConfiguration(event.q0);
+				break;
+			case Type::configurationEdge:
+				this->viewer->drawConfigurationEdge(event.q0, event.q1, event.free);
+				break;
+			case Type::configurationPath:
+				this->viewer->drawConfigurationPath(event.path);
+				break;
+			case Type::configurationVertex:
+				this->viewer->drawConfigurationVertex(event.q0, event.free);
+				break;
+			case Type::line:
+				this->viewer->drawLine(event.q0, event.q1);
+				break;
+			case Type::message:
+				this->viewer->showMessage(event.message);
+				break;
+			case Type::point:
+				this->viewer->drawPoint(event.q0);
+				break;
+			case Type::resetEdges:
+				this->viewer->resetEdges();
+				break;
+			case Type::resetLines:
+				this->viewer->resetLines();
+				break;
+			case Type::resetPoints:
+				this->viewer->resetPoints();
+				break;
+			case Type::resetSpheres:
+				this->viewer->resetSpheres();
+				break;
+			case Type::resetVertices:
+				this->viewer->resetVertices();
+				break;
+			case Type::sphere:
+				this->viewer->drawSphere(event.q0, event.radius);
+				break;
+			case Type::work:
+				{
+					::rl::math::Transform t;
+					t.matrix() = event.t;
+					this->viewer->drawWork(t);
+				}
+				break;
+			case Type::workEdge:
+				this->viewer->drawWorkEdge(event.q0, event.q1);
+				break;
+			case Type::workPath:
+				this->viewer->drawWorkPath(event.path);
+				break;
+			case Type::workVertex:
+				this->viewer->drawWorkVertex(event.q0);
+				break;
+			default:
+				break;
+			}
+		}
+		
+		void
+		AsyncViewer::drawConfiguration(const ::rl::math::Vector& q)
+		{
+			Event event;
+			event.q0 = q;
+			event.type = Type::configuration;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawConfigurationEdge(const ::rl::math::Vector& q0, const ::rl::math::Vector& q1, const bool& free)
+		{
+			if (this->edges.fetch_add(1, ::std::memory_order_relaxed) % this->edgeStride.load(::std::memory_order_relaxed) > 0)
+			{
+				return;
+			}
+			
+			Event event;
+			event.free = free;
+			event.q0 = q0;
+			event.q1 = q1;
+			event.type = Type::configurationEdge;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawConfigurationPath(const VectorList& path)
+		{
+			Event event;
+			event.path = path;
+			event.type = Type::configurationPath;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawConfigurationVertex(const ::rl::math::Vector& q, const bool& free)
+		{
+			if (this->vertices.fetch_add(1, ::std::memory_order_relaxed) % this->vertexStride.load(::std::memory_order_relaxed) > 0)
+			{
+				return;
+			}
+			
+			Event event;
+			event.free = free;
+			event.q0 = q;
+			event.type = Type::configurationVertex;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawLine(const ::rl::math::Vector& xyz0, const ::rl::math::Vector& xyz1)
+		{
+			Event event;
+			event.q0 = xyz0;
+			event.q1 = xyz1;
+			event.type = Type::line;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawPoint(const ::rl::math::Vector& xyz)
+		{
+			Event event;
+			event.q0 = xyz;
+			event.type = Type::point;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawSphere(const ::rl::math::Vector& center, const ::rl::math::Real& radius)
+		{
+			Event event;
+			event.q0 = center;
+			event.radius = radius;
+			event.type = Type::sphere;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawWork(const ::rl::math::Transform& t)
+		{
+			Event event;
+			event.t = t.matrix();
+			event.type = Type::work;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawWorkEdge(const ::rl::math::Vector& q0, const ::rl::math::Vector& q1)
+		{
+			if (this->edges.fetch_add(1, ::std::memory_order_relaxed) % this->edgeStride.load(::std::memory_order_relaxed) > 0)
+			{
+				return;
+			}
+			
+			Event event;
+			event.q0 = q0;
+			event.q1 = q1;
+			event.type = Type::workEdge;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawWorkPath(const VectorList& path)
+		{
+			Event event;
+			event.path = path;
+			event.type = Type::workPath;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::drawWorkVertex(const ::rl::math::Vector& q)
+		{
+			if (this->vertices.fetch_add(1, ::std::memory_order_relaxed) % this->vertexStride.load(::std::memory_order_relaxed) > 0)
+			{
+				return;
+			}
+			
+			Event event;
+			event.q0 = q;
+			event.type = Type::workVertex;
+			this->push(event);
+		}
+		
+		::std::size_t
+		AsyncViewer::getCapacity() const
+		{
+			return this->mask + 1;
+		}
+		
+		::std::size_t
+		AsyncViewer::getDropped() const
+		{
+			return this->dropped.load(::std::memory_order_relaxed);
+		}
+		
+		::std::size_t
+		AsyncViewer::getEdgeStride() const
+		{
+			return this->edgeStride.load(::std::memory_order_relaxed);
+		}
+		
+		::std::size_t
+		AsyncViewer::getVertexStride() const
+		{
+			return this->vertexStride.load(::std::memory_order_relaxed);
+		}
+		
+		Viewer*
+		AsyncViewer::getViewer() const
+		{
+			return this->viewer;
+		}
+		
+		bool
+		AsyncViewer::pop(Event& event)
+		{
+			::std::size_t position = this->dequeue.load(::std::memory_order_relaxed);
+			Cell* cell;
+			
+			while (true)
+			{
+				cell = &this->cells[position & this->mask];
+				::std::size_t sequence = cell->sequence.load(::std::memory_order_acquire);
+				::std::ptrdiff_t difference = static_cast<::std::ptrdiff_t>(sequence) - static_cast<::std::ptrdiff_t>(position + 1);
+				
+				if (0 == difference)
+				{
+					if (this->dequeue.compare_exchange_weak(position, position + 1, ::std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					return false;
+				}
+				else
+				{
+					position = this->dequeue.load(::std::memory_order_relaxed);
+				}
+			}
+			
+			event = ::std::move(cell->event);
+			cell->sequence.store(position + this->mask + 1, ::std::memory_order_release);
+			
+			return true;
+		}
+		
+		::std::size_t
+		AsyncViewer::process()
+		{
+			::std::size_t count = 0;
+			Event event;
+			
+			while (true)
+			{
+				::std::uint64_t generation = this->generation.load(::std::memory_order_acquire);
+				
+				if (generation != this->processed)
+				{
+					this->viewer->reset();
+					this->processed = generation;
+					++count;
+				}
+				
+				if (!this->pop(event))
+				{
+					break;
+				}
+				
+				if (event.generation == this->processed)
+				{
+					this->dispatch(event);
+					++count;
+				}
+			}
+			
+			return count;
+		}
+		
+		void
+		AsyncViewer::push(Event& event)
+		{
+			event.generation = this->generation.load(::std::memory_order_acquire);
+			event.sequence = this->sequence.fetch_add(1, ::std::memory_order_relaxed) + 1;
+			
+			::std::size_t position = this->enqueue.load(::std::memory_order_relaxed);
+			Cell* cell;
+			
+			while (true)
+			{
+				cell = &this->cells[position & this->mask];
+				::std::size_t sequence = cell->sequence.load(::std::memory_order_acquire);
+				::std::ptrdiff_t difference = static_cast<::std::ptrdiff_t>(sequence) - static_cast<::std::ptrdiff_t>(position);
+				
+				if (0 == difference)
+				{
+					if (this->enqueue.compare_exchange_weak(position, position + 1, ::std::memory_order_relaxed))
+					{
+						break;
+					}
+				}
+				else if (difference < 0)
+				{
+					this->dropped.fetch_add(1, ::std::memory_order_relaxed);
+					return;
+				}
+				else
+				{
+					position = this->enqueue.load(::std::memory_order_relaxed);
+				}
+			}
+			
+			Type type = event.type;
+			::std::uint64_t sequence = event.sequence;
+			
+			cell->event = ::std::move(event);
+			cell->sequence.store(position + 1, ::std::memory_order_release);
+			
+			// mark as latest only after queued, so a dropped call never hides its predecessors
+			
+			::std::atomic<::std::uint64_t>& latest = this->coalesced[static_cast<::std::size_t>(type)];
+			::std::uint64_t previous = latest.load(::std::memory_order_relaxed);
+			
+			while (previous < sequence && !latest.compare_exchange_weak(previous, sequence, ::std::memory_order_relaxed))
+			{
+			}
+		}
+		
+		void
+		AsyncViewer::reset()
+		{
+			this->edges.store(0, ::std::memory_order_relaxed);
+			this->vertices.store(0, ::std::memory_order_relaxed);
+			this->generation.fetch_add(1, ::std::memory_order_release);
+		}
+		
+		void
+		AsyncViewer::resetEdges()
+		{
+			Event event;
+			event.type = Type::resetEdges;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::resetLines()
+		{
+			Event event;
+			event.type = Type::resetLines;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::resetPoints()
+		{
+			Event event;
+			event.type = Type::resetPoints;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::resetSpheres()
+		{
+			Event event;
+			event.type = Type::resetSpheres;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::resetVertices()
+		{
+			Event event;
+			event.type = Type::resetVertices;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::run()
+		{
+			while (this->running.load(::std::memory_order_acquire))
+			{
+				if (0 == this->process())
+				{
+					::std::this_thread::sleep_for(::std::chrono::milliseconds(1));
+				}
+			}
+		}
+		
+		void
+		AsyncViewer::setEdgeStride(const ::std::size_t& edgeStride)
+		{
+			this->edgeStride.store(::std::max<::std::size_t>(1, edgeStride), ::std::memory_order_relaxed);
+		}
+		
+		void
+		AsyncViewer::setVertexStride(const ::std::size_t& vertexStride)
+		{
+			this->vertexStride.store(::std::max<::std::size_t>(1, vertexStride), ::std::memory_order_relaxed);
+		}
+		
+		void
+		AsyncViewer::showMessage(const ::std::string& message)
+		{
+			Event event;
+			event.message = message;
+			event.type = Type::message;
+			this->push(event);
+		}
+		
+		void
+		AsyncViewer::start()
+		{
+			if (this->thread.joinable())
+			{
+				return;
+			}
+			
+			this->running.store(true, ::std::memory_order_release);
+			this->thread = ::std::thread(&AsyncViewer::run, this);
+		}
+		
+		void
+		AsyncViewer::stop()
+		{
+			if (!this->thread.joinable())
+			{
+				return;
+			}
+			
+			this->running.store(false, ::std::memory_order_release);
+			this->thread.join();
+			this->process();
+		}
+		
+		AsyncViewer::Event::Event() :
+			free(true),
+			generation(0),
+			message(),
+			path(),
+			q0(),
+			q1(),
+			radius(0),
+			sequence(0),
+			t(),
+			type(Type::configuration)
+		{
+		}
+	}
+}
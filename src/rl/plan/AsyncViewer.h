@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_ASYNCVIEWER_H
+#define RL_PLAN_ASYNCVIEWER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "Viewer.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Viewer adaptor forwarding draw calls asynchronously.
+		 *
+		 * Draw calls are copied into a lock-free bounded queue and forwarded to
+		 * the wrapped viewer by a consumer thread started with start(), or by
+		 * calling process() from a thread of choice. Calls never block; if the
+		 * queue is full, the call is dropped and counted in getDropped().
+		 *
+		 * Configurations, work frames and paths are coalesced, only the latest
+		 * one is forwarded. Edges and vertices can be decimated with
+		 * setEdgeStride() and setVertexStride(). reset() is never dropped and
+		 * discards all calls queued before it.
+		 */
+		class RL_PLAN_EXPORT AsyncViewer : public Viewer
+		{
+		public:
+			AsyncViewer(Viewer* viewer, const ::std::size_t& capacity = 8192);
+			
+			virtual ~AsyncViewer();
+			
+			void drawConfiguration(const ::rl::math::Vector& q);
+			
+			void drawConfigurationEdge(const ::rl::math::Vector& q0, const ::rl::math::Vector& q1, const bool& free = true);
+			
+			void drawConfigurationPath(const VectorList& path);
+			
+			void drawConfigurationVertex(const ::rl::math::Vector& q, const bool& free = true);
+			
+			void drawLine(const ::rl::math::Vector& xyz0, const ::rl::math::Vector& xyz1);
+			
+			void drawPoint(const ::rl::math::Vector& xyz);
+			
+			void drawSphere(const ::rl::math::Vector& center, const ::rl::math::Real& radius);
+			
+			void drawWork(const ::rl::math::Transform& t);
+			
+			void drawWorkEdge(const ::rl::math::Vector& q0, const ::rl::math::Vector& q1);
+			
+			void drawWorkPath(const VectorList& path);
+			
+			void drawWorkVertex(const ::rl::math::Vector& q);
+			
+			::std::size_t getCapacity() const;
+			
+			/**
+			 * Number of calls dropped because the queue was full.
+			 */
+			::std::size_t getDropped() const;
+			
+			::std::size_t getEdgeStride() const;
+			
+			::std::size_t getVertexStride() const;
+			
+			Viewer* getViewer() const;
+			
+			/**
+			 * Forward queued calls to the wrapped viewer.
+			 *
+			 * Must not be called concurrently with itself or a running
+			 * consumer thread.
+			 *
+			 * @return Number of calls forwarded.
+			 */
+			::std::size_t process();
+			
+			void reset();
+			
+			void resetEdges();
+			
+			void resetLines();
+			
+			void resetPoints();
+			
+			void resetSpheres();
+			
+			void resetVertices();
+			
+			/**
+			 * Forward only every n-th configuration and work edge.
+			 */
+			void setEdgeStride(const ::std::size_t& edgeStride);
+			
+			/**
+			 * Forward only every n-th configuration and work vertex.
+			 */
+			void setVertexStride(const ::std::size_t& vertexStride);
+			
+			void showMessage(const ::std::string& message);
+			
+			/**
+			 * Start consumer thread calling process().
+			 */
+			void start();
+			
+			/**
+			 * Stop consumer thread after forwarding remaining calls.
+			 */
+			void stop();
+			
+		protected:
+			enum class Type
+			{
+				configuration,
+				configurationEdge,
+				configurationPath,
+				configurationVertex,
+				line,
+				message,
+				point,
+				resetEdges,
+				resetLines,
+				resetPoints,
+				resetSpheres,
+				resetVertices,
+				sphere,
+				work,
+				workEdge,
+				workPath,
+				workVertex
+			};
+			
+			struct Event
+			{
+				Event();
+				
+				bool free;
+				
+				::std::uint64_t generation;
+				
+				::std::string message;
+				
+				VectorList path;
+				
+				::rl::math::Vector q0;
+				
+				::rl::math::Vector q1;
+				
+				::rl::math::Real radius;
+				
+				::std::uint64_t sequence;
+				
+				/** Matrix of transform, dynamic to avoid alignment requirements. */
+				::rl::math::Matrix t;
+				
+				Type type;
+			};
+			
+			struct Cell
+			{
+				Event event;
+				
+				::std::atomic<::std::size_t> sequence;
+			};
+			
+			void dispatch(const Event& event);
+			
+			bool pop(Event& event);
+			
+			void push(Event& event);
+			
+			void run();
+			
+			::std::unique_ptr<Cell[]> cells;
+			
+			/** Sequence of latest coalesced call per type. */
+			::std::unique_ptr<::std::atomic<::std::uint64_t>[]> coalesced;
+			
+			::std::atomic<::std::size_t> dequeue;
+			
+			::std::atomic<::std::size_t> dropped;
+			
+			::std::atomic<::std::size_t> edges;
+			
+			::std::atomic<::std::size_t> edgeStride;
+			
+			::std::atomic<::std::size_t> enqueue;
+			
+			/** Incremented by reset(), calls of older generations are discarded. */
+			::std::atomic<::std::uint64_t> generation;
+			
+			::std::size_t mask;
+			
+			/** Generation last forwarded to the wrapped viewer. */
+			::std::uint64_t processed;
+			
+			::std::atomic<bool> running;
+			
+			::std::atomic<::std::uint64_t> sequence;
+			
+			::std::thread thread;
+			
+			::std::atomic<::std::size_t> vertexStride;
+			
+			::std::atomic<::std::size_t> vertices;
+			
+			Viewer* viewer;
+			
+		private:
+			
+		};
+	}
+}
+
+#endif // RL_PLAN_ASYNCVIEWER_H
@@ -50,6 +50,8 @@ namespace rl
 			
 			virtual ~BridgeSampler();
 			
+			using GaussianSampler::generateCollisionFree;
+			
 			::rl::math::Vector generateCollisionFree();
 			
 			::rl::math::Real getRatio() const;
@@ -0,0 +1,409 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ChompOptimizer.h"
+#include "DistanceModel.h"
+#include "Exception.h"
+#include "Verifier.h"
+#include "Viewer.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		ChompOptimizer::ChompOptimizer() :
+			Optimizer(),
+			clearance(static_cast<::rl::math::Real>(0.1)),
+			iterations(100),
+			length(static_cast<::rl::math::Real>(0.1)),
+			models(),
+			stepSize(static_cast<::rl::math::Real>(0.1)),
+			weight(10)
+		{
+		}
+		
+		ChompOptimizer::~ChompOptimizer()
+		{
+		}
+		
+		::rl::math::Real
+		ChompOptimizer::cost(DistanceModel* model, const ::rl::math::Vector& q, ::rl::math::Vector& gradient) const
+		{
+			model->setPosition(q);
+			model->updateFrames();
+			
+			gradient.setZero(q.size());
+			
+			::rl::math::Real cost = 0;
+			
+			::std::vector<::std::size_t> bodies;
+			::std::vector<::rl::math::Vector3> forces;
+			::std::vector<::rl::math::Vector3> points;
+			::std::vector<::rl::math::Vector3> positions;
+			
+			for (::std::size_t i = 0; i < model->getBodies(); ++i)
+			{
+				::rl::math::Vector3 point1;
+				::rl::math::Vector3 point2;
+				
+				::rl::math::Real distance = model->distance(i, point1, point2);
+				
+				if (distance >= this->clearance)
+				{
+					continue;
+				}
+				
+				if (distance > 0)
+				{
+					cost += (this->clearance - distance) * (this->clearance - distance) / (2 * this->clearance);
+					
+					bodies.push_back(i);
+					forces.push_back((distance - this->clearance) / this->clearance * (point1 - point2) / distance);
+					points.push_back(model->getFrame(i).inverse() * point1);
+					positions.push_back(point1);
+				}
+				else
+				{
+					// penetration without direction, no gradient available
+					cost += this->clearance / 2;
+				}
+			}
+			
+			if (!bodies.empty())
+			{
+				// Jacobian of witness points fixed to bodies via forward differences of body frames
+				
+				::rl::math::Real h = ::std::sqrt(::std::numeric_limits<::rl::math::Real>::epsilon());
+				::rl::math::Vector qh(q);
+				
+				for (::std::ptrdiff_t j = 0; j < q.size(); ++j)
+				{
+					qh(j) = q(j) + h;
+					model->setPosition(qh);
+					model->updateFrames(false);
+					
+					for (::std::size_t k = 0; k < bodies.size(); ++k)
+					{
+						gradient(j) += forces[k].dot(model->getFrame(bodies[k]) * points[k] - positions[k]) / h;
+					}
+					
+					qh(j) = q(j);
+				}
+			}
+			
+			return cost;
+		}
+		
+		::rl::math::Real
+		ChompOptimizer::cost(const ::rl::math::Matrix& x, ::rl::math::Matrix& gradient)
+		{
+			gradient.setZero(x.rows(), x.cols());
+			
+			::std::vector<::rl::math::Real> costs(x.cols(), 0);
+			
+			this->models.begin();
+			
+#ifdef _OPENMP
+			int threads = this->models.getThreads();
+			
+#pragma omp parallel num_threads(threads) if (threads > 1)
+#endif
+			{
+				DistanceModel* model = dynamic_cast<DistanceModel*>(this->models.getModel(this->getModel()));
+				
+				::rl::math::Vector g(x.rows());
+				::rl::math::Vector q(x.rows());
+				
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#if _OPENMP < 200805
+				for (::std::ptrdiff_t i = 1; i < x.cols() - 1; ++i)
+#else
+				for (::std::size_t i = 1; i < static_cast<::std::size_t>(x.cols()) - 1; ++i)
+#endif
+#else
+				for (::std::size_t i = 1; i < static_cast<::std::size_t>(x.cols()) - 1; ++i)
+#endif
+				{
+					q = x.col(i);
+					costs[i] = this->cost(model, q, g);
+					gradient.col(i) = g;
+				}
+			}
+			
+			this->models.end(this->getModel());
+			
+			::rl::math::Real cost = 0;
+			
+			for (::std::size_t i = 0; i < costs.size(); ++i)
+			{
+				cost += costs[i];
+			}
+			
+			return cost;
+		}
+		
+		::rl::math::Real
+		ChompOptimizer::getClearance() const
+		{
+			return this->clearance;
+		}
+		
+		::std::size_t
+		ChompOptimizer::getIterations() const
+		{
+			return this->iterations;
+		}
+		
+		::rl::math::Real
+		ChompOptimizer::getLength() const
+		{
+			return this->length;
+		}
+		
+		const ::std::vector<SimpleModel*>&
+		ChompOptimizer::getModels() const
+		{
+			return this->models.getModels();
+		}
+		
+		::rl::math::Real
+		ChompOptimizer::getStepSize() const
+		{
+			return this->stepSize;
+		}
+		
+		::rl::math::Real
+		ChompOptimizer::getWeight() const
+		{
+			return this->weight;
+		}
+		
+		bool
+		ChompOptimizer::isColliding(const ::rl::math::Matrix& x) const
+		{
+			::std::vector<::rl::math::Vector> q(x.cols());
+			
+			for (::std::size_t i = 0; i < q.size(); ++i)
+			{
+				q[i] = x.col(i);
+			}
+			
+			for (::std::size_t i = 1; i < q.size() - 1; ++i)
+			{
+				if (this->getModel()->isColliding(q[i]))
+				{
+					return true;
+				}
+			}
+			
+			if (nullptr == this->getVerifier())
+			{
+				return false;
+			}
+			
+			::std::vector<Verifier::Segment> segments;
+			segments.reserve(q.size() - 1);
+			
+			for (::std::size_t i = 1; i < q.size(); ++i)
+			{
+				segments.push_back(Verifier::Segment(&q[i - 1], &q[i], this->getModel()->distance(q[i - 1], q[i])));
+			}
+			
+			::std::vector<bool> colliding = this->getVerifier()->isColliding(segments);
+			
+			return colliding.end() != ::std::find(colliding.begin(), colliding.end(), true);
+		}
+		
+		void
+		ChompOptimizer::process(VectorList& path)
+		{
+			Path contiguous(path);
+			this->process(contiguous);
+			path = contiguous.toList();
+		}
+		
+		void
+		ChompOptimizer::process(Path& path)
+		{
+			if (nullptr == dynamic_cast<DistanceModel*>(this->getModel()))
+			{
+				throw Exception("rl::plan::ChompOptimizer::process() - Model does not support distance queries");
+			}
+			
+			this->subdivide(path, this->length);
+			
+			if (path.size() < 3)
+			{
+				return;
+			}
+			
+			::std::size_t n = path.size();
+			
+			::rl::math::Matrix x(path.getDof(), n);
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				x.col(i) = path[i];
+			}
+			
+			// Cholesky factorization of tridiagonal smoothness metric of interior waypoints
+			
+			::rl::math::Vector diagonal(n - 2);
+			::rl::math::Vector subdiagonal(n - 2);
+			
+			diagonal(0) = ::std::sqrt(static_cast<::rl::math::Real>(2));
+			
+			for (::std::size_t i = 1; i < n - 2; ++i)
+			{
+				subdiagonal(i - 1) = -1 / diagonal(i - 1);
+				diagonal(i) = ::std::sqrt(2 - subdiagonal(i - 1) * subdiagonal(i - 1));
+			}
+			
+			::rl::math::Matrix gradient;
+			::rl::math::Real total = this->smoothness(x) + this->weight * this->cost(x, gradient);
+			
+			::rl::math::Matrix candidate(x.rows(), n);
+			::rl::math::Matrix candidateGradient;
+			::rl::math::Matrix direction(x.rows(), n - 2);
+			::rl::math::Vector q(x.rows());
+			
+			::rl::math::Real step = this->stepSize;
+			
+			for (::std::size_t iteration = 0; iteration < this->iterations && step * 1024 > this->stepSize; ++iteration)
+			{
+				for (::std::size_t i = 1; i < n - 1; ++i)
+				{
+					direction.col(i - 1) = 2 * x.col(i) - x.col(i - 1) - x.col(i + 1) + this->weight * gradient.col(i);
+				}
+				
+				// solve with metric, forward and back substitution for all joints at once
+				
+				direction.col(0) /= diagonal(0);
+				
+				for (::std::size_t i = 1; i < n - 2; ++i)
+				{
+					direction.col(i) = (direction.col(i) - subdiagonal(i - 1) * direction.col(i - 1)) / diagonal(i);
+				}
+				
+				direction.col(n - 3) /= diagonal(n - 3);
+				
+				for (::std::size_t i = n - 3; i > 0; --i)
+				{
+					direction.col(i - 1) = (direction.col(i - 1) - subdiagonal(i - 1) * direction.col(i)) / diagonal(i - 1);
+				}
+				
+				candidate.col(0) = x.col(0);
+				candidate.col(n - 1) = x.col(n - 1);
+				
+				for (::std::size_t i = 1; i < n - 1; ++i)
+				{
+					q = x.col(i) - step * direction.col(i - 1);
+					this->getModel()->clamp(q);
+					candidate.col(i) = q;
+				}
+				
+				::rl::math::Real candidateTotal = this->smoothness(candidate) + this->weight * this->cost(candidate, candidateGradient);
+				
+				if (candidateTotal < total && !this->isColliding(candidate))
+				{
+					x.swap(candidate);
+					gradient.swap(candidateGradient);
+					total = candidateTotal;
+					
+					if (nullptr != this->getViewer())
+					{
+						VectorList list;
+						
+						for (::std::size_t i = 0; i < n; ++i)
+						{
+							list.push_back(x.col(i));
+						}
+						
+						this->getViewer()->drawConfigurationPath(list);
+					}
+				}
+				else
+				{
+					step /= 2;
+				}
+			}
+			
+			path.clear();
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				path.push_back(x.col(i));
+			}
+		}
+		
+		void
+		ChompOptimizer::setClearance(const ::rl::math::Real& clearance)
+		{
+			this->clearance = clearance;
+		}
+		
+		void
+		ChompOptimizer::setIterations(const ::std::size_t& iterations)
+		{
+			this->iterations = iterations;
+		}
+		
+		void
+		ChompOptimizer::setLength(const ::rl::math::Real& length)
+		{
+			this->length = length;
+		}
+		
+		void
+		ChompOptimizer::setModels(const ::std::vector<SimpleModel*>& models)
+		{
+			this->models.setModels(models);
+		}
+		
+		void
+		ChompOptimizer::setStepSize(const ::rl::math::Real& stepSize)
+		{
+			this->stepSize = stepSize;
+		}
+		
+		void
+		ChompOptimizer::setWeight(const ::rl::math::Real& weight)
+		{
+			this->weight = weight;
+		}
+		
+		::rl::math::Real
+		ChompOptimizer::smoothness(const ::rl::math::Matrix& x) const
+		{
+			return (x.rightCols(x.cols() - 1) - x.leftCols(x.cols() - 1)).squaredNorm() / 2;
+		}
+	}
+}
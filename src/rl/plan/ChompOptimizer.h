@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_CHOMPOPTIMIZER_H
+#define RL_PLAN_CHOMPOPTIMIZER_H
+
+#include <vector>
+#include <rl/math/Matrix.h>
+
+#include "Optimizer.h"
+#include "WorkerModels.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		class DistanceModel;
+		
+		/**
+		 * Covariant gradient descent on smoothness and obstacle cost.
+		 *
+		 * The path is subdivided to a maximum segment length and its interior
+		 * waypoints are moved along the negative gradient of the sum of squared
+		 * segment lengths and an obstacle cost. The obstacle cost of a body is
+		 * (epsilon - d)^2 / (2 epsilon) for a clearance d below epsilon, its
+		 * gradient is computed from the witness points of
+		 * DistanceModel::distance() and the Jacobian of the witness point on
+		 * the body. Each step is preconditioned with the inverse of the
+		 * tridiagonal smoothness metric, so obstacle gradients are spread over
+		 * neighboring waypoints. A step is accepted if it decreases the total
+		 * cost and the resulting path is verified collision-free, otherwise
+		 * the step size is halved.
+		 *
+		 * Matt Zucker, Nathan Ratliff, Anca D. Dragan, Mihail Pivtoraiko, Matthew
+		 * Klingensmith, Christopher M. Dellin, J. Andrew Bagnell, and Siddhartha
+		 * S. Srinivasa. CHOMP: Covariant Hamiltonian optimization for motion
+		 * planning. The International Journal of Robotics Research,
+		 * 32(9-10):1164-1193, August 2013.
+		 *
+		 * http://dx.doi.org/10.1177/0278364913488805
+		 *
+		 * @pre Model is a DistanceModel with a scene supporting distance queries.
+		 */
+		class RL_PLAN_EXPORT ChompOptimizer : public Optimizer
+		{
+		public:
+			ChompOptimizer();
+			
+			virtual ~ChompOptimizer();
+			
+			::rl::math::Real getClearance() const;
+			
+			::std::size_t getIterations() const;
+			
+			::rl::math::Real getLength() const;
+			
+			const ::std::vector<SimpleModel*>& getModels() const;
+			
+			::rl::math::Real getStepSize() const;
+			
+			::rl::math::Real getWeight() const;
+			
+			void process(VectorList& path);
+			
+			void process(Path& path);
+			
+			/**
+			 * Set distance below which obstacle cost is applied.
+			 */
+			void setClearance(const ::rl::math::Real& clearance);
+			
+			void setIterations(const ::std::size_t& iterations);
+			
+			/**
+			 * Set maximum segment length of subdivided path.
+			 */
+			void setLength(const ::rl::math::Real& length);
+			
+			/**
+			 * Set models used by worker threads for distance queries.
+			 *
+			 * Each model has to be a DistanceModel. If empty, waypoints are
+			 * evaluated with getModel() only. Queries of worker models are added
+			 * to the counters of getModel().
+			 */
+			void setModels(const ::std::vector<SimpleModel*>& models);
+			
+			/**
+			 * Set initial step size, 1 minimizes smoothness cost in one step.
+			 */
+			void setStepSize(const ::rl::math::Real& stepSize);
+			
+			/**
+			 * Set weight of obstacle cost relative to smoothness cost.
+			 */
+			void setWeight(const ::rl::math::Real& weight);
+			
+			::rl::math::Real clearance;
+			
+			::std::size_t iterations;
+			
+			::rl::math::Real length;
+			
+			/** Models for worker threads in distance queries. */
+			WorkerModels models;
+			
+			::rl::math::Real stepSize;
+			
+			::rl::math::Real weight;
+			
+		protected:
+			/**
+			 * Compute obstacle cost of a configuration and its gradient.
+			 */
+			::rl::math::Real cost(DistanceModel* model, const ::rl::math::Vector& q, ::rl::math::Vector& gradient) const;
+			
+			/**
+			 * Compute obstacle cost of interior waypoints and their gradients.
+			 */
+			::rl::math::Real cost(const ::rl::math::Matrix& x, ::rl::math::Matrix& gradient);
+			
+			/**
+			 * Check waypoints and segments between them for collisions.
+			 */
+			bool isColliding(const ::rl::math::Matrix& x) const;
+			
+			/**
+			 * Compute smoothness cost as half the sum of squared segment lengths.
+			 */
+			::rl::math::Real smoothness(const ::rl::math::Matrix& x) const;
+			
+		private:
+			
+		};
+	}
+}
+
+#endif // RL_PLAN_CHOMPOPTIMIZER_H
@@ -0,0 +1,85 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include "ConcurrentNearestNeighbors.h"
+#include "Model.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		ConcurrentNearestNeighbors::ConcurrentNearestNeighbors(Model* model, const ::std::size_t& bufferSize) :
+			NearestNeighbors(true),
+			container(JointMetric(model, true), bufferSize)
+		{
+		}
+		
+		ConcurrentNearestNeighbors::~ConcurrentNearestNeighbors()
+		{
+		}
+		
+		void
+		ConcurrentNearestNeighbors::clear()
+		{
+			this->container.clear();
+		}
+		
+		bool
+		ConcurrentNearestNeighbors::empty() const
+		{
+			return this->container.empty();
+		}
+		
+		::std::size_t
+		ConcurrentNearestNeighbors::getBufferSize() const
+		{
+			return this->container.getBufferSize();
+		}
+		
+		::std::vector<NearestNeighbors::Neighbor>
+		ConcurrentNearestNeighbors::nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted) const
+		{
+			return this->container.nearest(query, k, sorted);
+		}
+		
+		void
+		ConcurrentNearestNeighbors::push(const NearestNeighbors::Value& value)
+		{
+			this->container.push(value);
+		}
+		
+		::std::vector<NearestNeighbors::Neighbor>
+		ConcurrentNearestNeighbors::radius(const NearestNeighbors::Value& query, const Distance& radius, const bool& sorted) const
+		{
+			return this->container.radius(query, radius, sorted);
+		}
+		
+		::std::size_t
+		ConcurrentNearestNeighbors::size() const
+		{
+			return this->container.size();
+		}
+	}
+}
@@ -0,0 +1,482 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <rl/sg/Body.h>
+#include <rl/sg/DistanceScene.h>
+#include <rl/sg/Model.h>
+
+#include "DistanceField.h"
+#include "Exception.h"
+#include "Hash.h"
+#include "SimpleModel.h"
+#include "WorkerModels.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		struct DistanceField::Header
+		{
+			char magic[8];
+			
+			::std::uint32_t version;
+			
+			::std::uint32_t real;
+			
+			::std::uint64_t hash;
+			
+			::std::uint64_t size[3];
+			
+			::rl::math::Real min[3];
+			
+			::rl::math::Real max[3];
+			
+			::rl::math::Real resolution;
+		};
+		
+		static const char DISTANCEFIELD_MAGIC[8] = { 'R', 'L', 'S', 'D', 'F', '\0', '\0', '\0' };
+		
+		static const ::std::uint32_t DISTANCEFIELD_VERSION = 1;
+		
+		DistanceField::DistanceField() :
+			boundingBox(),
+			checksum(0),
+			resolution(static_cast<::rl::math::Real>(0.05)),
+			size(),
+			values()
+		{
+			this->size.fill(0);
+		}
+		
+		DistanceField::~DistanceField()
+		{
+		}
+		
+		void
+		DistanceField::build(const ::std::vector<SimpleModel*>& models)
+		{
+			if (models.empty())
+			{
+				throw Exception("rl::plan::DistanceField::build() - No models specified");
+			}
+			
+			for (::std::size_t i = 0; i < models.size(); ++i)
+			{
+				if (nullptr == dynamic_cast<::rl::sg::DistanceScene*>(models[i]->scene))
+				{
+					throw Exception("rl::plan::DistanceField::build() - Scene does not support distance queries");
+				}
+			}
+			
+			if (this->boundingBox.isEmpty())
+			{
+				throw Exception("rl::plan::DistanceField::build() - Bounding box is empty");
+			}
+			
+			this->resize();
+			this->checksum = DistanceField::hash(models.front());
+			
+			WorkerModels workers;
+			workers.setModels(models);
+			
+#ifdef _OPENMP
+			int threads = workers.getThreads();
+			
+#pragma omp parallel num_threads(threads) if (threads > 1)
+#endif
+			{
+				SimpleModel* model = workers.getModel(models.front());
+				::rl::sg::DistanceScene* scene = dynamic_cast<::rl::sg::DistanceScene*>(model->scene);
+				
+				::rl::math::Vector3 point;
+				::rl::math::Vector3 point1;
+				::rl::math::Vector3 point2;
+				
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, 64)
+#if _OPENMP < 200805
+				for (::std::ptrdiff_t i = 0; i < static_cast<::std::ptrdiff_t>(this->values.size()); ++i)
+#else
+				for (::std::size_t i = 0; i < this->values.size(); ++i)
+#endif
+#else
+				for (::std::size_t i = 0; i < this->values.size(); ++i)
+#endif
+				{
+					point.x() = this->boundingBox.min().x() + (i % this->size[0]) * this->resolution;
+					point.y() = this->boundingBox.min().y() + (i / this->size[0] % this->size[1]) * this->resolution;
+					point.z() = this->boundingBox.min().z() + (i / this->size[0] / this->size[1]) * this->resolution;
+					
+					::rl::math::Real distance = ::std::numeric_limits<::rl::math::Real>::max();
+					
+					for (::rl::sg::Scene::Iterator j = scene->begin(); j != scene->end(); ++j)
+					{
+						if (*j != model->model)
+						{
+							distance = ::std::min(distance, scene->distance(*j, point, point1, point2));
+						}
+					}
+					
+					this->values[i] = distance;
+				}
+			}
+			
+			// squared distance in grid units to nearest free grid point, larger than any distance inside grid
+			::rl::math::Real infinity = static_cast<::rl::math::Real>(this->size[0] * this->size[0] + this->size[1] * this->size[1] + this->size[2] * this->size[2]);
+			
+			::std::vector<::rl::math::Real> f(this->values.size());
+			
+			for (::std::size_t i = 0; i < this->values.size(); ++i)
+			{
+				f[i] = this->values[i] > 0 ? 0 : infinity;
+			}
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				::std::size_t stride = 0 == i ? 1 : 1 == i ? this->size[0] : this->size[0] * this->size[1];
+				::std::size_t lines = this->values.size() / this->size[i];
+				
+#ifdef _OPENMP
+#pragma omp parallel if (lines > 1)
+#endif
+				{
+					::std::vector<::rl::math::Real> d(this->size[i]);
+					::std::vector<::std::size_t> v(this->size[i]);
+					::std::vector<::rl::math::Real> z(this->size[i] + 1);
+					
+#ifdef _OPENMP
+#pragma omp for
+#if _OPENMP < 200805
+					for (::std::ptrdiff_t j = 0; j < static_cast<::std::ptrdiff_t>(lines); ++j)
+#else
+					for (::std::size_t j = 0; j < lines; ++j)
+#endif
+#else
+					for (::std::size_t j = 0; j < lines; ++j)
+#endif
+					{
+						// first grid point of line j, lines enumerate all points with zero coordinate i
+						::std::size_t first = j % stride + j / stride * stride * this->size[i];
+						this->transform(&f[first], this->size[i], stride, d, v, z);
+					}
+				}
+			}
+			
+			for (::std::size_t i = 0; i < this->values.size(); ++i)
+			{
+				if (this->values[i] <= 0)
+				{
+					this->values[i] = -::std::sqrt(f[i]) * this->resolution;
+				}
+			}
+		}
+		
+		bool
+		DistanceField::contains(const ::rl::math::Vector3& point) const
+		{
+			return !this->values.empty() && this->boundingBox.contains(point);
+		}
+		
+		::rl::math::Real
+		DistanceField::distance(const ::rl::math::Vector3& point) const
+		{
+			::rl::math::Vector3 gradient;
+			return this->distance(point, gradient);
+		}
+		
+		::rl::math::Real
+		DistanceField::distance(const ::rl::math::Vector3& point, ::rl::math::Vector3& gradient) const
+		{
+			assert(!this->values.empty());
+			
+			::std::array<::std::size_t, 3> i;
+			::rl::math::Vector3 t;
+			
+			for (::std::size_t k = 0; k < 3; ++k)
+			{
+				::rl::math::Real u = (point(k) - this->boundingBox.min()(k)) / this->resolution;
+				::rl::math::Real cell = ::std::max(static_cast<::rl::math::Real>(0), ::std::min(::std::floor(u), static_cast<::rl::math::Real>(this->size[k] - 2)));
+				i[k] = static_cast<::std::size_t>(cell);
+				t(k) = ::std::max(static_cast<::rl::math::Real>(0), ::std::min(u - cell, static_cast<::rl::math::Real>(1)));
+			}
+			
+			::rl::math::Real c000 = this->values[this->index(i[0], i[1], i[2])];
+			::rl::math::Real c100 = this->values[this->index(i[0] + 1, i[1], i[2])];
+			::rl::math::Real c010 = this->values[this->index(i[0], i[1] + 1, i[2])];
+			::rl::math::Real c110 = this->values[this->index(i[0] + 1, i[1] + 1, i[2])];
+			::rl::math::Real c001 = this->values[this->index(i[0], i[1], i[2] + 1)];
+			::rl::math::Real c101 = this->values[this->index(i[0] + 1, i[1], i[2] + 1)];
+			::rl::math::Real c011 = this->values[this->index(i[0], i[1] + 1, i[2] + 1)];
+			::rl::math::Real c111 = this->values[this->index(i[0] + 1, i[1] + 1, i[2] + 1)];
+			
+			::rl::math::Real c00 = c000 + t.x() * (c100 - c000);
+			::rl::math::Real c10 = c010 + t.x() * (c110 - c010);
+			::rl::math::Real c01 = c001 + t.x() * (c101 - c001);
+			::rl::math::Real c11 = c011 + t.x() * (c111 - c011);
+			
+			::rl::math::Real c0 = c00 + t.y() * (c10 - c00);
+			::rl::math::Real c1 = c01 + t.y() * (c11 - c01);
+			
+			gradient.x() = (
+				(1 - t.y()) * (1 - t.z()) * (c100 - c000) +
+				t.y() * (1 - t.z()) * (c110 - c010) +
+				(1 - t.y()) * t.z() * (c101 - c001) +
+				t.y() * t.z() * (c111 - c011)
+			) / this->resolution;
+			gradient.y() = ((1 - t.z()) * (c10 - c00) + t.z() * (c11 - c01)) / this->resolution;
+			gradient.z() = (c1 - c0) / this->resolution;
+			
+			return c0 + t.z() * (c1 - c0);
+		}
+		
+		bool
+		DistanceField::empty() const
+		{
+			return this->values.empty();
+		}
+		
+		const ::rl::math::AlignedBox3&
+		DistanceField::getBoundingBox() const
+		{
+			return this->boundingBox;
+		}
+		
+		::rl::math::Real
+		DistanceField::getError() const
+		{
+			return this->resolution * ::std::sqrt(static_cast<::rl::math::Real>(3)) / 2;
+		}
+		
+		::rl::math::Real
+		DistanceField::getResolution() const
+		{
+			return this->resolution;
+		}
+		
+		::std::uint64_t
+		DistanceField::hash(const SimpleModel* model)
+		{
+			Hash hash;
+			
+			for (::std::size_t i = 0; i < model->scene->getNumModels(); ++i)
+			{
+				::rl::sg::Model* sceneModel = model->scene->getModel(i);
+				
+				// robot is not part of distance field
+				if (sceneModel == model->model)
+				{
+					continue;
+				}
+				
+				::std::uint64_t bodies = sceneModel->getNumBodies();
+				hash.combine(&bodies, sizeof(bodies));
+				
+				for (::std::size_t j = 0; j < sceneModel->getNumBodies(); ++j)
+				{
+					hash.combine(sceneModel->getBody(j)->getFrame());
+					hash.combine(sceneModel->getBody(j));
+				}
+			}
+			
+			return hash.get();
+		}
+		
+		::std::size_t
+		DistanceField::index(const ::std::size_t& x, const ::std::size_t& y, const ::std::size_t& z) const
+		{
+			return x + this->size[0] * (y + this->size[1] * z);
+		}
+		
+		void
+		DistanceField::load(const ::std::string& filename, const SimpleModel* model)
+		{
+			::std::ifstream file(filename.c_str(), ::std::ios::binary);
+			
+			if (!file)
+			{
+				throw Exception("rl::plan::DistanceField::load() - Failed to open file '" + filename + "'");
+			}
+			
+			Header header;
+			
+			if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || 0 != ::std::memcmp(header.magic, DISTANCEFIELD_MAGIC, sizeof(header.magic)))
+			{
+				throw Exception("rl::plan::DistanceField::load() - File '" + filename + "' is not a distance field");
+			}
+			
+			if (DISTANCEFIELD_VERSION != header.version)
+			{
+				throw Exception("rl::plan::DistanceField::load() - Unsupported distance field version in file '" + filename + "'");
+			}
+			
+			if (
+				sizeof(::rl::math::Real) != header.real ||
+				this->resolution != header.resolution ||
+				this->boundingBox.min() != ::rl::math::Vector3(header.min[0], header.min[1], header.min[2]) ||
+				this->boundingBox.max() != ::rl::math::Vector3(header.max[0], header.max[1], header.max[2]) ||
+				DistanceField::hash(model) != header.hash
+			)
+			{
+				throw Exception("rl::plan::DistanceField::load() - Distance field in file '" + filename + "' does not match bounding box, resolution, and scene");
+			}
+			
+			this->resize();
+			
+			if (this->size[0] != header.size[0] || this->size[1] != header.size[1] || this->size[2] != header.size[2])
+			{
+				this->values.clear();
+				throw Exception("rl::plan::DistanceField::load() - Distance field in file '" + filename + "' is corrupt");
+			}
+			
+			if (!file.read(reinterpret_cast<char*>(this->values.data()), this->values.size() * sizeof(::rl::math::Real)))
+			{
+				this->values.clear();
+				throw Exception("rl::plan::DistanceField::load() - Distance field in file '" + filename + "' is truncated");
+			}
+			
+			this->checksum = header.hash;
+		}
+		
+		void
+		DistanceField::resize()
+		{
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				this->size[i] = ::std::max(
+					static_cast<::std::size_t>(2),
+					static_cast<::std::size_t>(::std::ceil(this->boundingBox.sizes()(i) / this->resolution)) + 1
+				);
+			}
+			
+			this->values.assign(this->size[0] * this->size[1] * this->size[2], 0);
+		}
+		
+		void
+		DistanceField::save(const ::std::string& filename) const
+		{
+			if (this->values.empty())
+			{
+				throw Exception("rl::plan::DistanceField::save() - Distance field is empty");
+			}
+			
+			::std::ofstream file(filename.c_str(), ::std::ios::binary);
+			
+			if (!file)
+			{
+				throw Exception("rl::plan::DistanceField::save() - Failed to open file '" + filename + "'");
+			}
+			
+			Header header;
+			::std::memset(&header, 0, sizeof(header));
+			::std::memcpy(header.magic, DISTANCEFIELD_MAGIC, sizeof(header.magic));
+			header.version = DISTANCEFIELD_VERSION;
+			header.real = sizeof(::rl::math::Real);
+			header.hash = this->checksum;
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				header.size[i] = this->size[i];
+				header.min[i] = this->boundingBox.min()(i);
+				header.max[i] = this->boundingBox.max()(i);
+			}
+			
+			header.resolution = this->resolution;
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(this->values.data()), this->values.size() * sizeof(::rl::math::Real));
+			
+			if (!file)
+			{
+				throw Exception("rl::plan::DistanceField::save() - Failed to write file '" + filename + "'");
+			}
+		}
+		
+		void
+		DistanceField::setBoundingBox(const ::rl::math::AlignedBox3& boundingBox)
+		{
+			this->boundingBox = boundingBox;
+			this->values.clear();
+		}
+		
+		void
+		DistanceField::setResolution(const ::rl::math::Real& resolution)
+		{
+			this->resolution = resolution;
+			this->values.clear();
+		}
+		
+		void
+		DistanceField::transform(::rl::math::Real* f, const ::std::size_t& n, const ::std::size_t& stride, ::std::vector<::rl::math::Real>& d, ::std::vector<::std::size_t>& v, ::std::vector<::rl::math::Real>& z) const
+		{
+			// lower envelope of parabolas rooted at (q, f(q))
+			::std::size_t k = 0;
+			v[0] = 0;
+			z[0] = -::std::numeric_limits<::rl::math::Real>::infinity();
+			z[1] = ::std::numeric_limits<::rl::math::Real>::infinity();
+			
+			for (::std::size_t q = 1; q < n; ++q)
+			{
+				::rl::math::Real p = static_cast<::rl::math::Real>(v[k]);
+				::rl::math::Real s = ((f[q * stride] + q * q) - (f[v[k] * stride] + p * p)) / (2 * (q - p));
+				
+				while (s <= z[k])
+				{
+					--k;
+					p = static_cast<::rl::math::Real>(v[k]);
+					s = ((f[q * stride] + q * q) - (f[v[k] * stride] + p * p)) / (2 * (q - p));
+				}
+				
+				++k;
+				v[k] = q;
+				z[k] = s;
+				z[k + 1] = ::std::numeric_limits<::rl::math::Real>::infinity();
+			}
+			
+			k = 0;
+			
+			for (::std::size_t q = 0; q < n; ++q)
+			{
+				while (z[k + 1] < q)
+				{
+					++k;
+				}
+				
+				::rl::math::Real p = static_cast<::rl::math::Real>(v[k]);
+				d[q] = (q - p) * (q - p) + f[v[k] * stride];
+			}
+			
+			for (::std::size_t q = 0; q < n; ++q)
+			{
+				f[q * stride] = d[q];
+			}
+		}
+	}
+}
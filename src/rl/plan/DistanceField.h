@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_DISTANCEFIELD_H
+#define RL_PLAN_DISTANCEFIELD_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <rl/math/AlignedBox.h>
+#include <rl/math/Vector.h>
+#include <rl/plan/export.h>
+
+namespace rl
+{
+	namespace plan
+	{
+		class SimpleModel;
+		
+		/**
+		 * Signed distance field of the static obstacles in a scene.
+		 *
+		 * Distances are sampled on a regular grid over a bounding box with
+		 * exact point queries of the scene, excluding the robot model. Grid
+		 * points inside obstacles store the negative distance to the nearest
+		 * free grid point, computed with a separable Euclidean distance
+		 * transform. Queries interpolate trilinearly between grid points.
+		 *
+		 * Pedro F. Felzenszwalb and Daniel P. Huttenlocher. Distance transforms
+		 * of sampled functions. Theory of Computing, 8(19):415-428, September
+		 * 2012.
+		 *
+		 * http://dx.doi.org/10.4086/toc.2012.v008a019
+		 */
+		class RL_PLAN_EXPORT DistanceField
+		{
+		public:
+			DistanceField();
+			
+			virtual ~DistanceField();
+			
+			/**
+			 * Sample distances of all grid points.
+			 *
+			 * Models are used by worker threads as in WorkerModels, their scenes
+			 * have to support distance queries. The scene must not change
+			 * afterwards.
+			 */
+			void build(const ::std::vector<SimpleModel*>& models);
+			
+			bool contains(const ::rl::math::Vector3& point) const;
+			
+			::rl::math::Real distance(const ::rl::math::Vector3& point) const;
+			
+			::rl::math::Real distance(const ::rl::math::Vector3& point, ::rl::math::Vector3& gradient) const;
+			
+			bool empty() const;
+			
+			const ::rl::math::AlignedBox3& getBoundingBox() const;
+			
+			/**
+			 * Maximum error of the distance by interpolation outside of obstacles.
+			 *
+			 * Half of the diagonal of a grid cell. Distances to convex obstacles
+			 * are only overestimated.
+			 */
+			::rl::math::Real getError() const;
+			
+			::rl::math::Real getResolution() const;
+			
+			/**
+			 * Load grid from file.
+			 *
+			 * Fails if bounding box, resolution, or static obstacles of the scene
+			 * differ from the ones the file was built with. Obstacles are compared
+			 * by frames, names, bounding boxes, points, and shape transforms of
+			 * their bodies. Geometry of shapes is only covered via bounding boxes
+			 * and points of bodies, i.e., if loaded with these enabled.
+			 */
+			void load(const ::std::string& filename, const SimpleModel* model);
+			
+			void save(const ::std::string& filename) const;
+			
+			void setBoundingBox(const ::rl::math::AlignedBox3& boundingBox);
+			
+			void setResolution(const ::rl::math::Real& resolution);
+			
+		protected:
+			
+		private:
+			struct Header;
+			
+			static ::std::uint64_t hash(const SimpleModel* model);
+			
+			::std::size_t index(const ::std::size_t& x, const ::std::size_t& y, const ::std::size_t& z) const;
+			
+			void resize();
+			
+			void transform(::rl::math::Real* f, const ::std::size_t& n, const ::std::size_t& stride, ::std::vector<::rl::math::Real>& d, ::std::vector<::std::size_t>& v, ::std::vector<::rl::math::Real>& z) const;
+			
+			::rl::math::AlignedBox3 boundingBox;
+			
+			::std::uint64_t checksum;
+			
+			::rl::math::Real resolution;
+			
+			::std::array<::std::size_t, 3> size;
+			
+			::std::vector<::rl::math::Real> values;
+		};
+	}
+}
+
+#endif // RL_PLAN_DISTANCEFIELD_H
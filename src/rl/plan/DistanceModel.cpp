@@ -27,6 +27,7 @@
 #include <rl/sg/Body.h>
 #include <rl/sg/DistanceScene.h>
 
+#include "DistanceField.h"
 #include "DistanceModel.h"
 
 namespace rl
@@ -34,7 +35,8 @@ namespace rl
 	namespace plan
 	{
 		DistanceModel::DistanceModel() :
-			SimpleModel()
+			SimpleModel(),
+			field(nullptr)
 		{
 		}
 		
@@ -45,6 +47,16 @@ namespace rl
 		::rl::math::Real
 		DistanceModel::distance(const ::rl::math::Vector3& point)
 		{
+			if (nullptr != this->field && this->field->contains(point))
+			{
+				::rl::math::Real distance = this->field->distance(point) - this->field->getError();
+				
+				if (distance > this->field->getError())
+				{
+					return distance;
+				}
+			}
+			
 			::rl::math::Real distance = ::std::numeric_limits<::rl::math::Real>::max();
 			::rl::math::Vector3 point1;
 			::rl::math::Vector3 point2;
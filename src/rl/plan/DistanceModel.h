@@ -37,6 +37,8 @@ namespace rl
 {
 	namespace plan
 	{
+		class DistanceField;
+		
 		class RL_PLAN_EXPORT DistanceModel : public SimpleModel
 		{
 		public:
@@ -46,12 +48,22 @@ namespace rl
 			
 			using SimpleModel::distance;
 			
+			/**
+			 * Distance of point to closest obstacle.
+			 *
+			 * Points within the distance field are answered by interpolation,
+			 * reduced by its maximum error. Exact queries are used outside the
+			 * field and within one grid cell diagonal of an obstacle.
+			 */
 			virtual ::rl::math::Real distance(const ::rl::math::Vector3& point);
 			
 			virtual ::rl::math::Real distance(const ::std::size_t& body, ::rl::math::Vector3& point1, ::rl::math::Vector3& point2);
 			
 			virtual void distance(const ::std::size_t& body, RealList& distances, Vector3List& points1, Vector3List& points2);
 			
+			/** Optional distance field of static obstacles for point queries. */
+			DistanceField* field;
+			
 		protected:
 			
 		private:
@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <queue>
+#include <rl/sg/Body.h>
+#include <rl/sg/DistanceScene.h>
+
+#include "DistanceModel.h"
+#include "DistanceVerifier.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		DistanceVerifier::DistanceVerifier() :
+			Verifier(),
+			radii(),
+			certifiedSteps(0)
+		{
+		}
+		
+		DistanceVerifier::~DistanceVerifier()
+		{
+		}
+		
+		void
+		DistanceVerifier::clearance(DistanceModel* model, ::rl::math::Real& environment, ::rl::math::Real& self) const
+		{
+			::rl::sg::DistanceScene* scene = dynamic_cast<::rl::sg::DistanceScene*>(model->scene);
+			
+			environment = ::std::numeric_limits<::rl::math::Real>::max();
+			self = ::std::numeric_limits<::rl::math::Real>::max();
+			
+			::rl::math::Vector3 point1;
+			::rl::math::Vector3 point2;
+			
+			for (::std::size_t i = 0; i < model->model->getNumBodies(); ++i)
+			{
+				if (model->isColliding(i))
+				{
+					for (::rl::sg::Scene::Iterator j = model->scene->begin(); j != model->scene->end(); ++j)
+					{
+						if (model->model != *j)
+						{
+							for (::rl::sg::Model::Iterator k = (*j)->begin(); k != (*j)->end(); ++k)
+							{
+								environment = ::std::min(environment, scene->distance(model->model->getBody(i), *k, point1, point2));
+							}
+						}
+					}
+				}
+				
+				for (::std::size_t j = 0; j < i; ++j)
+				{
+					if (model->areColliding(i, j))
+					{
+						self = ::std::min(self, scene->distance(model->model->getBody(i), model->model->getBody(j), point1, point2));
+					}
+				}
+			}
+		}
+		
+		::std::size_t
+		DistanceVerifier::getCertifiedSteps() const
+		{
+			return this->certifiedSteps;
+		}
+		
+		const ::rl::math::Vector&
+		DistanceVerifier::getRadii() const
+		{
+			return this->radii;
+		}
+		
+		bool
+		DistanceVerifier::isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d)
+		{
+			assert(u.size() == this->getModel()->getDofPosition());
+			assert(v.size() == this->getModel()->getDofPosition());
+			assert(this->radii.size() == u.size());
+			
+			DistanceModel* model = dynamic_cast<DistanceModel*>(this->getModel());
+			assert(nullptr != model);
+			
+			::std::size_t steps = this->getSteps(d);
+			
+			if (steps < 2)
+			{
+				return false;
+			}
+			
+			// upper bound on displacement of any point of the robot per step
+			::rl::math::Real displacement = this->radii.dot((v - u).cwiseAbs()) / static_cast<::rl::math::Real>(steps);
+			
+			struct Segment
+			{
+				::std::size_t first;
+				
+				::std::size_t second;
+				
+				::rl::math::Real environment1;
+				
+				::rl::math::Real environment2;
+				
+				::rl::math::Real self1;
+				
+				::rl::math::Real self2;
+			};
+			
+			Segment segment;
+			segment.first = 0;
+			segment.second = steps;
+			
+			model->setPosition(u);
+			model->updateFrames();
+			this->clearance(model, segment.environment1, segment.self1);
+			
+			model->setPosition(v);
+			model->updateFrames();
+			this->clearance(model, segment.environment2, segment.self2);
+			
+			::std::queue<Segment> queue;
+			queue.push(segment);
+			
+			::rl::math::Vector inter(u.size());
+			
+			while (!queue.empty())
+			{
+				segment = queue.front();
+				queue.pop();
+				
+				if (segment.second - segment.first < 2)
+				{
+					continue;
+				}
+				
+				::rl::math::Real bound = displacement * static_cast<::rl::math::Real>(segment.second - segment.first);
+				
+				if (bound < segment.environment1 + segment.environment2 && 2 * bound < segment.self1 + segment.self2)
+				{
+					this->certifiedSteps += segment.second - segment.first - 1;
+					continue;
+				}
+				
+				::std::size_t midpoint = (segment.first + segment.second) / 2;
+				
+				model->interpolate(u, v, static_cast<::rl::math::Real>(midpoint) / static_cast<::rl::math::Real>(steps), inter);
+				
+				if (model->isColliding(inter))
+				{
+					return true;
+				}
+				
+				::rl::math::Real environment;
+				::rl::math::Real self;
+				this->clearance(model, environment, self);
+				
+				Segment lower = segment;
+				lower.second = midpoint;
+				lower.environment2 = environment;
+				lower.self2 = self;
+				queue.push(lower);
+				
+				Segment upper = segment;
+				upper.first = midpoint;
+				upper.environment1 = environment;
+				upper.self1 = self;
+				queue.push(upper);
+			}
+			
+			return false;
+		}
+		
+		::std::vector<bool>
+		DistanceVerifier::isColliding(const ::std::vector<Segment>& segments)
+		{
+			::std::vector<bool> colliding(segments.size(), false);
+			
+			for (::std::size_t i = 0; i < segments.size(); ++i)
+			{
+				colliding[i] = this->isColliding(*segments[i].u, *segments[i].v, segments[i].d);
+			}
+			
+			return colliding;
+		}
+		
+		void
+		DistanceVerifier::reset()
+		{
+			this->certifiedSteps = 0;
+		}
+		
+		void
+		DistanceVerifier::setRadii(const ::rl::math::Vector& radii)
+		{
+			this->radii = radii;
+		}
+	}
+}
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_DISTANCEVERIFIER_H
+#define RL_PLAN_DISTANCEVERIFIER_H
+
+#include "Verifier.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		class DistanceModel;
+		
+		/**
+		 * Verifier certifying free segments via clearance.
+		 *
+		 * Intermediate states are checked in the same recursive order as in
+		 * RecursiveVerifier, but a sub-segment is accepted without further
+		 * collision queries if the clearance at its end points exceeds an upper
+		 * bound on the displacement of any point of the robot along it.
+		 *
+		 * The displacement bound is the sum of the joint position differences
+		 * weighted by the corresponding radii, i.e., the maximum distance of any
+		 * point of the bodies moved by a joint to its axis (1 for prismatic
+		 * joints). Self-collision pairs are certified with twice the bound, as
+		 * both bodies may move towards each other.
+		 *
+		 * Fabian Schwarzer, Mitul Saha, and Jean-Claude Latombe. Exact collision
+		 * checking of robot paths. In Algorithmic Foundations of Robotics V,
+		 * pages 25-41, Springer, 2004.
+		 *
+		 * http://dx.doi.org/10.1007/978-3-540-45058-0_3
+		 *
+		 * @pre Model is a DistanceModel with a scene supporting distance queries.
+		 */
+		class RL_PLAN_EXPORT DistanceVerifier : public Verifier
+		{
+		public:
+			DistanceVerifier();
+			
+			virtual ~DistanceVerifier();
+			
+			/**
+			 * Number of intermediate states accepted via clearance since the
+			 * last reset().
+			 */
+			::std::size_t getCertifiedSteps() const;
+			
+			const ::rl::math::Vector& getRadii() const;
+			
+			using Verifier::isColliding;
+			
+			bool isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d);
+			
+			/**
+			 * Verify multiple segments one after another.
+			 *
+			 * Certification reuses the clearance at the end points of each
+			 * sub-segment, so segments are not interleaved as in the base class.
+			 */
+			::std::vector<bool> isColliding(const ::std::vector<Segment>& segments);
+			
+			/**
+			 * Reset counter of certified states.
+			 */
+			void reset();
+			
+			void setRadii(const ::rl::math::Vector& radii);
+			
+		protected:
+			/**
+			 * Compute clearance to environment and to other bodies of the robot
+			 * in current configuration.
+			 */
+			void clearance(DistanceModel* model, ::rl::math::Real& environment, ::rl::math::Real& self) const;
+			
+			/** Maximum distance to joint axis of all bodies moved by each joint. */
+			::rl::math::Vector radii;
+			
+		private:
+			::std::size_t certifiedSteps;
+		};
+	}
+}
+
+#endif // RL_PLAN_DISTANCEVERIFIER_H
@@ -31,6 +31,7 @@
 #include "DistanceModel.h"
 #include "Eet.h"
 #include "Exception.h"
+#include "Profiler.h"
 #include "Sampler.h"
 #include "SimpleModel.h"
 #include "Viewer.h"
@@ -79,10 +80,14 @@ namespace rl
 		Rrt::Edge
 		Eet::addEdge(const Vertex& u, const Vertex& v, Tree& tree)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::insertion);
+			
 			Edge e = ::boost::add_edge(u, v, tree).first;
 			
 			if (nullptr != this->getViewer())
 			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
 				this->getViewer()->drawConfigurationEdge(*get(tree, u)->q, *get(tree, v)->q);
 			}
 			
@@ -104,6 +109,8 @@ namespace rl
 		Eet::Vertex
 		Eet::addVertex(Tree& tree, const VectorPtr& q)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::insertion);
+			
 			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
 			bundle->index = ::boost::num_vertices(tree) - 1;
 			bundle->q = q;
@@ -113,6 +120,8 @@ namespace rl
 			
 			if (nullptr != this->getViewer())
 			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
 				this->getViewer()->drawConfigurationVertex(*get(tree, v)->q);
 			}
 			
@@ -143,12 +152,16 @@ namespace rl
 			do
 			{
 				VertexBundle best;
-				best.q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
+				best.q = this->pool.allocate(this->getModel()->getDofPosition());
 				best.t = ::std::make_shared<::rl::math::Transform>();
 				
 				state = this->expand(get(tree, n), *get(tree, nearest.second)->t, chosen, distance, best); // TODO
 				
-				if (state >= 0)
+				if (state < 0)
+				{
+					this->pool.deallocate(best.q);
+				}
+				else
 				{
 					connected = this->addVertex(tree, best.q);
 					get(tree, connected)->t = best.t;
@@ -238,6 +251,8 @@ namespace rl
 			
 			if (nullptr != this->getViewer())
 			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
 				this->getViewer()->drawConfiguration(*expanded.q);
 			}
 			
@@ -259,7 +274,7 @@ namespace rl
 			Vertex extended = nullptr;
 			
 			VertexBundle best;
-			best.q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
+			best.q = this->pool.allocate(this->getModel()->getDofPosition());
 			best.t = ::std::make_shared<::rl::math::Transform>();
 			
 			if (this->expand(get(tree, nearest.second), *get(tree, nearest.second)->t, chosen, distance, best) >= 0)
@@ -268,6 +283,10 @@ namespace rl
 				get(tree, extended)->t = best.t;
 				this->addEdge(nearest.second, extended, tree);
 			}
+			else
+			{
+				this->pool.deallocate(best.q);
+			}
 			
 			return extended;
 		}
@@ -383,6 +402,8 @@ namespace rl
 		Rrt::Neighbor
 		Eet::nearest(const Tree& tree, const ::rl::math::Transform& chosen)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::nearestNeighbors);
+			
 			::std::vector<::rl::math::GnatNearestNeighbors<WorkspaceMetric>::Neighbor> neighbors = this->nn.nearest(WorkspaceMetric::Value(&chosen, Vertex()), 1);
 			return Neighbor(neighbors.front().first, neighbors.front().second.second);
 		}
@@ -488,7 +509,7 @@ namespace rl
 				throw("::rl::plan::Eet::solve() - branched kinematics not supported");
 			}
 			
-			this->time = ::std::chrono::steady_clock::now();
+			this->initialize();
 			
 			this->explorationTimeStart = ::std::chrono::steady_clock::now();
 			
@@ -546,7 +567,7 @@ namespace rl
 			
 			// tree initialization with start configuration
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
+			this->begin[0] = this->addVertex(this->tree[0], this->pool.allocate(*this->getStart()));
 			this->getModel()->setPosition(*this->getStart());
 			this->getModel()->updateFrames();
 			get(this->tree[0], this->begin[0])->t = ::std::make_shared<::rl::math::Transform>(this->getModel()->forwardPosition());
@@ -562,7 +583,7 @@ namespace rl
 			WorkspaceSphereVector::iterator i = ++path.begin();
 			::rl::math::Real sigma = gamma; // initialize exploration/exploitation balance
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration()) // search until goal reached
+			while (this->proceed()) // search until goal reached
 			{
 				if (sigma < 1) // sample is within current sphere
 				{
@@ -607,6 +628,8 @@ namespace rl
 					
 					if (nullptr != this->getViewer())
 					{
+						Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+						
 						this->getViewer()->drawWork(chosen);
 					}
 					
@@ -84,6 +84,20 @@ namespace rl
 			}
 		}
 		
+		::std::vector<::rl::math::Vector>
+		GaussianSampler::generateCollisionFree(const ::std::size_t& n)
+		{
+			::std::vector<::rl::math::Vector> samples;
+			samples.reserve(n);
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				samples.push_back(this->generateCollisionFree());
+			}
+			
+			return samples;
+		}
+		
 		::rl::math::Vector*
 		GaussianSampler::getSigma() const
 		{
@@ -52,6 +52,11 @@ namespace rl
 			
 			::rl::math::Vector generateCollisionFree();
 			
+			/**
+			 * Generate multiple collision-free samples sequentially.
+			 */
+			::std::vector<::rl::math::Vector> generateCollisionFree(const ::std::size_t& n);
+			
 			::rl::math::Vector* getSigma() const;
 			
 			virtual void seed(const ::std::mt19937::result_type& value);
@@ -33,7 +33,7 @@ namespace rl
 	{
 		GnatNearestNeighbors::GnatNearestNeighbors(Model* model) :
 			NearestNeighbors(false),
-			container(Metric(model, false))
+			container(JointMetric(model, false))
 		{
 		}
 		
@@ -83,6 +83,12 @@ namespace rl
 			return this->container.getNodeDegreeMin();
 		}
 		
+		void
+		GnatNearestNeighbors::insert(const ::std::vector<NearestNeighbors::Value>& values)
+		{
+			this->container.insert(values.begin(), values.end());
+		}
+		
 		::std::vector<NearestNeighbors::Neighbor>
 		GnatNearestNeighbors::nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted) const
 		{
@@ -29,6 +29,7 @@
 
 #include <rl/math/GnatNearestNeighbors.h>
 
+#include "JointMetric.h"
 #include "NearestNeighbors.h"
 
 namespace rl
@@ -58,6 +59,8 @@ namespace rl
 			
 			::std::size_t getNodeDegreeMin() const;
 			
+			void insert(const ::std::vector<NearestNeighbors::Value>& values);
+			
 			::std::vector<NearestNeighbors::Neighbor> nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted = true) const;
 			
 			void push(const NearestNeighbors::Value& value);
@@ -81,7 +84,7 @@ namespace rl
 		protected:
 			
 		private:
-			::rl::math::GnatNearestNeighbors<Metric> container;
+			::rl::math::GnatNearestNeighbors<JointMetric> container;
 		};
 	}
 }
@@ -0,0 +1,138 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <numeric>
+
+#include "HaltonSampler.h"
+#include "SimpleModel.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		HaltonSampler::HaltonSampler() :
+			UniformSampler(),
+			scrambled(true),
+			bases(),
+			index(1),
+			permutations()
+		{
+		}
+		
+		HaltonSampler::~HaltonSampler()
+		{
+		}
+		
+		::rl::math::Vector
+		HaltonSampler::generate()
+		{
+			if (this->bases.size() != this->getModel()->getDof())
+			{
+				this->initialize(this->getModel()->getDof());
+			}
+			
+			::rl::math::Vector rand(this->getModel()->getDof());
+			
+			for (::std::size_t i = 0; i < this->getModel()->getDof(); ++i)
+			{
+				::rl::math::Real inverse = 1 / static_cast<::rl::math::Real>(this->bases[i]);
+				::rl::math::Real factor = inverse;
+				rand(i) = 0;
+				
+				for (::std::size_t n = this->index; n > 0; n /= this->bases[i])
+				{
+					rand(i) += factor * this->permutations[i][n % this->bases[i]];
+					factor *= inverse;
+				}
+			}
+			
+			++this->index;
+			
+			return this->getModel()->generatePositionUniform(rand);
+		}
+		
+		bool
+		HaltonSampler::getScrambled() const
+		{
+			return this->scrambled;
+		}
+		
+		void
+		HaltonSampler::initialize(const ::std::size_t& dimensions)
+		{
+			this->bases.clear();
+			this->permutations.resize(dimensions);
+			
+			for (::std::size_t candidate = 2; this->bases.size() < dimensions; ++candidate)
+			{
+				bool prime = true;
+				
+				for (::std::size_t i = 0; i < this->bases.size() && this->bases[i] * this->bases[i] <= candidate; ++i)
+				{
+					if (0 == candidate % this->bases[i])
+					{
+						prime = false;
+						break;
+					}
+				}
+				
+				if (prime)
+				{
+					this->bases.push_back(candidate);
+				}
+			}
+			
+			for (::std::size_t i = 0; i < dimensions; ++i)
+			{
+				this->permutations[i].resize(this->bases[i]);
+				::std::iota(this->permutations[i].begin(), this->permutations[i].end(), 0);
+				
+				if (this->scrambled)
+				{
+					// keep zero digit fixed so that trailing zeros do not contribute
+					::std::shuffle(this->permutations[i].begin() + 1, this->permutations[i].end(), this->randEngine);
+				}
+			}
+			
+			this->index = 1;
+		}
+		
+		void
+		HaltonSampler::seed(const ::std::mt19937::result_type& value)
+		{
+			UniformSampler::seed(value);
+			this->bases.clear();
+		}
+		
+		void
+		HaltonSampler::setScrambled(const bool& scrambled)
+		{
+			this->scrambled = scrambled;
+			this->bases.clear();
+		}
+	}
+}
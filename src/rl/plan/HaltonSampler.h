@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_HALTONSAMPLER_H
+#define RL_PLAN_HALTONSAMPLER_H
+
+#include <vector>
+
+#include "UniformSampler.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Scrambled Halton sequence sampling strategy.
+		 *
+		 * Dimension i uses the radical inverse in the base of the i-th prime.
+		 * Digits are scrambled with random permutations drawn in seed(),
+		 * which breaks up the correlation between higher dimensions.
+		 *
+		 * J. H. Halton. On the efficiency of certain quasi-random sequences of
+		 * points in evaluating multi-dimensional integrals. Numerische
+		 * Mathematik, 2(1):84-90, 1960.
+		 *
+		 * http://dx.doi.org/10.1007/BF01386213
+		 */
+		class RL_PLAN_EXPORT HaltonSampler : public UniformSampler
+		{
+		public:
+			HaltonSampler();
+			
+			virtual ~HaltonSampler();
+			
+			::rl::math::Vector generate();
+			
+			bool getScrambled() const;
+			
+			/**
+			 * Restart sequence and draw new digit permutations.
+			 */
+			virtual void seed(const ::std::mt19937::result_type& value);
+			
+			void setScrambled(const bool& scrambled);
+			
+			/** Scramble digits with random permutations. */
+			bool scrambled;
+			
+		protected:
+			void initialize(const ::std::size_t& dimensions);
+			
+			/** Prime bases per dimension. */
+			::std::vector<::std::size_t> bases;
+			
+			/** Index of next element in sequence. */
+			::std::size_t index;
+			
+			/** Digit permutations per dimension. */
+			::std::vector<::std::vector<::std::size_t>> permutations;
+			
+		private:
+			
+		};
+	}
+}
+
+#endif // RL_PLAN_HALTONSAMPLER_H
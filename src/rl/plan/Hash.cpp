@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <string>
+#include <rl/sg/Body.h>
+#include <rl/sg/Shape.h>
+
+#include "Hash.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		Hash::Hash() :
+			value(14695981039346656037ULL)
+		{
+		}
+		
+		Hash::~Hash()
+		{
+		}
+		
+		void
+		Hash::combine(const ::rl::sg::Body* body)
+		{
+			::std::string name = body->getName();
+			this->combine(name.data(), name.size());
+			
+			this->combine(body->center.data(), body->center.size() * sizeof(::rl::math::Real));
+			this->combine(body->min.data(), body->min.size() * sizeof(::rl::math::Real));
+			this->combine(body->max.data(), body->max.size() * sizeof(::rl::math::Real));
+			
+			::std::uint64_t points = body->points.size();
+			this->combine(&points, sizeof(points));
+			
+			for (::std::size_t i = 0; i < body->points.size(); ++i)
+			{
+				this->combine(body->points[i].data(), body->points[i].size() * sizeof(::rl::math::Real));
+			}
+			
+			::std::uint64_t shapes = body->getNumShapes();
+			this->combine(&shapes, sizeof(shapes));
+			
+			for (::std::size_t i = 0; i < body->getNumShapes(); ++i)
+			{
+				::std::string name = body->getShape(i)->getName();
+				this->combine(name.data(), name.size());
+				
+				this->combine(body->getShape(i)->getTransform());
+			}
+		}
+		
+		void
+		Hash::combine(const ::rl::math::Transform& transform)
+		{
+			this->combine(transform.matrix().data(), transform.matrix().size() * sizeof(::rl::math::Real));
+		}
+		
+		void
+		Hash::combine(const void* data, const ::std::size_t& size)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			
+			for (::std::size_t i = 0; i < size; ++i)
+			{
+				this->value ^= bytes[i];
+				this->value *= 1099511628211ULL;
+			}
+		}
+		
+		::std::uint64_t
+		Hash::get() const
+		{
+			return this->value;
+		}
+	}
+}
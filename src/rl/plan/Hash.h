@@ -0,0 +1,79 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_HASH_H
+#define RL_PLAN_HASH_H
+
+#include <cstdint>
+#include <rl/math/Transform.h>
+#include <rl/plan/export.h>
+
+namespace rl
+{
+	namespace sg
+	{
+		class Body;
+	}
+	
+	namespace plan
+	{
+		/**
+		 * 64-bit FNV-1a hash for detecting changes of model or scene.
+		 *
+		 * Used for rejecting data saved for a different setup, e.g., roadmaps
+		 * or distance fields. Not suitable for cryptographic purposes.
+		 */
+		class RL_PLAN_EXPORT Hash
+		{
+		public:
+			Hash();
+			
+			virtual ~Hash();
+			
+			/**
+			 * Combine name, bounding box, points, and shape names and transforms of body.
+			 *
+			 * Geometry of shapes is not accessible via the scene graph interface
+			 * and only covered by bounding box and points, i.e., if loaded with
+			 * these enabled.
+			 */
+			void combine(const ::rl::sg::Body* body);
+			
+			void combine(const ::rl::math::Transform& transform);
+			
+			void combine(const void* data, const ::std::size_t& size);
+			
+			::std::uint64_t get() const;
+			
+		protected:
+			
+		private:
+			::std::uint64_t value;
+		};
+	}
+}
+
+#endif // RL_PLAN_HASH_H
@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef RL_PLAN_JOINTMETRIC_H
+#define RL_PLAN_JOINTMETRIC_H
+
+#include <cmath>
+#include <rl/math/Vector.h>
+
+#include "Metric.h"
+#include "Model.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Metric on joint positions without virtual calls per evaluation.
+		 *
+		 * Joint ranges and wraparounds are copied from the model on
+		 * construction, distances are evaluated inline. Models with
+		 * quaternion joint positions fall back to the model's distance
+		 * functions.
+		 */
+		class RL_PLAN_EXPORT JointMetric
+		{
+		public:
+			typedef ::rl::math::Real Distance;
+			
+			typedef ::std::size_t Size;
+			
+			typedef Metric::Value Value;
+			
+			JointMetric(Model* model, const bool& transformed);
+			
+			virtual ~JointMetric();
+			
+			const ::rl::math::Vector& getWeights() const;
+			
+			/**
+			 * Check if distances are evaluated inline, i.e., as sum of
+			 * coordinateDistance() over all coordinates.
+			 */
+			bool isInline() const;
+			
+			/**
+			 * Set weights of squared joint distances, defaults to one.
+			 *
+			 * Weights other than one change the distances reported by nearest
+			 * neighbor searches compared to the model's distance functions.
+			 */
+			void setWeights(const ::rl::math::Vector& weights);
+			
+			/**
+			 * Weighted squared distances of coordinate with given index.
+			 *
+			 * Evaluated coefficient-wise, e.g., for the coordinates of a block
+			 * of configurations. Requires isInline().
+			 */
+			template<typename Derived>
+			typename Derived::PlainObject coordinateDistance(const ::Eigen::ArrayBase<Derived>& lhs, const Distance& rhs, const Size& index) const
+			{
+				typename Derived::PlainObject delta = (lhs - rhs).abs();
+				
+				if (this->wraparounds(index))
+				{
+					delta = delta.min((this->range(index) - delta).abs());
+				}
+				
+				return this->weights(index) * delta.square();
+			}
+			
+			Distance operator()(const Value& lhs, const Value& rhs) const
+			{
+				if (nullptr != this->model)
+				{
+					return this->transformed ? this->model->transformedDistance(*lhs.first, *rhs.first) : this->model->distance(*lhs.first, *rhs.first);
+				}
+				
+				const ::rl::math::Real* q1 = lhs.begin();
+				const ::rl::math::Real* q2 = rhs.begin();
+				
+				Distance distance = 0;
+				
+				for (::std::ptrdiff_t i = 0; i < this->weights.size(); ++i)
+				{
+					Distance delta = ::std::abs(q2[i] - q1[i]);
+					
+					if (this->wraparounds(i))
+					{
+						delta = ::std::min(delta, ::std::abs(this->range(i) - delta));
+					}
+					
+					distance += this->weights(i) * delta * delta;
+				}
+				
+				return this->transformed ? distance : ::std::sqrt(distance);
+			}
+			
+			Distance operator()(const Distance& lhs, const Distance& rhs, const Size& index) const
+			{
+				if (nullptr != this->model)
+				{
+					return this->model->transformedDistance(lhs, rhs, index);
+				}
+				
+				Distance delta = ::std::abs(lhs - rhs);
+				
+				if (this->wraparounds(index))
+				{
+					delta = ::std::max(delta, ::std::abs(this->range(index) - delta));
+				}
+				
+				return this->weights(index) * delta * delta;
+			}
+			
+		protected:
+			
+		private:
+			/** Model for fallback, nullptr if distances are evaluated inline. */
+			Model* model;
+			
+			::rl::math::Vector range;
+			
+			bool transformed;
+			
+			::rl::math::Vector weights;
+			
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> wraparounds;
+		};
+	}
+}
+
+#endif // RL_PLAN_JOINTMETRIC_H
@@ -33,7 +33,7 @@ namespace rl
 	{
 		KdtreeBoundingBoxNearestNeighbors::KdtreeBoundingBoxNearestNeighbors(Model* model) :
 			NearestNeighbors(true),
-			container(Metric(model, true))
+			container(JointMetric(model, true))
 		{
 		}
 		
@@ -65,6 +65,13 @@ namespace rl
 			return this->container.getNodeDataMax();
 		}
 		
+		void
+		KdtreeBoundingBoxNearestNeighbors::insert(const ::std::vector<NearestNeighbors::Value>& values)
+		{
+			::std::vector<NearestNeighbors::Value> tmp(values);
+			this->container.insert(tmp.begin(), tmp.end());
+		}
+		
 		::std::vector<NearestNeighbors::Neighbor>
 		KdtreeBoundingBoxNearestNeighbors::nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted) const
 		{
@@ -29,6 +29,7 @@
 
 #include <rl/math/KdtreeBoundingBoxNearestNeighbors.h>
 
+#include "JointMetric.h"
 #include "NearestNeighbors.h"
 
 namespace rl
@@ -52,6 +53,8 @@ namespace rl
 			
 			::std::size_t getNodeDataMax() const;
 			
+			void insert(const ::std::vector<NearestNeighbors::Value>& values);
+			
 			::std::vector<NearestNeighbors::Neighbor> nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted = true) const;
 			
 			void push(const NearestNeighbors::Value& value);
@@ -67,7 +70,7 @@ namespace rl
 		protected:
 			
 		private:
-			::rl::math::KdtreeBoundingBoxNearestNeighbors<Metric> container;
+			::rl::math::KdtreeBoundingBoxNearestNeighbors<JointMetric> container;
 		};
 	}
 }
@@ -0,0 +1,201 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <algorithm>
+#include <limits>
+
+#include "LinearBlockNearestNeighbors.h"
+#include "Model.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		LinearBlockNearestNeighbors::LinearBlockNearestNeighbors(Model* model) :
+			NearestNeighbors(true),
+			coordinates(),
+			dof(model->getDofPosition()),
+			metric(model, true),
+			values()
+		{
+		}
+		
+		LinearBlockNearestNeighbors::~LinearBlockNearestNeighbors()
+		{
+		}
+		
+		void
+		LinearBlockNearestNeighbors::clear()
+		{
+			this->coordinates.clear();
+			this->values.clear();
+		}
+		
+		bool
+		LinearBlockNearestNeighbors::empty() const
+		{
+			return this->values.empty();
+		}
+		
+		const ::rl::math::Vector&
+		LinearBlockNearestNeighbors::getWeights() const
+		{
+			return this->metric.getWeights();
+		}
+		
+		::std::vector<NearestNeighbors::Neighbor>
+		LinearBlockNearestNeighbors::nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted) const
+		{
+			return this->search(query, &k, nullptr, sorted);
+		}
+		
+		void
+		LinearBlockNearestNeighbors::push(const NearestNeighbors::Value& value)
+		{
+			assert(value.size() == this->dof);
+			
+			::std::size_t slot = this->values.size() % Block::RowsAtCompileTime;
+			
+			if (0 == slot)
+			{
+				this->coordinates.resize(this->coordinates.size() + this->dof * Block::RowsAtCompileTime);
+			}
+			
+			::rl::math::Real* block = this->coordinates.data() + this->coordinates.size() - this->dof * Block::RowsAtCompileTime;
+			
+			for (::std::size_t i = 0; i < this->dof; ++i)
+			{
+				block[i * Block::RowsAtCompileTime + slot] = *(value.begin() + i);
+			}
+			
+			this->values.push_back(value);
+		}
+		
+		::std::vector<NearestNeighbors::Neighbor>
+		LinearBlockNearestNeighbors::radius(const NearestNeighbors::Value& query, const Distance& radius, const bool& sorted) const
+		{
+			return this->search(query, nullptr, &radius, sorted);
+		}
+		
+		::std::vector<NearestNeighbors::Neighbor>
+		LinearBlockNearestNeighbors::search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const
+		{
+			assert(query.size() == this->dof);
+			
+			::std::vector<Neighbor> neighbors;
+			
+			if (nullptr != k)
+			{
+				neighbors.reserve(::std::min(*k, this->size()));
+			}
+			
+			for (::std::size_t i = 0; i < this->values.size(); i += Block::RowsAtCompileTime)
+			{
+				const ::rl::math::Real* block = this->coordinates.data() + i * this->dof;
+				
+				bool full = nullptr != k && neighbors.size() == *k;
+				bool bounded = full || nullptr != radius;
+				Distance bound = full ? neighbors.front().first : nullptr != radius ? *radius : 0;
+				
+				::std::size_t count = ::std::min<::std::size_t>(Block::RowsAtCompileTime, this->values.size() - i);
+				
+				Block distances = Block::Zero();
+				
+				if (!this->metric.isInline())
+				{
+					for (::std::size_t l = 0; l < count; ++l)
+					{
+						distances(l) = this->metric(query, this->values[i + l]);
+					}
+				}
+				else
+				{
+					// unused lanes of last block never bound the search
+					distances.tail(Block::RowsAtCompileTime - count).setConstant(::std::numeric_limits<::rl::math::Real>::infinity());
+					
+					::std::size_t j = 0;
+					
+					for (; j < this->dof; ++j)
+					{
+						distances += this->metric.coordinateDistance(::Eigen::Map<const Block>(block + j * Block::RowsAtCompileTime), *(query.begin() + j), j);
+						
+						if (bounded && distances.minCoeff() >= bound)
+						{
+							break;
+						}
+					}
+					
+					if (j < this->dof)
+					{
+						continue;
+					}
+				}
+				
+				for (::std::size_t l = 0; l < count; ++l)
+				{
+					if (nullptr == k || neighbors.size() < *k || distances(l) < neighbors.front().first)
+					{
+						if (nullptr == radius || distances(l) < *radius)
+						{
+							if (nullptr != k && *k == neighbors.size())
+							{
+								::std::pop_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+								neighbors.pop_back();
+							}
+							
+							neighbors.emplace_back(distances(l), this->values[i + l]);
+							::std::push_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+						}
+					}
+				}
+			}
+			
+			if (sorted)
+			{
+				::std::sort_heap(neighbors.begin(), neighbors.end(), NeighborCompare());
+			}
+			
+			return neighbors;
+		}
+		
+		void
+		LinearBlockNearestNeighbors::setWeights(const ::rl::math::Vector& weights)
+		{
+			this->metric.setWeights(weights);
+		}
+		
+		::std::size_t
+		LinearBlockNearestNeighbors::size() const
+		{
+			return this->values.size();
+		}
+		
+		bool
+		LinearBlockNearestNeighbors::NeighborCompare::operator()(const Neighbor& lhs, const Neighbor& rhs) const
+		{
+			return lhs.first < rhs.first;
+		}
+	}
+}
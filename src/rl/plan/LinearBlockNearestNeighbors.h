@@ -0,0 +1,100 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#ifndef RL_PLAN_LINEARBLOCKNEARESTNEIGHBORS_H
+#define RL_PLAN_LINEARBLOCKNEARESTNEIGHBORS_H
+
+#include <vector>
+#include <rl/math/Vector.h>
+
+#include "JointMetric.h"
+#include "NearestNeighbors.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		class Model;
+		
+		/**
+		 * Linear nearest neighbor search over blocks of coordinates.
+		 *
+		 * Configurations are stored in blocks of eight, with each coordinate
+		 * of a block stored contiguously. Transformed distances of JointMetric
+		 * are evaluated for all configurations of a block at once and a block
+		 * is skipped as soon as its partial distances exceed the current bound.
+		 * Suited for small sets, e.g., in early iterations of tree-based
+		 * planners.
+		 */
+		class RL_PLAN_EXPORT LinearBlockNearestNeighbors : public NearestNeighbors
+		{
+		public:
+			LinearBlockNearestNeighbors(Model* model);
+			
+			virtual ~LinearBlockNearestNeighbors();
+			
+			void clear();
+			
+			bool empty() const;
+			
+			const ::rl::math::Vector& getWeights() const;
+			
+			::std::vector<NearestNeighbors::Neighbor> nearest(const NearestNeighbors::Value& query, const ::std::size_t& k, const bool& sorted = true) const;
+			
+			void push(const NearestNeighbors::Value& value);
+			
+			::std::vector<NearestNeighbors::Neighbor> radius(const Value& query, const Distance& radius, const bool& sorted = true) const;
+			
+			/**
+			 * Set weights of squared joint distances, defaults to one.
+			 */
+			void setWeights(const ::rl::math::Vector& weights);
+			
+			::std::size_t size() const;
+			
+		protected:
+			
+		private:
+			typedef ::Eigen::Array<::rl::math::Real, 8, 1> Block;
+			
+			struct NeighborCompare
+			{
+				bool operator()(const Neighbor& lhs, const Neighbor& rhs) const;
+			};
+			
+			::std::vector<Neighbor> search(const Value& query, const ::std::size_t* k, const Distance* radius, const bool& sorted) const;
+			
+			::std::vector<::rl::math::Real> coordinates;
+			
+			::std::size_t dof;
+			
+			JointMetric metric;
+			
+			::std::vector<Value> values;
+		};
+	}
+}
+
+#endif // RL_PLAN_LINEARBLOCKNEARESTNEIGHBORS_H
@@ -33,7 +33,7 @@ namespace rl
 	{
 		LinearNearestNeighbors::LinearNearestNeighbors(Model* model) :
 			NearestNeighbors(true),
-			container(Metric(model, true))
+			container(JointMetric(model, true))
 		{
 		}
 		
@@ -29,6 +29,7 @@
 
 #include <rl/math/LinearNearestNeighbors.h>
 
+#include "JointMetric.h"
 #include "NearestNeighbors.h"
 
 namespace rl
@@ -59,7 +60,7 @@ namespace rl
 		protected:
 			
 		private:
-			::rl::math::LinearNearestNeighbors<Metric> container;
+			::rl::math::LinearNearestNeighbors<JointMetric> container;
 		};
 	}
 }
@@ -55,6 +55,14 @@ namespace rl
 			
 			virtual bool empty() const = 0;
 			
+			/**
+			 * Insert multiple values at once.
+			 *
+			 * Pushes values one by one by default, tree-based containers build
+			 * a balanced tree if empty.
+			 */
+			virtual void insert(const ::std::vector<Value>& values);
+			
 			bool isTransformedDistance() const;
 			
 			virtual ::std::vector<Neighbor> nearest(const Value& query, const ::std::size_t& k, const bool& sorted = true) const = 0;
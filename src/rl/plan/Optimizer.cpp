@@ -61,6 +61,14 @@ namespace rl
 			return this->viewer;
 		}
 		
+		void
+		Optimizer::process(Path& path)
+		{
+			VectorList list = path.toList();
+			this->process(list);
+			path = list;
+		}
+		
 		void
 		Optimizer::setModel(SimpleModel* model)
 		{
@@ -112,5 +120,42 @@ namespace rl
 			
 			return changed;
 		}
+		
+		bool
+		Optimizer::subdivide(Path& path, const ::rl::math::Real& length)
+		{
+			bool changed = false;
+			::rl::math::Vector inter(this->getModel()->getDofPosition());
+			::rl::math::Vector qi(this->getModel()->getDofPosition());
+			::rl::math::Vector qj(this->getModel()->getDofPosition());
+			
+			::std::size_t i = 0;
+			
+			while (i + 1 < path.size())
+			{
+				qi = path[i];
+				qj = path[i + 1];
+				
+				if (length > 0 && this->getModel()->distance(qi, qj) > length)
+				{
+					this->getModel()->interpolate(qi, qj, static_cast<::rl::math::Real>(0.5), inter);
+					
+					path.insert(i + 1, inter);
+					
+					if (nullptr != this->getViewer())
+					{
+						this->getViewer()->drawConfigurationPath(path.toList());
+					}
+					
+					changed = true;
+				}
+				else
+				{
+					++i;
+				}
+			}
+			
+			return changed;
+		}
 	}
 }
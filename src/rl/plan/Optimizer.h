@@ -29,6 +29,7 @@
 
 #include <rl/plan/export.h>
 
+#include "Path.h"
 #include "VectorList.h"
 
 namespace rl
@@ -54,6 +55,14 @@ namespace rl
 			
 			virtual void process(VectorList& path) = 0;
 			
+			/**
+			 * Optimize path in contiguous memory.
+			 *
+			 * Converts to VectorList by default, optimizers that perform many
+			 * edits operate on the contiguous path directly.
+			 */
+			virtual void process(Path& path);
+			
 			void setModel(SimpleModel* model);
 			
 			void setVerifier(Verifier* verifier);
@@ -62,6 +71,8 @@ namespace rl
 			
 			bool subdivide(VectorList& path, const ::rl::math::Real& length = 0);
 			
+			bool subdivide(Path& path, const ::rl::math::Real& length = 0);
+			
 			SimpleModel* model;
 			
 			Verifier* verifier;
@@ -0,0 +1,239 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+
+#include "Path.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		Path::Path() :
+			begin(0),
+			end(0),
+			matrix()
+		{
+		}
+		
+		Path::Path(const VectorList& path) :
+			begin(0),
+			end(0),
+			matrix()
+		{
+			*this = path;
+		}
+		
+		Path::~Path()
+		{
+		}
+		
+		Path&
+		Path::operator=(const VectorList& path)
+		{
+			this->matrix.resize(path.empty() ? 0 : path.front().size(), path.size());
+			
+			::std::size_t i = 0;
+			
+			for (VectorList::const_iterator j = path.begin(); j != path.end(); ++i, ++j)
+			{
+				this->matrix.col(i) = *j;
+			}
+			
+			this->begin = path.size();
+			this->end = path.size();
+			
+			return *this;
+		}
+		
+		::rl::math::MatrixColumn
+		Path::operator[](const ::std::size_t& i)
+		{
+			return this->matrix.col(this->index(i));
+		}
+		
+		::rl::math::ConstMatrixColumn
+		Path::operator[](const ::std::size_t& i) const
+		{
+			return this->matrix.col(this->index(i));
+		}
+		
+		::rl::math::MatrixColumn
+		Path::back()
+		{
+			return (*this)[this->size() - 1];
+		}
+		
+		::rl::math::ConstMatrixColumn
+		Path::back() const
+		{
+			return (*this)[this->size() - 1];
+		}
+		
+		::std::size_t
+		Path::capacity() const
+		{
+			return this->matrix.cols();
+		}
+		
+		void
+		Path::clear()
+		{
+			this->begin = 0;
+			this->end = this->matrix.cols();
+		}
+		
+		bool
+		Path::empty() const
+		{
+			return 0 == this->size();
+		}
+		
+		void
+		Path::erase(const ::std::size_t& i)
+		{
+			this->erase(i, i + 1);
+		}
+		
+		void
+		Path::erase(const ::std::size_t& first, const ::std::size_t& last)
+		{
+			this->move(first);
+			this->end += last - first;
+		}
+		
+		::rl::math::MatrixColumn
+		Path::front()
+		{
+			return (*this)[0];
+		}
+		
+		::rl::math::ConstMatrixColumn
+		Path::front() const
+		{
+			return (*this)[0];
+		}
+		
+		::std::size_t
+		Path::getDof() const
+		{
+			return this->matrix.rows();
+		}
+		
+		::std::size_t
+		Path::index(const ::std::size_t& i) const
+		{
+			return i < this->begin ? i : i + this->end - this->begin;
+		}
+		
+		void
+		Path::insert(const ::std::size_t& i, const ::rl::math::Vector& q)
+		{
+			if (0 == this->matrix.rows())
+			{
+				this->matrix.resize(q.size(), 0);
+			}
+			
+			if (this->begin == this->end)
+			{
+				this->resize(::std::max<::std::size_t>(2 * this->capacity(), 8));
+			}
+			
+			this->move(i);
+			this->matrix.col(this->begin) = q;
+			++this->begin;
+		}
+		
+		void
+		Path::move(const ::std::size_t& i)
+		{
+			// copy columns across the gap, in an order that does not overwrite sources
+			
+			for (; this->begin > i; --this->begin, --this->end)
+			{
+				this->matrix.col(this->end - 1) = this->matrix.col(this->begin - 1);
+			}
+			
+			for (; this->begin < i; ++this->begin, ++this->end)
+			{
+				this->matrix.col(this->begin) = this->matrix.col(this->end);
+			}
+		}
+		
+		void
+		Path::pop_back()
+		{
+			this->erase(this->size() - 1);
+		}
+		
+		void
+		Path::push_back(const ::rl::math::Vector& q)
+		{
+			this->insert(this->size(), q);
+		}
+		
+		void
+		Path::reserve(const ::std::size_t& n)
+		{
+			if (n > this->capacity())
+			{
+				this->resize(n);
+			}
+		}
+		
+		void
+		Path::resize(const ::std::size_t& capacity)
+		{
+			::std::size_t tail = this->matrix.cols() - this->end;
+			
+			::rl::math::Matrix matrix(this->matrix.rows(), capacity);
+			matrix.leftCols(this->begin) = this->matrix.leftCols(this->begin);
+			matrix.rightCols(tail) = this->matrix.rightCols(tail);
+			
+			this->matrix.swap(matrix);
+			this->end = capacity - tail;
+		}
+		
+		::std::size_t
+		Path::size() const
+		{
+			return this->matrix.cols() - (this->end - this->begin);
+		}
+		
+		VectorList
+		Path::toList() const
+		{
+			VectorList path;
+			
+			for (::std::size_t i = 0; i < this->size(); ++i)
+			{
+				path.push_back((*this)[i]);
+			}
+			
+			return path;
+		}
+	}
+}
@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_PATH_H
+#define RL_PLAN_PATH_H
+
+#include <rl/math/Matrix.h>
+#include <rl/math/Vector.h>
+#include <rl/plan/export.h>
+
+#include "VectorList.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Path of configurations in contiguous memory.
+		 *
+		 * Configurations are stored as columns of a matrix with a gap of unused
+		 * columns at the position of the last edit. Insertions and erasures
+		 * first move the gap to their position, so a sweep of edits from front
+		 * to back as performed by the optimizers copies each configuration at
+		 * most once.
+		 *
+		 * Elements are accessed by index. References remain valid until the
+		 * next insertion or erasure.
+		 */
+		class RL_PLAN_EXPORT Path
+		{
+		public:
+			Path();
+			
+			explicit Path(const VectorList& path);
+			
+			virtual ~Path();
+			
+			Path& operator=(const VectorList& path);
+			
+			::rl::math::MatrixColumn operator[](const ::std::size_t& i);
+			
+			::rl::math::ConstMatrixColumn operator[](const ::std::size_t& i) const;
+			
+			::rl::math::MatrixColumn back();
+			
+			::rl::math::ConstMatrixColumn back() const;
+			
+			::std::size_t capacity() const;
+			
+			void clear();
+			
+			bool empty() const;
+			
+			/**
+			 * Erase configuration at index i.
+			 */
+			void erase(const ::std::size_t& i);
+			
+			/**
+			 * Erase configurations in range [first, last).
+			 */
+			void erase(const ::std::size_t& first, const ::std::size_t& last);
+			
+			::rl::math::MatrixColumn front();
+			
+			::rl::math::ConstMatrixColumn front() const;
+			
+			::std::size_t getDof() const;
+			
+			/**
+			 * Insert configuration before index i.
+			 */
+			void insert(const ::std::size_t& i, const ::rl::math::Vector& q);
+			
+			void pop_back();
+			
+			void push_back(const ::rl::math::Vector& q);
+			
+			void reserve(const ::std::size_t& n);
+			
+			::std::size_t size() const;
+			
+			VectorList toList() const;
+			
+		protected:
+			
+		private:
+			::std::size_t index(const ::std::size_t& i) const;
+			
+			void move(const ::std::size_t& i);
+			
+			void resize(const ::std::size_t& capacity);
+			
+			/** Index of first unused column. */
+			::std::size_t begin;
+			
+			/** Index of first used column after the gap. */
+			::std::size_t end;
+			
+			::rl::math::Matrix matrix;
+		};
+	}
+}
+
+#endif // RL_PLAN_PATH_H
@@ -25,6 +25,7 @@
 //
 
 #include "Planner.h"
+#include "Profiler.h"
 #include "SimpleModel.h"
 #include "Viewer.h"
 
@@ -36,8 +37,14 @@ namespace rl
 			duration(::std::chrono::steady_clock::duration::max()),
 			goal(nullptr),
 			model(nullptr),
+			profiler(nullptr),
+			progress(),
+			progressInterval(::std::chrono::seconds(1)),
 			start(nullptr),
 			viewer(nullptr),
+			canceled(false),
+			pool(),
+			progressTime(),
 			time()
 		{
 		}
@@ -46,6 +53,12 @@ namespace rl
 		{
 		}
 		
+		void
+		Planner::cancel()
+		{
+			this->canceled.store(true, ::std::memory_order_relaxed);
+		}
+		
 		::std::chrono::steady_clock::duration
 		Planner::getDuration() const
 		{
@@ -64,6 +77,18 @@ namespace rl
 			return this->model;
 		}
 		
+		VectorList
+		Planner::getPartialPath()
+		{
+			return VectorList();
+		}
+		
+		Profiler*
+		Planner::getProfiler() const
+		{
+			return this->profiler;
+		}
+		
 		::rl::math::Vector*
 		Planner::getStart() const
 		{
@@ -76,6 +101,46 @@ namespace rl
 			return this->viewer;
 		}
 		
+		void
+		Planner::initialize()
+		{
+			this->canceled.store(false, ::std::memory_order_relaxed);
+			this->time = ::std::chrono::steady_clock::now();
+		}
+		
+		bool
+		Planner::isCanceled() const
+		{
+			return this->canceled.load(::std::memory_order_relaxed);
+		}
+		
+		bool
+		Planner::proceed()
+		{
+			if (this->isCanceled())
+			{
+				return false;
+			}
+			
+			::std::chrono::steady_clock::time_point now = ::std::chrono::steady_clock::now();
+			
+			if (this->progress)
+			{
+				if (this->progressTime < this->time)
+				{
+					this->progressTime = this->time;
+				}
+				
+				if (now - this->progressTime >= this->progressInterval)
+				{
+					this->progressTime = now;
+					this->progress(now - this->time);
+				}
+			}
+			
+			return (now - this->time) < this->duration && !this->isCanceled();
+		}
+		
 		void
 		Planner::setDuration(const ::std::chrono::steady_clock::duration& duration)
 		{
@@ -94,6 +159,19 @@ namespace rl
 			this->model = model;
 		}
 		
+		void
+		Planner::setProfiler(Profiler* profiler)
+		{
+			this->profiler = profiler;
+		}
+		
+		void
+		Planner::setProgress(const ::std::function<void(const ::std::chrono::steady_clock::duration&)>& progress, const ::std::chrono::steady_clock::duration& interval)
+		{
+			this->progress = progress;
+			this->progressInterval = interval;
+		}
+		
 		void
 		Planner::setStart(::rl::math::Vector* start)
 		{
@@ -113,6 +191,8 @@ namespace rl
 			{
 				if (nullptr != this->viewer)
 				{
+					Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+					
 					this->viewer->showMessage("Invalid start configuration.");
 				}
 				
@@ -123,6 +203,8 @@ namespace rl
 			{
 				if (nullptr != this->viewer)
 				{
+					Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+					
 					this->viewer->showMessage("Invalid goal configuration.");
 				}
 				
@@ -133,6 +215,8 @@ namespace rl
 			{
 				if (nullptr != this->viewer)
 				{
+					Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+					
 					this->viewer->showMessage("Colliding start configuration in body " + ::std::to_string(this->model->getCollidingBody()) + ".");
 				}
 				
@@ -143,6 +227,8 @@ namespace rl
 			{
 				if (nullptr != this->viewer)
 				{
+					Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+					
 					this->viewer->showMessage("Colliding goal configuration in body " + ::std::to_string(this->model->getCollidingBody()) + ".");
 				}
 				
@@ -27,12 +27,15 @@
 #ifndef RL_PLAN_PLANNER_H
 #define RL_PLAN_PLANNER_H
 
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <string>
 #include <rl/math/Vector.h>
 #include <rl/plan/export.h>
 
 #include "VectorList.h"
+#include "VectorPool.h"
 
 namespace rl
 {
@@ -41,6 +44,7 @@ namespace rl
 	 */
 	namespace plan
 	{
+		class Profiler;
 		class SimpleModel;
 		class Viewer;
 		
@@ -51,6 +55,14 @@ namespace rl
 			
 			virtual ~Planner();
 			
+			/**
+			 * Request a running solve() to stop.
+			 *
+			 * May be called from any thread. solve() returns false at its next
+			 * iteration, the request is cleared when the next solve() starts.
+			 */
+			void cancel();
+			
 			::std::chrono::steady_clock::duration getDuration() const;
 			
 			::rl::math::Vector* getGoal() const;
@@ -59,6 +71,14 @@ namespace rl
 			
 			virtual ::std::string getName() const = 0;
 			
+			/**
+			 * Get path from start to the configuration closest to the goal found so far.
+			 *
+			 * Equals getPath() if solve() succeeded and may be used to retrieve a partial
+			 * result after solve() was canceled or timed out. Empty if no search was started.
+			 */
+			virtual VectorList getPartialPath();
+			
 			/**
 			 * Get solution path.
 			 *
@@ -66,10 +86,14 @@ namespace rl
 			 */
 			virtual VectorList getPath() = 0;
 			
+			Profiler* getProfiler() const;
+			
 			::rl::math::Vector* getStart() const;
 			
 			Viewer* getViewer() const;
 			
+			bool isCanceled() const;
+			
 			/**
 			 * Reset planner.
 			 */
@@ -81,6 +105,21 @@ namespace rl
 			
 			void setModel(SimpleModel* model);
 			
+			/**
+			 * Set profiler for recording planner operations.
+			 *
+			 * Collision queries are recorded if the profiler is also set in
+			 * the model via SimpleModel::setProfiler().
+			 */
+			void setProfiler(Profiler* profiler);
+			
+			/**
+			 * Set callback invoked periodically with the elapsed time from within solve().
+			 *
+			 * The callback is called in the thread running solve() and may call cancel().
+			 */
+			void setProgress(const ::std::function<void(const ::std::chrono::steady_clock::duration&)>& progress, const ::std::chrono::steady_clock::duration& interval);
+			
 			void setStart(::rl::math::Vector* start);
 			
 			void setViewer(Viewer* viewer);
@@ -103,12 +142,42 @@ namespace rl
 			
 			SimpleModel* model;
 			
+			Profiler* profiler;
+			
+			/** Callback for reporting progress during solve(). */
+			::std::function<void(const ::std::chrono::steady_clock::duration&)> progress;
+			
+			/** Minimum time between progress callbacks. */
+			::std::chrono::steady_clock::duration progressInterval;
+			
 			/** Start configuration. */
 			::rl::math::Vector* start;
 			
 			Viewer* viewer;
 			
 		protected:
+			/**
+			 * Start a new search at the beginning of solve().
+			 *
+			 * Clears a previous cancel request and sets the start time.
+			 */
+			void initialize();
+			
+			/**
+			 * Check if search should continue.
+			 *
+			 * Returns false if canceled or duration elapsed since time and invokes
+			 * the progress callback.
+			 */
+			bool proceed();
+			
+			::std::atomic<bool> canceled;
+			
+			/** Storage for configurations of graph vertices, cleared in reset(). */
+			VectorPool pool;
+			
+			::std::chrono::steady_clock::time_point progressTime;
+			
 			::std::chrono::steady_clock::time_point time;
 			
 		private:
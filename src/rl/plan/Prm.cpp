@@ -24,12 +24,23 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/incremental_components.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <rl/sg/Body.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/Scene.h>
 
 #include "BridgeSampler.h"
+#include "Exception.h"
 #include "GaussianSampler.h"
+#include "Hash.h"
 #include "Prm.h"
+#include "Profiler.h"
 #include "Sampler.h"
 #include "SimpleModel.h"
 #include "UniformSampler.h"
@@ -40,9 +51,42 @@ namespace rl
 {
 	namespace plan
 	{
+		struct Prm::RoadmapEdge
+		{
+			::std::uint64_t u;
+			
+			::std::uint64_t v;
+			
+			::rl::math::Real weight;
+		};
+		
+		struct Prm::RoadmapHeader
+		{
+			char magic[8];
+			
+			::std::uint32_t version;
+			
+			::std::uint32_t dof;
+			
+			::std::uint64_t hash;
+			
+			::std::uint64_t vertices;
+			
+			::std::uint64_t edges;
+			
+			::std::uint32_t real;
+			
+			::std::uint32_t reserved;
+		};
+		
+		static const char ROADMAP_MAGIC[8] = { 'R', 'L', 'P', 'R', 'M', '\0', '\0', '\0' };
+		
+		static const ::std::uint32_t ROADMAP_VERSION = 1;
+		
 		Prm::Prm() :
 			Planner(),
 			astar(true),
+			batchSize(1),
 			degree(::std::numeric_limits<::std::size_t>::max()),
 			k(30),
 			radius(::std::numeric_limits<::rl::math::Real>::max()),
@@ -65,13 +109,18 @@ namespace rl
 		Prm::Edge
 		Prm::addEdge(const Vertex& u, const Vertex& v, const ::rl::math::Real& weight)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::insertion);
+			
 			Edge e = ::boost::add_edge(u, v, this->graph).first;
+			this->graph[e].verified = true;
 			this->graph[e].weight = weight;
 			
 			this->ds.union_set(u, v);
 			
 			if (nullptr != this->getViewer())
 			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
 				this->getViewer()->drawConfigurationEdge(*this->graph[u].q, *this->graph[v].q);
 			}
 			
@@ -81,6 +130,8 @@ namespace rl
 		Prm::Vertex
 		Prm::addVertex(const VectorPtr& q)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::insertion);
+			
 			Vertex v = ::boost::add_vertex(this->graph);
 			this->graph[v].index = ::boost::num_vertices(this->graph) - 1;
 			this->graph[v].q = q;
@@ -88,24 +139,150 @@ namespace rl
 			
 			if (nullptr != this->getViewer())
 			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
 				this->getViewer()->drawConfigurationVertex(*this->graph[v].q);
 			}
 			
 			return v;
 		}
 		
+		Prm::Box
+		Prm::computeBox(const ::rl::math::Vector& q)
+		{
+			this->getModel()->setPosition(q);
+			this->getModel()->updateFrames();
+			
+			Box box;
+			
+			for (::std::size_t i = 0; i < this->getModel()->getBodies(); ++i)
+			{
+				box.extend(Prm::computeBox(this->getModel()->getBody(i), this->getModel()->getFrame(i)));
+			}
+			
+			return box;
+		}
+		
+		Prm::Box
+		Prm::computeBox(const Edge& e)
+		{
+			const ::rl::math::Vector& q0 = *this->graph[::boost::source(e, this->graph)].q;
+			const ::rl::math::Vector& q1 = *this->graph[::boost::target(e, this->graph)].q;
+			
+			// sample at verifier resolution, same as collision checks of edge
+			::std::size_t steps = ::std::max<::std::size_t>(this->verifier->getSteps(this->graph[e].weight), 1);
+			
+			::rl::math::Vector q(q0.size());
+			Box box;
+			
+			for (::std::size_t i = 0; i <= steps; ++i)
+			{
+				this->getModel()->interpolate(q0, q1, static_cast<::rl::math::Real>(i) / steps, q);
+				box.extend(this->computeBox(q));
+			}
+			
+			return box;
+		}
+		
+		Prm::Box
+		Prm::computeBox(const ::rl::sg::Body* body, const ::rl::math::Transform& frame)
+		{
+			Box box;
+			
+			if (body->min.isZero() && body->max.isZero())
+			{
+				box.min().setConstant(-::std::numeric_limits<::rl::math::Real>::infinity());
+				box.max().setConstant(::std::numeric_limits<::rl::math::Real>::infinity());
+			}
+			else
+			{
+				::rl::math::Vector3 center = frame * ((body->max + body->min) / 2);
+				::rl::math::Vector3 extent = frame.linear().cwiseAbs() * ((body->max - body->min) / 2);
+				box.min() = center - extent;
+				box.max() = center + extent;
+			}
+			
+			return box;
+		}
+		
+		void
+		Prm::connect(const Vertex& v)
+		{
+			::std::vector<Neighbor> neighbors;
+			
+			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::nearestNeighbors);
+				neighbors = this->graph[::boost::graph_bundle].nn->nearest(Metric::Value(this->graph[v].q.get(), v), this->k);
+			}
+			
+			::std::vector<Vertex> candidates;
+			::std::vector<Verifier::Segment> segments;
+			
+			for (::std::size_t i = 0; i < neighbors.size(); ++i)
+			{
+				Vertex u = neighbors[i].second.second;
+				
+				if (u != v && ::boost::degree(u, this->graph) < this->degree)
+				{
+					::rl::math::Real d = this->graph[::boost::graph_bundle].nn->isTransformedDistance() ? this->getModel()->inverseOfTransformedDistance(neighbors[i].first) : neighbors[i].first;
+					
+					if (d < this->radius)
+					{
+						if (!::boost::same_component(u, v, this->ds))
+						{
+							candidates.push_back(u);
+							segments.push_back(Verifier::Segment(this->graph[u].q.get(), this->graph[v].q.get(), d));
+						}
+					}
+				}
+			}
+			
+			if (segments.empty())
+			{
+				return;
+			}
+			
+			// verify all candidate edges at once, edges are added in order of
+			// distance and skipped if an earlier edge already connected both
+			::std::vector<bool> colliding;
+			
+			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::verification);
+				colliding = this->verifier->isColliding(segments);
+			}
+			
+			for (::std::size_t i = 0; i < candidates.size() && ::boost::degree(v, this->graph) < this->degree; ++i)
+			{
+				if (!colliding[i] && !::boost::same_component(candidates[i], v, this->ds))
+				{
+					this->addEdge(candidates[i], v, segments[i].d);
+				}
+			}
+		}
+		
 		void
 		Prm::construct(const ::std::size_t& steps)
 		{
-			for (::std::size_t i = 0; i < steps; ++i)
+			::std::vector<::rl::math::Vector> samples;
+			
 			{
-				VectorPtr q = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
-				*q = this->sampler->generateCollisionFree();
-				Vertex v = this->addVertex(q);
+				Profiler::Scope scope(this->profiler, Profiler::Counter::sampling);
+				samples = this->sampler->generateCollisionFree(steps);
+			}
+			
+			for (::std::size_t i = 0; i < samples.size(); ++i)
+			{
+				Vertex v = this->addVertex(this->pool.allocate(samples[i]));
 				this->insert(v);
 			}
 		}
 		
+		::std::size_t
+		Prm::getBatchSize() const
+		{
+			return this->batchSize;
+		}
+		
 		::std::size_t
 		Prm::getMaxDegree() const
 		{
@@ -160,6 +337,63 @@ namespace rl
 			return ::boost::num_vertices(this->graph);
 		}
 		
+		VectorList
+		Prm::getPartialPath()
+		{
+			VectorList path;
+			
+			if (nullptr == this->begin || nullptr == this->end)
+			{
+				return path;
+			}
+			
+			if (::boost::same_component(this->begin, this->end, this->ds))
+			{
+				return this->getPath();
+			}
+			
+			::boost::dijkstra_shortest_paths(
+				this->graph,
+				this->begin,
+				::boost::get(&VertexBundle::predecessor, this->graph),
+				::boost::get(&VertexBundle::distance, this->graph),
+				::boost::get(&EdgeBundle::weight, this->graph),
+				::boost::get(&VertexBundle::index, this->graph),
+				::std::less<::rl::math::Real>(),
+				::boost::closed_plus<::rl::math::Real>(),
+				::std::numeric_limits<::rl::math::Real>::max(),
+				0,
+				::boost::default_dijkstra_visitor()
+			);
+			
+			Vertex i = this->begin;
+			::rl::math::Real distance = ::std::numeric_limits<::rl::math::Real>::infinity();
+			
+			for (VertexIteratorPair j = ::boost::vertices(this->graph); j.first != j.second; ++j.first)
+			{
+				if (this->graph[*j.first].distance < ::std::numeric_limits<::rl::math::Real>::max())
+				{
+					::rl::math::Real d = this->getModel()->distance(*this->graph[*j.first].q, *this->getGoal());
+					
+					if (d < distance)
+					{
+						distance = d;
+						i = *j.first;
+					}
+				}
+			}
+			
+			while (i != this->begin)
+			{
+				path.push_front(*this->graph[i].q);
+				i = this->graph[i].predecessor;
+			}
+			
+			path.push_front(*this->graph[i].q);
+			
+			return path;
+		}
+		
 		VectorList
 		Prm::getPath()
 		{
@@ -196,44 +430,399 @@ namespace rl
 			return this->verifier;
 		}
 		
-		void
-		Prm::insert(const Vertex& v)
+		::std::uint64_t
+		Prm::hash()
 		{
-			::std::vector<Neighbor> neighbors = this->graph[::boost::graph_bundle].nn->nearest(Metric::Value(this->graph[v].q.get(), v), this->k);
+			Hash hash;
+			
+			::std::uint64_t dof = this->getModel()->getDofPosition();
+			hash.combine(&dof, sizeof(dof));
+			
+			::rl::math::Vector minimum = this->getModel()->getMinimum();
+			hash.combine(minimum.data(), minimum.size() * sizeof(::rl::math::Real));
+			
+			::rl::math::Vector maximum = this->getModel()->getMaximum();
+			hash.combine(maximum.data(), maximum.size() * sizeof(::rl::math::Real));
+			
+			::Eigen::Matrix<bool, ::Eigen::Dynamic, 1> wraparounds = this->getModel()->getWraparounds();
+			hash.combine(wraparounds.data(), wraparounds.size() * sizeof(bool));
+			
+			// kinematic parameters and collision flags via body frames in reference configuration
+			::rl::math::Vector q(this->getModel()->getDofPosition());
 			
-			for (::std::size_t i = 0; i < neighbors.size() && ::boost::degree(v, this->graph) < this->degree; ++i)
+			if (nullptr != this->getModel()->kin)
 			{
-				Vertex u = neighbors[i].second.second;
+				this->getModel()->kin->getPosition(q);
+			}
+			else
+			{
+				q = this->getModel()->mdl->getPosition();
+			}
+			
+			this->getModel()->setPosition(this->getModel()->generatePositionUniform(::rl::math::Vector::Constant(this->getModel()->getDof(), static_cast<::rl::math::Real>(0.5))));
+			this->getModel()->updateFrames(false);
+			
+			for (::std::size_t i = 0; i < this->getModel()->getBodies(); ++i)
+			{
+				const ::rl::math::Transform& frame = this->getModel()->getFrame(i);
+				hash.combine(frame);
 				
-				if (::boost::degree(u, this->graph) < this->degree)
+				bool collision = this->getModel()->isColliding(i);
+				hash.combine(&collision, sizeof(collision));
+				
+				for (::std::size_t j = 0; j < i; ++j)
 				{
-					::rl::math::Real d = this->graph[::boost::graph_bundle].nn->isTransformedDistance() ? this->getModel()->inverseOfTransformedDistance(neighbors[i].first) : neighbors[i].first;
+					bool selfCollision = this->getModel()->areColliding(i, j);
+					hash.combine(&selfCollision, sizeof(selfCollision));
+				}
+			}
+			
+			this->getModel()->setPosition(q);
+			this->getModel()->updateFrames(false);
+			
+			if (nullptr != this->getModel()->scene)
+			{
+				for (::std::size_t i = 0; i < this->getModel()->scene->getNumModels(); ++i)
+				{
+					::rl::sg::Model* model = this->getModel()->scene->getModel(i);
 					
-					if (d < this->radius)
+					::std::uint64_t bodies = model->getNumBodies();
+					hash.combine(&bodies, sizeof(bodies));
+					
+					for (::std::size_t j = 0; j < model->getNumBodies(); ++j)
 					{
-						if (!::boost::same_component(u, v, this->ds))
+						// frames of robot bodies depend on current configuration
+						if (model != this->getModel()->model)
 						{
-							if (!this->verifier->isColliding(*this->graph[u].q, *this->graph[v].q, d))
-							{
-								this->addEdge(u, v, d);
-							}
+							::rl::math::Transform frame = model->getBody(j)->getFrame();
+							hash.combine(frame);
 						}
+						
+						hash.combine(model->getBody(j));
 					}
 				}
 			}
 			
+			return hash.get();
+		}
+		
+		void
+		Prm::insert(const Vertex& v)
+		{
+			this->connect(v);
+			
+			Profiler::Scope scope(this->profiler, Profiler::Counter::insertion);
 			this->graph[::boost::graph_bundle].nn->push(Metric::Value(this->graph[v].q.get(), v));
 		}
 		
+		bool
+		Prm::intersects(const Box& box, const ::std::vector<Box>& boxes)
+		{
+			for (::std::size_t i = 0; i < boxes.size(); ++i)
+			{
+				if (box.intersects(boxes[i]))
+				{
+					return true;
+				}
+			}
+			
+			return false;
+		}
+		
+		void
+		Prm::load(const ::std::string& filename)
+		{
+			::boost::interprocess::file_mapping file;
+			::boost::interprocess::mapped_region region;
+			
+			try
+			{
+				file = ::boost::interprocess::file_mapping(filename.c_str(), ::boost::interprocess::read_only);
+				region = ::boost::interprocess::mapped_region(file, ::boost::interprocess::read_only);
+			}
+			catch (const ::boost::interprocess::interprocess_exception&)
+			{
+				throw Exception("rl::plan::Prm::load() - Failed to open file '" + filename + "'");
+			}
+			
+			const char* data = static_cast<const char*>(region.get_address());
+			
+			RoadmapHeader header;
+			
+			if (region.get_size() < sizeof(header))
+			{
+				throw Exception("rl::plan::Prm::load() - File '" + filename + "' is not a roadmap");
+			}
+			
+			::std::memcpy(&header, data, sizeof(header));
+			
+			if (0 != ::std::memcmp(header.magic, ROADMAP_MAGIC, sizeof(header.magic)))
+			{
+				throw Exception("rl::plan::Prm::load() - File '" + filename + "' is not a roadmap");
+			}
+			
+			if (ROADMAP_VERSION != header.version)
+			{
+				throw Exception("rl::plan::Prm::load() - Unsupported roadmap version in file '" + filename + "'");
+			}
+			
+			if (sizeof(::rl::math::Real) != header.real || this->getModel()->getDofPosition() != header.dof || this->hash() != header.hash)
+			{
+				throw Exception("rl::plan::Prm::load() - Roadmap in file '" + filename + "' does not match model and scene");
+			}
+			
+			if (region.get_size() != sizeof(header) + header.vertices * (header.dof * sizeof(::rl::math::Real) + sizeof(::std::uint64_t)) + header.edges * sizeof(RoadmapEdge))
+			{
+				throw Exception("rl::plan::Prm::load() - Roadmap in file '" + filename + "' is truncated");
+			}
+			
+			const ::rl::math::Real* q = reinterpret_cast<const ::rl::math::Real*>(data + sizeof(header));
+			const ::std::uint64_t* components = reinterpret_cast<const ::std::uint64_t*>(q + header.vertices * header.dof);
+			const RoadmapEdge* edges = reinterpret_cast<const RoadmapEdge*>(components + header.vertices);
+			
+			this->reset();
+			
+			::std::vector<Vertex> vertices(header.vertices);
+			::std::vector<Vertex> representatives(header.vertices, nullptr);
+			::std::vector<NearestNeighbors::Value> values(header.vertices);
+			
+			for (::std::size_t i = 0; i < header.vertices; ++i)
+			{
+				vertices[i] = this->addVertex(this->pool.allocate(::Eigen::Map<const ::rl::math::Vector>(q + i * header.dof, header.dof)));
+				values[i] = Metric::Value(this->graph[vertices[i]].q.get(), vertices[i]);
+				
+				if (components[i] >= header.vertices)
+				{
+					this->reset();
+					throw Exception("rl::plan::Prm::load() - Roadmap in file '" + filename + "' is corrupt");
+				}
+				
+				if (nullptr == representatives[components[i]])
+				{
+					representatives[components[i]] = vertices[i];
+				}
+				else
+				{
+					this->ds.union_set(representatives[components[i]], vertices[i]);
+				}
+			}
+			
+			for (::std::size_t i = 0; i < header.edges; ++i)
+			{
+				if (edges[i].u >= header.vertices || edges[i].v >= header.vertices)
+				{
+					this->reset();
+					throw Exception("rl::plan::Prm::load() - Roadmap in file '" + filename + "' is corrupt");
+				}
+				
+				Edge e = ::boost::add_edge(vertices[edges[i].u], vertices[edges[i].v], this->graph).first;
+				this->graph[e].verified = true;
+				this->graph[e].weight = edges[i].weight;
+				
+				if (nullptr != this->getViewer())
+				{
+					Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+					
+					this->getViewer()->drawConfigurationEdge(*this->graph[vertices[edges[i].u]].q, *this->graph[vertices[edges[i].v]].q);
+				}
+			}
+			
+			this->graph[::boost::graph_bundle].nn->insert(values);
+		}
+		
+		void
+		Prm::repair(const ::std::vector<::rl::sg::Body*>& bodies)
+		{
+			this->getModel()->updatePairs();
+			this->getModel()->clearCache();
+			
+			::std::vector<Box> boxes;
+			
+			for (::std::size_t i = 0; i < bodies.size(); ++i)
+			{
+				boxes.push_back(Prm::computeBox(bodies[i], bodies[i]->getFrame()));
+			}
+			
+			::std::vector<Vertex> removed;
+			
+			for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
+			{
+				VertexBundle& vertex = this->graph[*i.first];
+				
+				if (vertex.box.isEmpty())
+				{
+					vertex.box = this->computeBox(*vertex.q);
+				}
+				
+				if (Prm::intersects(vertex.box, boxes) && this->getModel()->isColliding(*vertex.q))
+				{
+					removed.push_back(*i.first);
+				}
+			}
+			
+			for (EdgeIteratorPair i = ::boost::edges(this->graph); i.first != i.second; ++i.first)
+			{
+				EdgeBundle& edge = this->graph[*i.first];
+				
+				if (edge.verified)
+				{
+					if (edge.box.isEmpty())
+					{
+						edge.box = this->computeBox(*i.first);
+					}
+					
+					if (Prm::intersects(edge.box, boxes))
+					{
+						edge.verified = false;
+					}
+				}
+			}
+			
+			::std::sort(removed.begin(), removed.end());
+			
+			::std::vector<Vertex> neighbors;
+			
+			for (::std::size_t i = 0; i < removed.size(); ++i)
+			{
+				for (::boost::graph_traits<Graph>::adjacency_iterator j = ::boost::adjacent_vertices(removed[i], this->graph).first; j != ::boost::adjacent_vertices(removed[i], this->graph).second; ++j)
+				{
+					if (!::std::binary_search(removed.begin(), removed.end(), *j))
+					{
+						neighbors.push_back(*j);
+					}
+				}
+			}
+			
+			::std::sort(neighbors.begin(), neighbors.end());
+			neighbors.erase(::std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+			
+			for (::std::size_t i = 0; i < removed.size(); ++i)
+			{
+				::boost::clear_vertex(removed[i], this->graph);
+				::boost::remove_vertex(removed[i], this->graph);
+				
+				if (removed[i] == this->begin)
+				{
+					this->begin = nullptr;
+				}
+				
+				if (removed[i] == this->end)
+				{
+					this->end = nullptr;
+				}
+			}
+			
+			this->updateComponents();
+			
+			if (!removed.empty())
+			{
+				::std::vector<NearestNeighbors::Value> values;
+				values.reserve(::boost::num_vertices(this->graph));
+				
+				for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
+				{
+					values.push_back(Metric::Value(this->graph[*i.first].q.get(), *i.first));
+				}
+				
+				this->graph[::boost::graph_bundle].nn->clear();
+				this->graph[::boost::graph_bundle].nn->insert(values);
+			}
+			
+			if (nullptr != this->getViewer())
+			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
+				this->getViewer()->resetEdges();
+				this->getViewer()->resetVertices();
+				
+				for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
+				{
+					this->getViewer()->drawConfigurationVertex(*this->graph[*i.first].q);
+				}
+				
+				for (EdgeIteratorPair i = ::boost::edges(this->graph); i.first != i.second; ++i.first)
+				{
+					this->getViewer()->drawConfigurationEdge(*this->graph[::boost::source(*i.first, this->graph)].q, *this->graph[::boost::target(*i.first, this->graph)].q);
+				}
+			}
+			
+			for (::std::size_t i = 0; i < neighbors.size(); ++i)
+			{
+				this->connect(neighbors[i]);
+			}
+		}
+		
 		void
 		Prm::reset()
 		{
 			this->graph.clear();
 			this->graph[::boost::graph_bundle].nn->clear();
+			this->pool.clear();
 			this->begin = nullptr;
 			this->end = nullptr;
 		}
 		
+		void
+		Prm::save(const ::std::string& filename)
+		{
+			::std::ofstream file(filename.c_str(), ::std::ios::binary);
+			
+			if (!file)
+			{
+				throw Exception("rl::plan::Prm::save() - Failed to open file '" + filename + "'");
+			}
+			
+			RoadmapHeader header;
+			::std::memset(&header, 0, sizeof(header));
+			::std::memcpy(header.magic, ROADMAP_MAGIC, sizeof(header.magic));
+			header.version = ROADMAP_VERSION;
+			header.dof = this->getModel()->getDofPosition();
+			header.hash = this->hash();
+			header.vertices = ::boost::num_vertices(this->graph);
+			header.edges = ::boost::num_edges(this->graph);
+			header.real = sizeof(::rl::math::Real);
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			
+			::std::vector<Vertex> vertices(header.vertices);
+			
+			for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
+			{
+				vertices[this->graph[*i.first].index] = *i.first;
+			}
+			
+			for (::std::size_t i = 0; i < vertices.size(); ++i)
+			{
+				file.write(reinterpret_cast<const char*>(this->graph[vertices[i]].q->data()), header.dof * sizeof(::rl::math::Real));
+			}
+			
+			for (::std::size_t i = 0; i < vertices.size(); ++i)
+			{
+				::std::uint64_t component = this->graph[this->ds.find_set(vertices[i])].index;
+				file.write(reinterpret_cast<const char*>(&component), sizeof(component));
+			}
+			
+			for (EdgeIteratorPair i = ::boost::edges(this->graph); i.first != i.second; ++i.first)
+			{
+				RoadmapEdge edge;
+				::std::memset(&edge, 0, sizeof(edge));
+				edge.u = this->graph[::boost::source(*i.first, this->graph)].index;
+				edge.v = this->graph[::boost::target(*i.first, this->graph)].index;
+				edge.weight = this->graph[*i.first].weight;
+				file.write(reinterpret_cast<const char*>(&edge), sizeof(edge));
+			}
+			
+			if (!file)
+			{
+				throw Exception("rl::plan::Prm::save() - Failed to write file '" + filename + "'");
+			}
+		}
+		
+		void
+		Prm::setBatchSize(const ::std::size_t& batchSize)
+		{
+			this->batchSize = batchSize;
+		}
+		
 		void
 		Prm::setMaxDegree(const ::std::size_t& degree)
 		{
@@ -279,61 +868,129 @@ namespace rl
 		bool
 		Prm::solve()
 		{
-			this->time = ::std::chrono::steady_clock::now();
+			this->initialize();
 			
-			this->begin = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->getStart()));
+			this->begin = this->addVertex(this->pool.allocate(*this->getStart()));
 			this->insert(this->begin);
 			
-			this->end = this->addVertex(::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->end = this->addVertex(this->pool.allocate(*this->getGoal()));
 			this->insert(this->end);
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration() && !::boost::same_component(this->begin, this->end, this->ds))
+			do
 			{
-				this->construct(1);
+				while (this->proceed() && !::boost::same_component(this->begin, this->end, this->ds))
+				{
+					this->construct(this->batchSize);
+				}
+				
+				if (!::boost::same_component(this->begin, this->end, this->ds))
+				{
+					return false;
+				}
+				
+				if (this->astar)
+				{
+					::boost::astar_search(
+						this->graph,
+						this->begin,
+						AStarHeuristic(this->getModel(), this->graph, this->end),
+						::boost::default_astar_visitor(),
+						::boost::get(&VertexBundle::predecessor, this->graph),
+						::boost::get(&VertexBundle::cost, this->graph),
+						::boost::get(&VertexBundle::distance, this->graph),
+						::boost::get(&EdgeBundle::weight, this->graph),
+						::boost::get(&VertexBundle::index, this->graph),
+						::boost::get(&VertexBundle::color, this->graph),
+						::std::less<::rl::math::Real>(),
+						::std::plus<::rl::math::Real>(),
+						::std::numeric_limits<::rl::math::Real>::max(),
+						0
+					);
+				}
+				else
+				{
+					::boost::dijkstra_shortest_paths(
+						this->graph,
+						this->begin,
+						::boost::get(&VertexBundle::predecessor, this->graph),
+						::boost::get(&VertexBundle::distance, this->graph),
+						::boost::get(&EdgeBundle::weight, this->graph),
+						::boost::get(&VertexBundle::index, this->graph),
+						::std::less<::rl::math::Real>(),
+						::boost::closed_plus<::rl::math::Real>(),
+						::std::numeric_limits<::rl::math::Real>::max(),
+						0,
+						::boost::default_dijkstra_visitor()
+					);
+				}
 			}
+			while (!this->verifyPath());
 			
-			if (!::boost::same_component(this->begin, this->end, this->ds))
+			return true;
+		}
+		
+		void
+		Prm::updateComponents()
+		{
+			::std::size_t index = 0;
+			
+			for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
 			{
-				return false;
+				this->graph[*i.first].index = index++;
+				this->ds.make_set(*i.first);
 			}
 			
-			if (this->astar)
+			for (EdgeIteratorPair i = ::boost::edges(this->graph); i.first != i.second; ++i.first)
 			{
-				::boost::astar_search(
-					this->graph,
-					this->begin,
-					AStarHeuristic(this->getModel(), this->graph, this->end),
-					::boost::default_astar_visitor(),
-					::boost::get(&VertexBundle::predecessor, this->graph),
-					::boost::get(&VertexBundle::cost, this->graph),
-					::boost::get(&VertexBundle::distance, this->graph),
-					::boost::get(&EdgeBundle::weight, this->graph),
-					::boost::get(&VertexBundle::index, this->graph),
-					::boost::get(&VertexBundle::color, this->graph),
-					::std::less<::rl::math::Real>(),
-					::std::plus<::rl::math::Real>(),
-					::std::numeric_limits<::rl::math::Real>::max(),
-					0
-				);
+				this->ds.union_set(::boost::source(*i.first, this->graph), ::boost::target(*i.first, this->graph));
 			}
-			else
+		}
+		
+		bool
+		Prm::verifyPath()
+		{
+			::std::vector<Vertex> endpoints;
+			
+			for (Vertex v = this->end; v != this->begin; v = this->graph[v].predecessor)
+			{
+				Vertex u = this->graph[v].predecessor;
+				Edge e = ::boost::edge(u, v, this->graph).first;
+				
+				if (!this->graph[e].verified)
+				{
+					bool colliding;
+					
+					{
+						Profiler::Scope scope(this->profiler, Profiler::Counter::verification);
+						colliding = this->verifier->isColliding(*this->graph[u].q, *this->graph[v].q, this->graph[e].weight);
+					}
+					
+					if (colliding)
+					{
+						::boost::remove_edge(e, this->graph);
+						endpoints.push_back(u);
+						endpoints.push_back(v);
+					}
+					else
+					{
+						this->graph[e].verified = true;
+					}
+				}
+			}
+			
+			if (endpoints.empty())
 			{
-				::boost::dijkstra_shortest_paths(
-					this->graph,
-					this->begin,
-					::boost::get(&VertexBundle::predecessor, this->graph),
-					::boost::get(&VertexBundle::distance, this->graph),
-					::boost::get(&EdgeBundle::weight, this->graph),
-					::boost::get(&VertexBundle::index, this->graph),
-					::std::less<::rl::math::Real>(),
-					::boost::closed_plus<::rl::math::Real>(),
-					::std::numeric_limits<::rl::math::Real>::max(),
-					0,
-					::boost::default_dijkstra_visitor()
-				);
+				return true;
 			}
 			
-			return true;
+			this->updateComponents();
+			
+			for (::std::size_t i = 0; i < endpoints.size(); ++i)
+			{
+				this->connect(endpoints[i]);
+			}
+			
+			return false;
 		}
 		
 		Prm::AStarHeuristic::AStarHeuristic(const Model* model, const Graph& graph, const Vertex& goal) :
@@ -27,9 +27,12 @@
 #ifndef RL_PLAN_PRM_H
 #define RL_PLAN_PRM_H
 
+#include <cstdint>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/astar_search.hpp>
 #include <boost/pending/disjoint_sets.hpp>
+#include <rl/math/AlignedBox.h>
+#include <rl/math/Transform.h>
 
 #include "Metric.h"
 #include "NearestNeighbors.h"
@@ -38,6 +41,11 @@
 
 namespace rl
 {
+	namespace sg
+	{
+		class Body;
+	}
+	
 	namespace plan
 	{
 		class Model;
@@ -76,6 +84,8 @@ namespace rl
 			
 			virtual void construct(const ::std::size_t& steps);
 			
+			::std::size_t getBatchSize() const;
+			
 			::std::size_t getMaxDegree() const;
 			
 			::std::size_t getMaxNeighbors() const;
@@ -90,6 +100,8 @@ namespace rl
 			
 			::std::size_t getNumVertices() const;
 			
+			VectorList getPartialPath();
+			
 			VectorList getPath();
 			
 			Sampler* getSampler() const;
@@ -98,8 +110,47 @@ namespace rl
 			
 			Verifier* getVerifier() const;
 			
+			/**
+			 * Load roadmap from binary file written by save().
+			 *
+			 * The file is memory-mapped and the nearest neighbors index is
+			 * rebuilt by bulk insertion. Throws an Exception if the roadmap was
+			 * saved for a different model or scene.
+			 */
+			void load(const ::std::string& filename);
+			
+			/**
+			 * Repair roadmap after bodies were added to or moved in the scene.
+			 *
+			 * Only vertices and edges whose cached workspace bounding boxes
+			 * intersect the given bodies are invalidated. Colliding vertices are
+			 * removed and their neighbors connected again, invalidated edges are
+			 * verified lazily once they are part of a solution path. Removing
+			 * bodies does not invalidate the roadmap.
+			 */
+			void repair(const ::std::vector<::rl::sg::Body*>& bodies);
+			
 			void reset();
 			
+			/**
+			 * Save roadmap to binary file.
+			 *
+			 * Stores a versioned header with a hash of model and scene, followed
+			 * by flat arrays of configurations, connected components, and
+			 * weighted edges in native byte order.
+			 */
+			void save(const ::std::string& filename);
+			
+			/**
+			 * Set number of samples added per step of solve().
+			 *
+			 * Samples of a step are generated with one call of
+			 * Sampler::generateCollisionFree(), which distributes collision
+			 * checks over threads if the sampler has per-thread models. Time and
+			 * cancel requests are checked between steps.
+			 */
+			void setBatchSize(const ::std::size_t& batchSize);
+			
 			void setMaxDegree(const ::std::size_t& degree);
 			
 			void setMaxNeighbors(const ::std::size_t& k);
@@ -118,6 +169,9 @@ namespace rl
 			
 			bool astar;
 			
+			/** Number of samples added per step of solve(). */
+			::std::size_t batchSize;
+			
 			/** Maximum degree per vertex. */
 			::std::size_t degree;
 			
@@ -132,8 +186,15 @@ namespace rl
 			Verifier* verifier;
 			
 		protected:
+			typedef ::rl::math::AlignedBox<::rl::math::Real, 3> Box;
+			
 			struct EdgeBundle
 			{
+				/** Workspace bounding box swept by robot, computed on demand. */
+				Box box;
+				
+				bool verified;
+				
 				::rl::math::Real weight;
 			};
 			
@@ -148,6 +209,9 @@ namespace rl
 			
 			struct VertexBundle
 			{
+				/** Workspace bounding box of robot, computed on demand. */
+				Box box;
+				
 				::boost::default_color_type color;
 				
 				::rl::math::Real cost;
@@ -216,8 +280,52 @@ namespace rl
 			
 			Vertex addVertex(const VectorPtr& q);
 			
+			Box computeBox(const ::rl::math::Vector& q);
+			
+			Box computeBox(const Edge& e);
+			
+			/**
+			 * Connect vertex to nearest neighbors in other components.
+			 */
+			void connect(const Vertex& v);
+			
+			/**
+			 * Hash of model and static scene.
+			 *
+			 * Covers joint limits and wraparounds, body frames in a reference
+			 * configuration, collision flags, and frames, names, bounding boxes,
+			 * points, and shape transforms of all bodies. Geometry of shapes
+			 * is only covered via bounding boxes and points of bodies, i.e., if
+			 * loaded with these enabled.
+			 *
+			 * Used for rejecting roadmaps saved for a different setup.
+			 *
+			 * Moves the kinematics of the model to the reference configuration
+			 * and restores its position afterwards, body frames in the scene
+			 * are not modified. Must not be called during queries on the same
+			 * model.
+			 */
+			virtual ::std::uint64_t hash();
+			
 			void insert(const Vertex& vertex);
 			
+			/**
+			 * Renumber vertices and recompute connected components.
+			 *
+			 * Needed after removing vertices or edges, as disjoint sets cannot
+			 * be split.
+			 */
+			void updateComponents();
+			
+			/**
+			 * Verify edges of current solution path that were invalidated.
+			 *
+			 * Colliding edges are removed.
+			 *
+			 * @return True if all edges of the path are collision-free.
+			 */
+			bool verifyPath();
+			
 			Vertex begin;
 			
 			::boost::disjoint_sets<VertexRankMap, VertexParentMap> ds;
@@ -227,7 +335,13 @@ namespace rl
 			Graph graph;
 			
 		private:
+			struct RoadmapEdge;
+			
+			struct RoadmapHeader;
+			
+			static Box computeBox(const ::rl::sg::Body* body, const ::rl::math::Transform& frame);
 			
+			static bool intersects(const Box& box, const ::std::vector<Box>& boxes);
 		};
 	}
 }
@@ -29,6 +29,7 @@
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 #include <boost/graph/incremental_components.hpp>
 
+#include "Profiler.h"
 #include "PrmUtilityGuided.h"
 #include "Sampler.h"
 #include "SimpleModel.h"
@@ -94,7 +95,7 @@ namespace rl
 				{
 					// store the sample in the graph
 					bestSample.isColliding = false;
-					Vertex v = this->addVertex(::std::make_shared<::rl::math::Vector>(bestSample.q));
+					Vertex v = this->addVertex(this->pool.allocate(bestSample.q));
 					this->insert(v);
 				}
 				
@@ -106,6 +107,8 @@ namespace rl
 		void
 		PrmUtilityGuided::generateEntropyGuidedSample(::rl::math::Vector& q)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::sampling);
+			
 			// indices for two random vertices
 			// the first sample uses the start or the end component
 #ifdef ORIGINAL_VERSION
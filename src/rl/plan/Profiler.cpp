@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "Profiler.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		const ::std::size_t Profiler::COUNTERS;
+		
+		Profiler::Profiler() :
+			calls(),
+			durations()
+		{
+			this->reset();
+		}
+		
+		Profiler::~Profiler()
+		{
+		}
+		
+		void
+		Profiler::add(const Counter& counter, const ::std::chrono::steady_clock::duration& duration)
+		{
+			this->calls[static_cast<::std::size_t>(counter)].fetch_add(1, ::std::memory_order_relaxed);
+			this->durations[static_cast<::std::size_t>(counter)].fetch_add(duration.count(), ::std::memory_order_relaxed);
+		}
+		
+		::std::size_t
+		Profiler::getCalls(const Counter& counter) const
+		{
+			return this->calls[static_cast<::std::size_t>(counter)].load(::std::memory_order_relaxed);
+		}
+		
+		::std::chrono::steady_clock::duration
+		Profiler::getDuration(const Counter& counter) const
+		{
+			return ::std::chrono::steady_clock::duration(this->durations[static_cast<::std::size_t>(counter)].load(::std::memory_order_relaxed));
+		}
+		
+		::std::string
+		Profiler::getName(const Counter& counter)
+		{
+			switch (counter)
+			{
+			case Counter::collision:
+				return "collision";
+			case Counter::insertion:
+				return "insertion";
+			case Counter::nearestNeighbors:
+				return "nearestNeighbors";
+			case Counter::sampling:
+				return "sampling";
+			case Counter::verification:
+				return "verification";
+			case Counter::viewer:
+				return "viewer";
+			default:
+				return ::std::string();
+			}
+		}
+		
+		bool
+		Profiler::isEnabled()
+		{
+#ifdef RL_PLAN_PROFILER
+			return true;
+#else // RL_PLAN_PROFILER
+			return false;
+#endif // RL_PLAN_PROFILER
+		}
+		
+		void
+		Profiler::reset()
+		{
+			for (::std::size_t i = 0; i < COUNTERS; ++i)
+			{
+				this->calls[i].store(0, ::std::memory_order_relaxed);
+				this->durations[i].store(0, ::std::memory_order_relaxed);
+			}
+		}
+	}
+}
@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_PROFILER_H
+#define RL_PLAN_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <rl/plan/export.h>
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Call counts and accumulated durations of planner operations.
+		 *
+		 * Operations are only recorded if the library is built with
+		 * RL_PLAN_PROFILER defined, otherwise Scope compiles to nothing.
+		 * Counters are atomic, so a profiler may be shared by several
+		 * models used in parallel. Durations of nested operations are
+		 * inclusive, e.g., sampling collision-free configurations includes
+		 * the collision queries and insertion includes viewer callbacks.
+		 */
+		class RL_PLAN_EXPORT Profiler
+		{
+		public:
+			enum class Counter
+			{
+				/** Collision queries of SimpleModel::isColliding(). */
+				collision,
+				/** Insertion of vertices into graph and nearest neighbors. */
+				insertion,
+				/** Nearest neighbor queries of planner. */
+				nearestNeighbors,
+				/** Sampling of configurations. */
+				sampling,
+				/** Edge verification with Verifier. */
+				verification,
+				/** Viewer callbacks. */
+				viewer
+			};
+			
+			/**
+			 * Records one call and its duration until destruction.
+			 */
+			class Scope
+			{
+			public:
+				Scope(Profiler* profiler, const Counter& counter)
+#ifdef RL_PLAN_PROFILER
+					:
+					counter(counter),
+					profiler(profiler),
+					time(nullptr != profiler ? ::std::chrono::steady_clock::now() : ::std::chrono::steady_clock::time_point())
+#endif // RL_PLAN_PROFILER
+				{
+				}
+				
+				Scope(const Scope&) = delete;
+				
+				~Scope()
+				{
+#ifdef RL_PLAN_PROFILER
+					if (nullptr != this->profiler)
+					{
+						this->profiler->add(this->counter, ::std::chrono::steady_clock::now() - this->time);
+					}
+#endif // RL_PLAN_PROFILER
+				}
+				
+				Scope& operator=(const Scope&) = delete;
+				
+			protected:
+				
+			private:
+#ifdef RL_PLAN_PROFILER
+				Counter counter;
+				
+				Profiler* profiler;
+				
+				::std::chrono::steady_clock::time_point time;
+#endif // RL_PLAN_PROFILER
+			};
+			
+			Profiler();
+			
+			virtual ~Profiler();
+			
+			void add(const Counter& counter, const ::std::chrono::steady_clock::duration& duration);
+			
+			::std::size_t getCalls(const Counter& counter) const;
+			
+			::std::chrono::steady_clock::duration getDuration(const Counter& counter) const;
+			
+			static ::std::string getName(const Counter& counter);
+			
+			/**
+			 * Check if library was built with profiling support.
+			 */
+			static bool isEnabled();
+			
+			void reset();
+			
+			static const ::std::size_t COUNTERS = 6;
+			
+		protected:
+			
+		private:
+			::std::array<::std::atomic<::std::size_t>, COUNTERS> calls;
+			
+			::std::array<::std::atomic<::std::chrono::steady_clock::rep>, COUNTERS> durations;
+		};
+	}
+}
+
+#endif // RL_PLAN_PROFILER_H
@@ -24,6 +24,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <limits>
+
+#include "Profiler.h"
 #include "Rrt.h"
 #include "Sampler.h"
 #include "SimpleModel.h"
@@ -51,10 +54,14 @@ namespace rl
 		Rrt::Edge
 		Rrt::addEdge(const Vertex& u, const Vertex& v, Tree& tree)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::insertion);
+			
 			Edge e = ::boost::add_edge(u, v, tree).first;
 			
 			if (nullptr != this->getViewer())
 			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
 				this->getViewer()->drawConfigurationEdge(*get(tree, u)->q, *get(tree, v)->q);
 			}
 			
@@ -64,6 +71,8 @@ namespace rl
 		Rrt::Vertex
 		Rrt::addVertex(Tree& tree, const VectorPtr& q)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::insertion);
+			
 			::std::shared_ptr<VertexBundle> bundle = ::std::make_shared<VertexBundle>();
 			bundle->index = ::boost::num_vertices(tree) - 1;
 			bundle->q = q;
@@ -75,6 +84,8 @@ namespace rl
 			
 			if (nullptr != this->getViewer())
 			{
+				Profiler::Scope scope(this->profiler, Profiler::Counter::viewer);
+				
 				this->getViewer()->drawConfigurationVertex(*get(tree, v)->q);
 			}
 			
@@ -97,6 +108,8 @@ namespace rl
 		::rl::math::Vector
 		Rrt::choose()
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::sampling);
+			
 			return this->sampler->generate();
 		}
 		
@@ -117,7 +130,7 @@ namespace rl
 				step = this->delta;
 			}
 			
-			VectorPtr last = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
+			VectorPtr last = this->pool.allocate(this->getModel()->getDofPosition());
 			
 			this->getModel()->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, *last);
 			
@@ -128,6 +141,7 @@ namespace rl
 			
 			if (this->getModel()->isColliding(*last))
 			{
+				this->pool.deallocate(last);
 				return nullptr;
 			}
 			
@@ -169,7 +183,7 @@ namespace rl
 			::rl::math::Real distance = nearest.first;
 			::rl::math::Real step = ::std::min(distance, this->delta);
 			
-			VectorPtr next = ::std::make_shared<::rl::math::Vector>(this->getModel()->getDofPosition());
+			VectorPtr next = this->pool.allocate(this->getModel()->getDofPosition());
 			
 			this->getModel()->interpolate(*get(tree, nearest.second)->q, chosen, step / distance, *next);
 			
@@ -180,6 +194,8 @@ namespace rl
 				return extended;
 			}
 			
+			this->pool.deallocate(next);
+			
 			return nullptr;
 		}
 		
@@ -239,6 +255,46 @@ namespace rl
 			return vertices;
 		}
 		
+		VectorList
+		Rrt::getPartialPath()
+		{
+			if (nullptr != this->end[0])
+			{
+				return this->getPath();
+			}
+			
+			VectorList path;
+			
+			if (nullptr == this->begin[0])
+			{
+				return path;
+			}
+			
+			Vertex i = this->begin[0];
+			::rl::math::Real distance = ::std::numeric_limits<::rl::math::Real>::infinity();
+			
+			for (VertexIteratorPair j = ::boost::vertices(this->tree[0]); j.first != j.second; ++j.first)
+			{
+				::rl::math::Real d = this->getModel()->distance(*get(this->tree[0], *j.first)->q, *this->getGoal());
+				
+				if (d < distance)
+				{
+					distance = d;
+					i = *j.first;
+				}
+			}
+			
+			while (::boost::in_degree(i, this->tree[0]) > 0)
+			{
+				path.push_front(*get(this->tree[0], i)->q);
+				i = ::boost::source(*::boost::in_edges(i, this->tree[0]).first, this->tree[0]);
+			}
+			
+			path.push_front(*get(this->tree[0], i)->q);
+			
+			return path;
+		}
+		
 		VectorList
 		Rrt::getPath()
 		{
@@ -266,6 +322,8 @@ namespace rl
 		Rrt::Neighbor
 		Rrt::nearest(const Tree& tree, const ::rl::math::Vector& chosen)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::nearestNeighbors);
+			
 			::std::vector<NearestNeighbors::Neighbor> neighbors = tree[::boost::graph_bundle].nn->nearest(Metric::Value(&chosen, Vertex()), 1);
 			return Neighbor(
 				tree[::boost::graph_bundle].nn->isTransformedDistance() ? this->getModel()->inverseOfTransformedDistance(neighbors.front().first) : neighbors.front().first,
@@ -283,6 +341,8 @@ namespace rl
 				this->begin[i] = nullptr;
 				this->end[i] = nullptr;
 			}
+			
+			this->pool.clear();
 		}
 		void
 		Rrt::setDelta(const ::rl::math::Real& delta)
@@ -311,11 +371,11 @@ namespace rl
 		bool
 		Rrt::solve()
 		{
-			this->time = ::std::chrono::steady_clock::now();
+			this->initialize();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
+			this->begin[0] = this->addVertex(this->tree[0], this->pool.allocate(*this->getStart()));
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration())
+			while (this->proceed())
 			{
 				::rl::math::Vector chosen = this->choose();
 				Neighbor nearest = this->nearest(this->tree[0], chosen);
@@ -70,6 +70,8 @@ namespace rl
 			
 			virtual ::std::size_t getNumVertices() const;
 			
+			virtual VectorList getPartialPath();
+			
 			virtual VectorList getPath();
 			
 			Sampler* getSampler() const;
@@ -77,12 +77,12 @@ namespace rl
 		bool
 		RrtDual::solve()
 		{
-			this->time = ::std::chrono::steady_clock::now();
+			this->initialize();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->begin[0] = this->addVertex(this->tree[0], this->pool.allocate(*this->getStart()));
+			this->begin[1] = this->addVertex(this->tree[1], this->pool.allocate(*this->getGoal()));
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration())
+			while (this->proceed())
 			{
 				::rl::math::Vector chosen = this->choose();
 				Neighbor nearest = this->nearest(this->tree[0], chosen);
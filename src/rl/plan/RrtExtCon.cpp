@@ -49,15 +49,15 @@ namespace rl
 		bool
 		RrtExtCon::solve()
 		{
-			this->time = ::std::chrono::steady_clock::now();
+			this->initialize();
 			
-			this->begin[0] = this->addVertex(this->tree[0], ::std::make_shared<::rl::math::Vector>(*this->getStart()));
-			this->begin[1] = this->addVertex(this->tree[1], ::std::make_shared<::rl::math::Vector>(*this->getGoal()));
+			this->begin[0] = this->addVertex(this->tree[0], this->pool.allocate(*this->getStart()));
+			this->begin[1] = this->addVertex(this->tree[1], this->pool.allocate(*this->getGoal()));
 			
 			Tree* a = &this->tree[0];
 			Tree* b = &this->tree[1];
 			
-			while ((::std::chrono::steady_clock::now() - this->time) < this->getDuration())
+			while (this->proceed())
 			{
 				for (::std::size_t j = 0; j < 2; ++j)
 				{
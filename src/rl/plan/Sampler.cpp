@@ -32,7 +32,8 @@ namespace rl
 	namespace plan
 	{
 		Sampler::Sampler() :
-			model(nullptr)
+			model(nullptr),
+			models()
 		{
 		}
 		
@@ -54,16 +55,87 @@ namespace rl
 			return q;
 		}
 		
+		::std::vector<::rl::math::Vector>
+		Sampler::generateCollisionFree(const ::std::size_t& n)
+		{
+			::std::vector<::rl::math::Vector> samples;
+			samples.reserve(n);
+			
+			::std::vector<::rl::math::Vector> candidates;
+			::std::vector<unsigned char> results;
+			
+			while (samples.size() < n)
+			{
+				candidates.resize(n - samples.size());
+				
+				for (::std::size_t i = 0; i < candidates.size(); ++i)
+				{
+					candidates[i] = this->generate();
+				}
+				
+				results.assign(candidates.size(), 0);
+				
+				this->models.begin();
+				
+#ifdef _OPENMP
+				int threads = this->models.getThreads();
+				
+#pragma omp parallel num_threads(threads) if (threads > 1)
+#endif
+				{
+					SimpleModel* model = this->models.getModel(this->getModel());
+					
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#if _OPENMP < 200805
+					for (::std::ptrdiff_t i = 0; i < candidates.size(); ++i)
+#else
+					for (::std::size_t i = 0; i < candidates.size(); ++i)
+#endif
+#else
+					for (::std::size_t i = 0; i < candidates.size(); ++i)
+#endif
+					{
+						results[i] = model->isColliding(candidates[i]) ? 1 : 0;
+					}
+				}
+				
+				this->models.end(this->getModel());
+				
+				for (::std::size_t i = 0; i < candidates.size(); ++i)
+				{
+					if (0 == results[i])
+					{
+						samples.push_back(candidates[i]);
+					}
+				}
+			}
+			
+			return samples;
+		}
+		
 		SimpleModel*
 		Sampler::getModel() const
 		{
 			return this->model;
 		}
 		
+		const ::std::vector<SimpleModel*>&
+		Sampler::getModels() const
+		{
+			return this->models.getModels();
+		}
+		
 		void
 		Sampler::setModel(SimpleModel* model)
 		{
 			this->model = model;
 		}
+		
+		void
+		Sampler::setModels(const ::std::vector<SimpleModel*>& models)
+		{
+			this->models.setModels(models);
+		}
 	}
 }
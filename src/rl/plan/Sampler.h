@@ -27,9 +27,12 @@
 #ifndef RL_PLAN_SAMPLER_H
 #define RL_PLAN_SAMPLER_H
 
+#include <vector>
 #include <rl/math/Vector.h>
 #include <rl/plan/export.h>
 
+#include "WorkerModels.h"
+
 namespace rl
 {
 	namespace plan
@@ -47,12 +50,34 @@ namespace rl
 			
 			virtual ::rl::math::Vector generateCollisionFree();
 			
+			/**
+			 * Generate multiple collision-free samples.
+			 *
+			 * Candidates are generated sequentially and checked for collision
+			 * in rounds. With OpenMP, the checks of a round are distributed over
+			 * threads, each using its own model from getModels().
+			 */
+			virtual ::std::vector<::rl::math::Vector> generateCollisionFree(const ::std::size_t& n);
+			
 			SimpleModel* getModel() const;
 			
+			const ::std::vector<SimpleModel*>& getModels() const;
+			
 			void setModel(SimpleModel* model);
 			
+			/**
+			 * Set models used by worker threads in batch generation.
+			 *
+			 * If empty, samples are checked with getModel() only. Queries of
+			 * worker models are added to the counters of getModel().
+			 */
+			void setModels(const ::std::vector<SimpleModel*>& models);
+			
 			SimpleModel* model;
 			
+			/** Models for worker threads in batch generation. */
+			WorkerModels models;
+			
 		protected:
 			
 		private:
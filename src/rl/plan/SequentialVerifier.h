@@ -40,6 +40,8 @@ namespace rl
 			
 			virtual ~SequentialVerifier();
 			
+			using Verifier::isColliding;
+			
 			bool isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d);
 			
 		protected:
@@ -0,0 +1,373 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <limits>
+
+#include "ShortcutOptimizer.h"
+#include "SimpleModel.h"
+#include "Verifier.h"
+#include "Viewer.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		ShortcutOptimizer::ShortcutOptimizer() :
+			Optimizer(),
+			batchSize(32),
+			duration(::std::chrono::steady_clock::duration::max()),
+			partialRatio(static_cast<::rl::math::Real>(0.5)),
+			rounds(10),
+			randDistribution(0, 1),
+			randEngine(::std::random_device()()),
+			statistics()
+		{
+		}
+		
+		ShortcutOptimizer::~ShortcutOptimizer()
+		{
+		}
+		
+		::std::size_t
+		ShortcutOptimizer::getBatchSize() const
+		{
+			return this->batchSize;
+		}
+		
+		::std::chrono::steady_clock::duration
+		ShortcutOptimizer::getDuration() const
+		{
+			return this->duration;
+		}
+		
+		::rl::math::Real
+		ShortcutOptimizer::getPartialRatio() const
+		{
+			return this->partialRatio;
+		}
+		
+		::std::size_t
+		ShortcutOptimizer::getRounds() const
+		{
+			return this->rounds;
+		}
+		
+		const ShortcutOptimizer::Statistics&
+		ShortcutOptimizer::getStatistics() const
+		{
+			return this->statistics;
+		}
+		
+		void
+		ShortcutOptimizer::measure(const Path& q, ::std::vector<::rl::math::Real>& s) const
+		{
+			s.assign(q.size(), 0);
+			
+			if (q.empty())
+			{
+				return;
+			}
+			
+			::rl::math::Vector u = q[0];
+			::rl::math::Vector v(u.size());
+			
+			for (::std::size_t i = 1; i < q.size(); ++i)
+			{
+				v = q[i];
+				s[i] = s[i - 1] + this->getModel()->distance(u, v);
+				u.swap(v);
+			}
+		}
+		
+		void
+		ShortcutOptimizer::process(VectorList& path)
+		{
+			Path q(path);
+			this->shorten(q);
+			path = q.toList();
+		}
+		
+		void
+		ShortcutOptimizer::process(Path& path)
+		{
+			this->shorten(path);
+		}
+		
+		::std::uniform_real_distribution<::rl::math::Real>::result_type
+		ShortcutOptimizer::rand()
+		{
+			return this->randDistribution(this->randEngine);
+		}
+		
+		void
+		ShortcutOptimizer::seed(const ::std::mt19937::result_type& value)
+		{
+			this->randEngine.seed(value);
+		}
+		
+		void
+		ShortcutOptimizer::setBatchSize(const ::std::size_t& batchSize)
+		{
+			this->batchSize = batchSize;
+		}
+		
+		void
+		ShortcutOptimizer::setDuration(const ::std::chrono::steady_clock::duration& duration)
+		{
+			this->duration = duration;
+		}
+		
+		void
+		ShortcutOptimizer::setPartialRatio(const ::rl::math::Real& partialRatio)
+		{
+			this->partialRatio = partialRatio;
+		}
+		
+		void
+		ShortcutOptimizer::setRounds(const ::std::size_t& rounds)
+		{
+			this->rounds = rounds;
+		}
+		
+		void
+		ShortcutOptimizer::shorten(Path& q)
+		{
+			::std::chrono::steady_clock::time_point start = ::std::chrono::steady_clock::now();
+			
+			::std::vector<::rl::math::Real> s;
+			this->measure(q, s);
+			
+			::rl::math::Vector inter(this->getModel()->getDofPosition());
+			::rl::math::Vector u(inter.size());
+			::rl::math::Vector v(inter.size());
+			
+			this->statistics = Statistics();
+			this->statistics.lengths.push_back(s.back());
+			
+			::std::size_t unchanged = 0;
+			
+			while (q.size() > 2 && unchanged < this->rounds && ::std::chrono::steady_clock::now() - start < this->duration)
+			{
+				::std::vector<Shortcut> shortcuts;
+				shortcuts.reserve(this->batchSize);
+				
+				for (::std::size_t i = 0; i < this->batchSize; ++i)
+				{
+					::rl::math::Real s0 = this->rand() * s.back();
+					::rl::math::Real s1 = this->rand() * s.back();
+					
+					if (s0 > s1)
+					{
+						::std::swap(s0, s1);
+					}
+					
+					Shortcut shortcut;
+					shortcut.colliding = false;
+					shortcut.first = ::std::min<::std::size_t>(::std::upper_bound(s.begin(), s.end(), s0) - s.begin(), q.size() - 1) - 1;
+					shortcut.last = ::std::min<::std::size_t>(::std::upper_bound(s.begin(), s.end(), s1) - s.begin(), q.size() - 1) - 1;
+					
+					if (shortcut.first == shortcut.last)
+					{
+						continue;
+					}
+					
+					u = q[shortcut.first];
+					v = q[shortcut.first + 1];
+					::rl::math::Vector q0(inter.size());
+					this->getModel()->interpolate(u, v, (s0 - s[shortcut.first]) / (s[shortcut.first + 1] - s[shortcut.first]), q0);
+					u = q[shortcut.last];
+					v = q[shortcut.last + 1];
+					::rl::math::Vector q1(inter.size());
+					this->getModel()->interpolate(u, v, (s1 - s[shortcut.last]) / (s[shortcut.last + 1] - s[shortcut.last]), q1);
+					
+					shortcut.q.push_back(q0);
+					
+					if (this->rand() < this->partialRatio)
+					{
+						::std::vector<::std::size_t> joints;
+						
+						for (::std::size_t j = 0; j < static_cast<::std::size_t>(inter.size()); ++j)
+						{
+							if (this->rand() < static_cast<::rl::math::Real>(0.5))
+							{
+								joints.push_back(j);
+							}
+						}
+						
+						// a subset with all joints is a regular shortcut
+						if (!joints.empty() && joints.size() < static_cast<::std::size_t>(inter.size()))
+						{
+							for (::std::size_t k = shortcut.first + 1; k < shortcut.last + 1; ++k)
+							{
+								this->getModel()->interpolate(q0, q1, (s[k] - s0) / (s1 - s0), inter);
+								shortcut.q.push_back(q[k]);
+								
+								for (::std::size_t j = 0; j < joints.size(); ++j)
+								{
+									shortcut.q.back()(joints[j]) = inter(joints[j]);
+								}
+							}
+						}
+					}
+					
+					shortcut.q.push_back(q1);
+					
+					::rl::math::Real length = 0;
+					
+					for (::std::size_t j = 1; j < shortcut.q.size(); ++j)
+					{
+						length += this->getModel()->distance(shortcut.q[j - 1], shortcut.q[j]);
+					}
+					
+					shortcut.gain = s1 - s0 - length;
+					
+					if (shortcut.gain > ::std::numeric_limits<::rl::math::Real>::epsilon() * s.back())
+					{
+						shortcuts.push_back(::std::move(shortcut));
+					}
+				}
+				
+				// new configurations of partial shortcuts are end points of segments and not checked by the verifier
+				
+				::std::vector<::rl::math::Vector> states;
+				
+				for (::std::size_t i = 0; i < shortcuts.size(); ++i)
+				{
+					states.insert(states.end(), shortcuts[i].q.begin() + 1, shortcuts[i].q.end() - 1);
+				}
+				
+				::std::vector<bool> collidingStates = this->getVerifier()->isColliding(states);
+				
+				for (::std::size_t i = 0, k = 0; i < shortcuts.size(); ++i)
+				{
+					for (::std::size_t j = 1; j + 1 < shortcuts[i].q.size(); ++j, ++k)
+					{
+						shortcuts[i].colliding = shortcuts[i].colliding || collidingStates[k];
+					}
+				}
+				
+				::std::vector<Verifier::Segment> segments;
+				
+				for (::std::size_t i = 0; i < shortcuts.size(); ++i)
+				{
+					shortcuts[i].segment = segments.size();
+					
+					if (shortcuts[i].colliding)
+					{
+						continue;
+					}
+					
+					for (::std::size_t j = 1; j < shortcuts[i].q.size(); ++j)
+					{
+						segments.push_back(Verifier::Segment(&shortcuts[i].q[j - 1], &shortcuts[i].q[j], this->getModel()->distance(shortcuts[i].q[j - 1], shortcuts[i].q[j])));
+					}
+				}
+				
+				::std::vector<bool> colliding = this->getVerifier()->isColliding(segments);
+				
+				::std::vector<Shortcut*> valid;
+				
+				for (::std::size_t i = 0; i < shortcuts.size(); ++i)
+				{
+					if (!shortcuts[i].colliding && ::std::find(colliding.begin() + shortcuts[i].segment, colliding.begin() + shortcuts[i].segment + shortcuts[i].q.size() - 1, true) == colliding.begin() + shortcuts[i].segment + shortcuts[i].q.size() - 1)
+					{
+						valid.push_back(&shortcuts[i]);
+					}
+				}
+				
+				this->statistics.proposed += shortcuts.size();
+				this->statistics.valid += valid.size();
+				
+				// greedily apply disjoint shortcuts with largest gain
+				
+				for (::std::size_t i = 0; i < valid.size(); ++i)
+				{
+					for (::std::size_t j = i + 1; j < valid.size(); ++j)
+					{
+						if (valid[j]->gain > valid[i]->gain)
+						{
+							::std::swap(valid[i], valid[j]);
+						}
+					}
+				}
+				
+				::std::vector<Shortcut*> applied;
+				
+				for (::std::size_t i = 0; i < valid.size(); ++i)
+				{
+					bool overlapping = false;
+					
+					for (::std::size_t j = 0; j < applied.size() && !overlapping; ++j)
+					{
+						overlapping = valid[i]->first <= applied[j]->last && applied[j]->first <= valid[i]->last;
+					}
+					
+					if (!overlapping)
+					{
+						applied.push_back(valid[i]);
+					}
+				}
+				
+				// apply from back to front so that indices stay valid
+				
+				for (::std::size_t i = 0; i < applied.size(); ++i)
+				{
+					for (::std::size_t j = i + 1; j < applied.size(); ++j)
+					{
+						if (applied[j]->first > applied[i]->first)
+						{
+							::std::swap(applied[i], applied[j]);
+						}
+					}
+				}
+				
+				for (::std::size_t i = 0; i < applied.size(); ++i)
+				{
+					q.erase(applied[i]->first + 1, applied[i]->last + 1);
+					
+					for (::std::size_t j = 0; j < applied[i]->q.size(); ++j)
+					{
+						q.insert(applied[i]->first + 1 + j, applied[i]->q[j]);
+					}
+				}
+				
+				this->measure(q, s);
+				
+				++this->statistics.rounds;
+				this->statistics.applied += applied.size();
+				this->statistics.lengths.push_back(s.back());
+				
+				unchanged = applied.empty() ? unchanged + 1 : 0;
+				
+				if (!applied.empty() && nullptr != this->getViewer())
+				{
+					this->getViewer()->drawConfigurationPath(q.toList());
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,170 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_SHORTCUTOPTIMIZER_H
+#define RL_PLAN_SHORTCUTOPTIMIZER_H
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "Optimizer.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Randomized shortcutting with batch verification.
+		 *
+		 * Each round proposes a batch of shortcuts between random points on
+		 * the path and verifies all of them with one call of
+		 * Verifier::isColliding(), which distributes segments over threads if
+		 * the verifier has per-thread models. Collision-free shortcuts are
+		 * applied in order of decreasing gain, skipping those that overlap an
+		 * already applied one.
+		 *
+		 * A partial shortcut only moves a random subset of joints onto the
+		 * straight line between its endpoints, the remaining joints keep
+		 * their original motion.
+		 *
+		 * Roland Geraerts and Mark H. Overmars. Creating high-quality paths for
+		 * motion planning. The International Journal of Robotics Research,
+		 * 26(8):845-863, August 2007.
+		 *
+		 * http://dx.doi.org/10.1177/0278364907079280
+		 */
+		class RL_PLAN_EXPORT ShortcutOptimizer : public Optimizer
+		{
+		public:
+			struct Statistics
+			{
+				/** Number of applied shortcuts. */
+				::std::size_t applied;
+				
+				/** Number of proposed shortcuts. */
+				::std::size_t proposed;
+				
+				/** Number of rounds. */
+				::std::size_t rounds;
+				
+				/** Path length after each round, starting with initial length. */
+				::std::vector<::rl::math::Real> lengths;
+				
+				/** Number of verified shortcuts without collision. */
+				::std::size_t valid;
+			};
+			
+			ShortcutOptimizer();
+			
+			virtual ~ShortcutOptimizer();
+			
+			::std::size_t getBatchSize() const;
+			
+			::std::chrono::steady_clock::duration getDuration() const;
+			
+			::rl::math::Real getPartialRatio() const;
+			
+			::std::size_t getRounds() const;
+			
+			const Statistics& getStatistics() const;
+			
+			void process(VectorList& path);
+			
+			void process(Path& path);
+			
+			void seed(const ::std::mt19937::result_type& value);
+			
+			/**
+			 * Set number of shortcuts proposed and verified per round.
+			 */
+			void setBatchSize(const ::std::size_t& batchSize);
+			
+			/**
+			 * Set time budget for process().
+			 */
+			void setDuration(const ::std::chrono::steady_clock::duration& duration);
+			
+			/**
+			 * Set probability of proposing a partial-joint shortcut.
+			 */
+			void setPartialRatio(const ::rl::math::Real& partialRatio);
+			
+			/**
+			 * Set number of consecutive rounds without improvement before
+			 * stopping.
+			 */
+			void setRounds(const ::std::size_t& rounds);
+			
+			::std::size_t batchSize;
+			
+			::std::chrono::steady_clock::duration duration;
+			
+			::rl::math::Real partialRatio;
+			
+			::std::size_t rounds;
+			
+		protected:
+			::std::uniform_real_distribution<::rl::math::Real>::result_type rand();
+			
+			::std::uniform_real_distribution<::rl::math::Real> randDistribution;
+			
+			::std::mt19937 randEngine;
+			
+		private:
+			struct Shortcut
+			{
+				/** New configurations of partial shortcut collide. */
+				bool colliding;
+				
+				/** Index of first segment that is shortened. */
+				::std::size_t first;
+				
+				::rl::math::Real gain;
+				
+				/** Index of last segment that is shortened. */
+				::std::size_t last;
+				
+				/** Configurations replacing the vertices between first and last segment. */
+				::std::vector<::rl::math::Vector> q;
+				
+				/** Index of first segment to verify. */
+				::std::size_t segment;
+			};
+			
+			/**
+			 * Compute path length up to each configuration.
+			 */
+			void measure(const Path& q, ::std::vector<::rl::math::Real>& s) const;
+			
+			void shorten(Path& q);
+			
+			Statistics statistics;
+		};
+	}
+}
+
+#endif // RL_PLAN_SHORTCUTOPTIMIZER_H
@@ -24,9 +24,12 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <limits>
 #include <rl/sg/Body.h>
 #include <rl/sg/SimpleScene.h>
 
+#include "Hash.h"
+#include "Profiler.h"
 #include "SimpleModel.h"
 
 namespace rl
@@ -37,7 +40,22 @@ namespace rl
 			Model(),
 			body(0),
 			freeQueries(0),
-			totalQueries(0)
+			profiler(nullptr),
+			totalQueries(0),
+			cache(),
+			cacheHits(0),
+			cacheKey(),
+			cacheMap(),
+			cacheMisses(0),
+			cacheObstacles(0),
+			cacheResolution(static_cast<::rl::math::Real>(1.0e-6)),
+			cacheSize(0),
+			doBroadphase(false),
+			margin(0),
+			pairBodies(),
+			pairModels(),
+			pairs(),
+			pairsValid(false)
 		{
 		}
 		
@@ -45,6 +63,50 @@ namespace rl
 		{
 		}
 		
+		void
+		SimpleModel::addQueries(const ::std::size_t& freeQueries, const ::std::size_t& totalQueries)
+		{
+			this->freeQueries += freeQueries;
+			this->totalQueries += totalQueries;
+		}
+		
+		void
+		SimpleModel::clearCache()
+		{
+			this->cache.clear();
+			this->cacheMap.clear();
+		}
+		
+		::std::size_t
+		SimpleModel::getCacheHits() const
+		{
+			return this->cacheHits;
+		}
+		
+		::std::size_t
+		SimpleModel::getCacheMisses() const
+		{
+			return this->cacheMisses;
+		}
+		
+		::rl::math::Real
+		SimpleModel::getCacheResolution() const
+		{
+			return this->cacheResolution;
+		}
+		
+		::std::size_t
+		SimpleModel::getCacheSize() const
+		{
+			return this->cacheSize;
+		}
+		
+		::rl::math::Real
+		SimpleModel::getBroadphaseMargin() const
+		{
+			return this->margin;
+		}
+		
 		::std::size_t
 		SimpleModel::getCollidingBody() const
 		{
@@ -57,47 +119,81 @@ namespace rl
 			return this->freeQueries;
 		}
 		
+		Profiler*
+		SimpleModel::getProfiler() const
+		{
+			return this->profiler;
+		}
+		
 		::std::size_t
 		SimpleModel::getTotalQueries() const
 		{
 			return this->totalQueries;
 		}
 		
+		::std::uint64_t
+		SimpleModel::hashObstacles() const
+		{
+			Hash hash;
+			
+			for (::std::size_t i = this->model->getNumBodies(); i < this->pairBodies.size(); ++i)
+			{
+				hash.combine(this->pairBodies[i].body->getFrame());
+			}
+			
+			return hash.get();
+		}
+		
 		bool
 		SimpleModel::isColliding()
 		{
 			++this->totalQueries;
 			
-			for (::std::size_t i = 0; i < this->model->getNumBodies(); ++i)
+			if (!this->pairsValid || this->isPairsStale())
 			{
-				if (this->isColliding(i))
+				this->updatePairs();
+			}
+			
+			if (this->doBroadphase)
+			{
+				for (::std::size_t i = 0; i < this->pairBodies.size(); ++i)
 				{
-					for (::rl::sg::Scene::Iterator j = this->scene->begin(); j != this->scene->end(); ++j)
+					PairBody& pairBody = this->pairBodies[i];
+					
+					if (pairBody.bounded)
 					{
-						if (this->model != *j)
-						{
-							for (::rl::sg::Model::Iterator k = (*j)->begin(); k != (*j)->end(); ++k)
-							{
-								if (dynamic_cast<::rl::sg::SimpleScene*>(this->scene)->areColliding(this->model->getBody(i), *k))
-								{
-									this->body = i;
-									return true;
-								}
-							}
-						}
+						::rl::math::Transform frame = pairBody.index < this->getBodies() ? this->getFrame(pairBody.index) : pairBody.body->getFrame();
+						::rl::math::Vector3 center = frame * ((pairBody.body->max + pairBody.body->min) / 2);
+						::rl::math::Vector3 extent = frame.linear().cwiseAbs() * ((pairBody.body->max - pairBody.body->min) / 2) + ::rl::math::Vector3::Constant(this->margin);
+						pairBody.box.min() = center - extent;
+						pairBody.box.max() = center + extent;
 					}
 				}
+			}
+			
+			::rl::sg::SimpleScene* simpleScene = dynamic_cast<::rl::sg::SimpleScene*>(this->scene);
+			
+			for (::std::size_t i = 0; i < this->pairs.size(); ++i)
+			{
+				const PairBody& first = this->pairBodies[this->pairs[i].first];
+				const PairBody& second = this->pairBodies[this->pairs[i].second];
 				
-				for (::std::size_t j = 0; j < i; ++j)
+				if (this->doBroadphase && first.bounded && second.bounded && !first.box.intersects(second.box))
 				{
-					if (this->areColliding(i, j))
+					continue;
+				}
+				
+				if (simpleScene->areColliding(first.body, second.body))
+				{
+					this->body = this->pairs[i].body;
+					++this->pairs[i].collisions;
+					
+					if (i > 0 && this->pairs[i].collisions > this->pairs[i - 1].collisions)
 					{
-						if (dynamic_cast<::rl::sg::SimpleScene*>(this->scene)->areColliding(this->model->getBody(i), this->model->getBody(j)))
-						{
-							this->body = i;
-							return true;
-						}
+						::std::swap(this->pairs[i], this->pairs[i - 1]);
 					}
+					
+					return true;
 				}
 			}
 			
@@ -106,12 +202,102 @@ namespace rl
 			return false;
 		}
 		
+		bool
+		SimpleModel::isPairsStale() const
+		{
+			if (this->scene->getNumModels() != this->pairModels.size())
+			{
+				return true;
+			}
+			
+			::std::size_t k = 0;
+			
+			for (::rl::sg::Scene::Iterator i = this->scene->begin(); i != this->scene->end(); ++i, ++k)
+			{
+				if (this->pairModels[k].first != *i || this->pairModels[k].second != (*i)->getNumBodies())
+				{
+					return true;
+				}
+			}
+			
+			return false;
+		}
+		
 		bool
 		SimpleModel::isColliding(const ::rl::math::Vector& q)
 		{
+			Profiler::Scope scope(this->profiler, Profiler::Counter::collision);
+			
 			this->setPosition(q);
 			this->updateFrames();
-			return this->isColliding();
+			
+			if (0 == this->cacheSize)
+			{
+				return this->isColliding();
+			}
+			
+			if (!this->pairsValid || this->isPairsStale())
+			{
+				this->updatePairs();
+			}
+			
+			::std::uint64_t obstacles = this->hashObstacles();
+			
+			if (obstacles != this->cacheObstacles)
+			{
+				this->clearCache();
+				this->cacheObstacles = obstacles;
+			}
+			
+			this->cacheKey.resize(q.size());
+			
+			for (::std::ptrdiff_t i = 0; i < q.size(); ++i)
+			{
+				this->cacheKey[i] = static_cast<::std::int64_t>(::std::floor(q(i) / this->cacheResolution + static_cast<::rl::math::Real>(0.5)));
+			}
+			
+			::std::unordered_map<CacheKey, CacheList::iterator, CacheKeyHash>::iterator found = this->cacheMap.find(this->cacheKey);
+			
+			if (this->cacheMap.end() != found)
+			{
+				++this->cacheHits;
+				this->cache.splice(this->cache.begin(), this->cache, found->second);
+				
+				++this->totalQueries;
+				this->body = found->second->body;
+				
+				if (!found->second->colliding)
+				{
+					++this->freeQueries;
+				}
+				
+				return found->second->colliding;
+			}
+			
+			++this->cacheMisses;
+			
+			CacheEntry entry;
+			entry.colliding = this->isColliding();
+			entry.body = this->body;
+			
+			if (this->cache.size() < this->cacheSize)
+			{
+				entry.key = this->cacheKey;
+				this->cache.push_front(::std::move(entry));
+			}
+			else
+			{
+				CacheList::iterator last = --this->cache.end();
+				this->cacheMap.erase(last->key);
+				last->body = entry.body;
+				last->colliding = entry.colliding;
+				last->key = this->cacheKey;
+				this->cache.splice(this->cache.begin(), this->cache, last);
+			}
+			
+			this->cacheMap.emplace(this->cache.front().key, this->cache.begin());
+			
+			return this->cache.front().colliding;
 		}
 		
 		void
@@ -120,6 +306,128 @@ namespace rl
 			this->body = 0;
 			this->freeQueries = 0;
 			this->totalQueries = 0;
+			this->cacheHits = 0;
+			this->cacheMisses = 0;
+			this->clearCache();
+			this->pairsValid = false;
+		}
+		
+		void
+		SimpleModel::setBroadphase(const bool& doBroadphase)
+		{
+			this->doBroadphase = doBroadphase;
+		}
+		
+		void
+		SimpleModel::setBroadphaseMargin(const ::rl::math::Real& margin)
+		{
+			this->margin = margin;
+		}
+		
+		void
+		SimpleModel::setCacheResolution(const ::rl::math::Real& resolution)
+		{
+			this->cacheResolution = resolution;
+			this->clearCache();
+		}
+		
+		void
+		SimpleModel::setCacheSize(const ::std::size_t& size)
+		{
+			this->cacheSize = size;
+			
+			while (this->cache.size() > this->cacheSize)
+			{
+				this->cacheMap.erase(this->cache.back().key);
+				this->cache.pop_back();
+			}
+		}
+		
+		void
+		SimpleModel::setProfiler(Profiler* profiler)
+		{
+			this->profiler = profiler;
+		}
+		
+		void
+		SimpleModel::updatePairs()
+		{
+			this->pairBodies.clear();
+			this->pairModels.clear();
+			this->pairs.clear();
+			this->clearCache();
+			
+			assert(nullptr != dynamic_cast<::rl::sg::SimpleScene*>(this->scene));
+			
+			for (::std::size_t i = 0; i < this->model->getNumBodies(); ++i)
+			{
+				PairBody pairBody;
+				pairBody.body = this->model->getBody(i);
+				pairBody.index = i;
+				this->pairBodies.push_back(pairBody);
+			}
+			
+			for (::rl::sg::Scene::Iterator i = this->scene->begin(); i != this->scene->end(); ++i)
+			{
+				this->pairModels.emplace_back(*i, (*i)->getNumBodies());
+				
+				if (this->model != *i)
+				{
+					for (::rl::sg::Model::Iterator j = (*i)->begin(); j != (*i)->end(); ++j)
+					{
+						PairBody pairBody;
+						pairBody.body = *j;
+						pairBody.index = ::std::numeric_limits<::std::size_t>::max();
+						this->pairBodies.push_back(pairBody);
+					}
+				}
+			}
+			
+			for (::std::size_t i = 0; i < this->pairBodies.size(); ++i)
+			{
+				this->pairBodies[i].bounded = !this->pairBodies[i].body->min.isZero() || !this->pairBodies[i].body->max.isZero();
+			}
+			
+			for (::std::size_t i = 0; i < this->model->getNumBodies(); ++i)
+			{
+				Pair pair;
+				pair.body = i;
+				pair.collisions = 0;
+				pair.first = i;
+				
+				if (this->isColliding(i))
+				{
+					for (::std::size_t j = this->model->getNumBodies(); j < this->pairBodies.size(); ++j)
+					{
+						pair.second = j;
+						this->pairs.push_back(pair);
+					}
+				}
+				
+				for (::std::size_t j = 0; j < i; ++j)
+				{
+					if (this->areColliding(i, j))
+					{
+						pair.second = j;
+						this->pairs.push_back(pair);
+					}
+				}
+			}
+			
+			this->pairsValid = true;
+		}
+		
+		::std::size_t
+		SimpleModel::CacheKeyHash::operator()(const CacheKey& key) const
+		{
+			::std::size_t seed = key.size();
+			
+			for (::std::size_t i = 0; i < key.size(); ++i)
+			{
+				seed ^= ::std::hash<::std::int64_t>()(key[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+			}
+			
+			return seed;
 		}
 	}
 }
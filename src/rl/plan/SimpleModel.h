@@ -27,12 +27,21 @@
 #ifndef RL_PLAN_SIMPLEMODEL_H
 #define RL_PLAN_SIMPLEMODEL_H
 
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <rl/math/AlignedBox.h>
+
 #include "Model.h"
 
 namespace rl
 {
 	namespace plan
 	{
+		class Profiler;
+		
 		class RL_PLAN_EXPORT SimpleModel : public Model
 		{
 		public:
@@ -40,29 +49,195 @@ namespace rl
 			
 			virtual ~SimpleModel();
 			
+			/**
+			 * Add queries performed with another model, e.g., by worker threads.
+			 */
+			void addQueries(const ::std::size_t& freeQueries, const ::std::size_t& totalQueries);
+			
+			/**
+			 * Remove all cached collision results.
+			 *
+			 * The cache is cleared automatically if obstacles are moved or
+			 * models are added to or removed from the scene. Needs to be called
+			 * after other changes of the scene, e.g., after modifying shapes.
+			 */
+			void clearCache();
+			
+			::std::size_t getCacheHits() const;
+			
+			::std::size_t getCacheMisses() const;
+			
+			::rl::math::Real getCacheResolution() const;
+			
+			::std::size_t getCacheSize() const;
+			
+			/**
+			 * Margin added to bounding boxes in the broad phase.
+			 */
+			::rl::math::Real getBroadphaseMargin() const;
+			
 			::std::size_t getCollidingBody() const;
 			
 			::std::size_t getFreeQueries() const;
 			
+			Profiler* getProfiler() const;
+			
 			::std::size_t getTotalQueries() const;
 			
 			using Model::isColliding;
 			
+			/**
+			 * Check current frames for collision.
+			 *
+			 * Tests the precomputed list of body pairs, starting with the pairs
+			 * that collided most often. If the broad phase is enabled, pairs
+			 * with disjoint bounding boxes are skipped.
+			 *
+			 * The list is rebuilt automatically if models are added to or
+			 * removed from the scene or if their number of bodies changes.
+			 * Changes of collision flags of the model or replaced bodies are not
+			 * detected, updatePairs() needs to be called afterwards.
+			 */
 			virtual bool isColliding();
 			
+			/**
+			 * Check configuration for collision.
+			 *
+			 * If a cache size is set, results are memoized for configurations
+			 * quantized with the cache resolution. Position and frames are
+			 * updated on cache hits as well, only the collision query itself is
+			 * skipped. Frames of obstacles are hashed on each query and cached
+			 * results are discarded if they changed.
+			 */
 			virtual bool isColliding(const ::rl::math::Vector& q);
 			
+			/**
+			 * Reset query counters and clear cache.
+			 */
 			virtual void reset();
 			
+			/**
+			 * Enable bounding box test before narrow phase collision queries.
+			 *
+			 * Requires body bounding boxes, e.g., loaded by the XML factory
+			 * with bounding box points enabled. Bodies without a bounding box
+			 * are always tested.
+			 */
+			void setBroadphase(const bool& doBroadphase);
+			
+			void setBroadphaseMargin(const ::rl::math::Real& margin);
+			
+			/**
+			 * Set grid resolution for quantizing cached configurations.
+			 */
+			void setCacheResolution(const ::rl::math::Real& resolution);
+			
+			/**
+			 * Set maximum number of cached collision results.
+			 *
+			 * Least recently used results are removed first, 0 disables the
+			 * cache.
+			 */
+			void setCacheSize(const ::std::size_t& size);
+			
+			/**
+			 * Set profiler for recording collision queries.
+			 */
+			void setProfiler(Profiler* profiler);
+			
+			/**
+			 * Rebuild list of body pairs to test and clear cache.
+			 *
+			 * Needs to be called after changing collision flags of the model.
+			 */
+			void updatePairs();
+			
 		protected:
 			::std::size_t body;
 			
 			::std::size_t freeQueries;
 			
+			Profiler* profiler;
+			
 			::std::size_t totalQueries;
 			
 		private:
+			typedef ::rl::math::AlignedBox<::rl::math::Real, 3> Box;
+			
+			typedef ::std::vector<::std::int64_t> CacheKey;
+			
+			struct CacheEntry
+			{
+				::std::size_t body;
+				
+				bool colliding;
+				
+				CacheKey key;
+			};
+			
+			struct CacheKeyHash
+			{
+				::std::size_t operator()(const CacheKey& key) const;
+			};
+			
+			struct Pair
+			{
+				::std::size_t body;
+				
+				::std::size_t collisions;
+				
+				::std::size_t first;
+				
+				::std::size_t second;
+			};
+			
+			struct PairBody
+			{
+				bool bounded;
+				
+				Box box;
+				
+				::rl::sg::Body* body;
+				
+				::std::size_t index;
+			};
+			
+			typedef ::std::list<CacheEntry> CacheList;
+			
+			/** Hash frames of all bodies not belonging to the model. */
+			::std::uint64_t hashObstacles() const;
+			
+			/** Check if scene models or their number of bodies changed since updatePairs(). */
+			bool isPairsStale() const;
+			
+			CacheList cache;
+			
+			::std::size_t cacheHits;
+			
+			CacheKey cacheKey;
+			
+			::std::unordered_map<CacheKey, CacheList::iterator, CacheKeyHash> cacheMap;
+			
+			::std::size_t cacheMisses;
+			
+			/** Hash of obstacle frames of cached results. */
+			::std::uint64_t cacheObstacles;
+			
+			::rl::math::Real cacheResolution;
+			
+			::std::size_t cacheSize;
+			
+			bool doBroadphase;
+			
+			::rl::math::Real margin;
+			
+			::std::vector<PairBody> pairBodies;
+			
+			::std::vector<::std::pair<const ::rl::sg::Model*, ::std::size_t>> pairModels;
+			
+			::std::vector<Pair> pairs;
 			
+			bool pairsValid;
 		};
 	}
 }
@@ -44,31 +44,39 @@ namespace rl
 		
 		void
 		SimpleOptimizer::process(VectorList& path)
+		{
+			Path contiguous(path);
+			this->process(contiguous);
+			path = contiguous.toList();
+		}
+		
+		void
+		SimpleOptimizer::process(Path& path)
 		{
 			bool changed = true;
+			::rl::math::Vector qi(this->getModel()->getDofPosition());
+			::rl::math::Vector qk(this->getModel()->getDofPosition());
 			
 			while (changed && path.size() > 2)
 			{
 				changed = false;
 				
-				VectorList::iterator i = path.begin();
-				VectorList::iterator j = ++path.begin();
-				VectorList::iterator k = ++++path.begin();
+				::std::size_t i = 0;
 				
-				while (i != path.end() && j != path.end() && k != path.end())
+				while (i + 2 < path.size())
 				{
-					::rl::math::Real ik = this->getModel()->distance(*i, *k);
+					qi = path[i];
+					qk = path[i + 2];
+					
+					::rl::math::Real ik = this->getModel()->distance(qi, qk);
 					
-					if (!this->getVerifier()->isColliding(*i, *k, ik))
+					if (!this->getVerifier()->isColliding(qi, qk, ik))
 					{
-						VectorList::iterator l = j;
-						++j;
-						++k;
-						path.erase(l);
+						path.erase(i + 1);
 						
 						if (nullptr != this->getViewer())
 						{
-							this->getViewer()->drawConfigurationPath(path);
+							this->getViewer()->drawConfigurationPath(path.toList());
 						}
 						
 						changed = true;
@@ -76,8 +84,6 @@ namespace rl
 					else
 					{
 						++i;
-						++j;
-						++k;
 					}
 				}
 			}
@@ -42,6 +42,8 @@ namespace rl
 			
 			void process(VectorList& path);
 			
+			void process(Path& path);
+			
 		protected:
 			
 		private:
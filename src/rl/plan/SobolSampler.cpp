@@ -0,0 +1,186 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+
+#include "Exception.h"
+#include "SimpleModel.h"
+#include "SobolSampler.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/** Degree of primitive polynomial for dimensions 2 to 21. */
+		static const ::std::size_t SOBOL_DEGREES[20] = { 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 7, 7 };
+		
+		/** Inner coefficients of primitive polynomial for dimensions 2 to 21. */
+		static const ::std::uint32_t SOBOL_POLYNOMIALS[20] = { 0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16, 19, 22, 25, 1, 4 };
+		
+		/** Initial direction numbers for dimensions 2 to 21. */
+		static const ::std::uint32_t SOBOL_DIRECTIONS[20][7] = {
+			{ 1 },
+			{ 1, 3 },
+			{ 1, 3, 1 },
+			{ 1, 1, 1 },
+			{ 1, 1, 3, 3 },
+			{ 1, 3, 5, 13 },
+			{ 1, 1, 5, 5, 17 },
+			{ 1, 1, 5, 5, 5 },
+			{ 1, 1, 7, 11, 19 },
+			{ 1, 1, 5, 1, 1 },
+			{ 1, 1, 1, 3, 11 },
+			{ 1, 3, 5, 5, 31 },
+			{ 1, 3, 3, 9, 7, 49 },
+			{ 1, 1, 1, 15, 21, 21 },
+			{ 1, 3, 1, 13, 27, 49 },
+			{ 1, 1, 1, 15, 7, 5 },
+			{ 1, 3, 1, 15, 13, 25 },
+			{ 1, 1, 5, 5, 19, 61 },
+			{ 1, 3, 7, 11, 23, 15, 103 },
+			{ 1, 3, 7, 13, 13, 15, 69 }
+		};
+		
+		SobolSampler::SobolSampler() :
+			UniformSampler(),
+			scrambled(true),
+			directions(),
+			index(0),
+			shifts(),
+			x()
+		{
+		}
+		
+		SobolSampler::~SobolSampler()
+		{
+		}
+		
+		::rl::math::Vector
+		SobolSampler::generate()
+		{
+			if (this->directions.size() != this->getModel()->getDof())
+			{
+				this->initialize(this->getModel()->getDof());
+			}
+			
+			// Gray code order, flip direction of lowest zero bit of index
+			
+			::std::size_t bit = 0;
+			
+			for (::std::uint32_t i = this->index; i & 1; i >>= 1)
+			{
+				++bit;
+			}
+			
+			if (bit >= 32)
+			{
+				this->index = 0;
+				::std::fill(this->x.begin(), this->x.end(), 0);
+				bit = 0;
+			}
+			
+			::rl::math::Vector rand(this->getModel()->getDof());
+			
+			for (::std::size_t i = 0; i < this->getModel()->getDof(); ++i)
+			{
+				this->x[i] ^= this->directions[i][bit];
+				rand(i) = static_cast<::rl::math::Real>(this->x[i] ^ this->shifts[i]) / static_cast<::rl::math::Real>(4294967296.0);
+			}
+			
+			++this->index;
+			
+			return this->getModel()->generatePositionUniform(rand);
+		}
+		
+		bool
+		SobolSampler::getScrambled() const
+		{
+			return this->scrambled;
+		}
+		
+		void
+		SobolSampler::initialize(const ::std::size_t& dimensions)
+		{
+			if (dimensions > DIMENSIONS)
+			{
+				throw Exception("rl::plan::SobolSampler::initialize() - Direction numbers available for up to " + ::std::to_string(DIMENSIONS) + " dimensions");
+			}
+			
+			this->directions.assign(dimensions, ::std::vector<::std::uint32_t>(32));
+			
+			for (::std::size_t j = 0; j < 32; ++j)
+			{
+				this->directions[0][j] = static_cast<::std::uint32_t>(1) << (31 - j);
+			}
+			
+			for (::std::size_t i = 1; i < dimensions; ++i)
+			{
+				::std::size_t s = SOBOL_DEGREES[i - 1];
+				::std::uint32_t a = SOBOL_POLYNOMIALS[i - 1];
+				::std::vector<::std::uint32_t>& v = this->directions[i];
+				
+				for (::std::size_t j = 0; j < s; ++j)
+				{
+					v[j] = SOBOL_DIRECTIONS[i - 1][j] << (31 - j);
+				}
+				
+				for (::std::size_t j = s; j < 32; ++j)
+				{
+					v[j] = v[j - s] ^ (v[j - s] >> s);
+					
+					for (::std::size_t k = 1; k < s; ++k)
+					{
+						v[j] ^= ((a >> (s - 1 - k)) & 1) * v[j - k];
+					}
+				}
+			}
+			
+			this->shifts.resize(dimensions);
+			
+			for (::std::size_t i = 0; i < dimensions; ++i)
+			{
+				this->shifts[i] = this->scrambled ? static_cast<::std::uint32_t>(this->randEngine()) : 0;
+			}
+			
+			this->index = 0;
+			this->x.assign(dimensions, 0);
+		}
+		
+		void
+		SobolSampler::seed(const ::std::mt19937::result_type& value)
+		{
+			UniformSampler::seed(value);
+			this->directions.clear();
+		}
+		
+		void
+		SobolSampler::setScrambled(const bool& scrambled)
+		{
+			this->scrambled = scrambled;
+			this->directions.clear();
+		}
+	}
+}
@@ -0,0 +1,96 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_SOBOLSAMPLER_H
+#define RL_PLAN_SOBOLSAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "UniformSampler.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Scrambled Sobol sequence sampling strategy.
+		 *
+		 * Uses the direction numbers of Joe and Kuo for up to 21 dimensions.
+		 * Points are scrambled with a random digital shift drawn in seed(),
+		 * which preserves the stratification properties of the sequence.
+		 *
+		 * Stephen Joe and Frances Y. Kuo. Constructing Sobol sequences with
+		 * better two-dimensional projections. SIAM Journal on Scientific
+		 * Computing, 30(5):2635-2654, 2008.
+		 *
+		 * http://dx.doi.org/10.1137/070709359
+		 */
+		class RL_PLAN_EXPORT SobolSampler : public UniformSampler
+		{
+		public:
+			SobolSampler();
+			
+			virtual ~SobolSampler();
+			
+			::rl::math::Vector generate();
+			
+			bool getScrambled() const;
+			
+			/**
+			 * Restart sequence and draw new digital shift.
+			 */
+			virtual void seed(const ::std::mt19937::result_type& value);
+			
+			void setScrambled(const bool& scrambled);
+			
+			static const ::std::size_t DIMENSIONS = 21;
+			
+			/** Scramble points with random digital shift. */
+			bool scrambled;
+			
+		protected:
+			void initialize(const ::std::size_t& dimensions);
+			
+			/** Direction numbers per dimension. */
+			::std::vector<::std::vector<::std::uint32_t>> directions;
+			
+			/** Index of next element in sequence. */
+			::std::uint32_t index;
+			
+			/** Digital shift per dimension. */
+			::std::vector<::std::uint32_t> shifts;
+			
+			/** Current unscrambled point. */
+			::std::vector<::std::uint32_t> x;
+			
+		private:
+			
+		};
+	}
+}
+
+#endif // RL_PLAN_SOBOLSAMPLER_H
@@ -0,0 +1,411 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cmath>
+#include <limits>
+#include <rl/kin/Kinematics.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/Kinematic.h>
+
+#include "Exception.h"
+#include "Model.h"
+#include "Toppra.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		Toppra::Toppra() :
+			acceleration(),
+			dynamic(nullptr),
+			gridPoints(100),
+			model(nullptr),
+			torque(),
+			velocity()
+		{
+		}
+		
+		Toppra::~Toppra()
+		{
+		}
+		
+		const ::rl::math::Vector&
+		Toppra::getAcceleration() const
+		{
+			return this->acceleration;
+		}
+		
+		::rl::mdl::Dynamic*
+		Toppra::getDynamic() const
+		{
+			return this->dynamic;
+		}
+		
+		::std::size_t
+		Toppra::getGridPoints() const
+		{
+			return this->gridPoints;
+		}
+		
+		Model*
+		Toppra::getModel() const
+		{
+			return this->model;
+		}
+		
+		const ::rl::math::Vector&
+		Toppra::getTorque() const
+		{
+			return this->torque;
+		}
+		
+		const ::rl::math::Vector&
+		Toppra::getVelocity() const
+		{
+			return this->velocity;
+		}
+		
+		::rl::math::Spline<::rl::math::Vector>
+		Toppra::process(const ::rl::math::Spline<::rl::math::Vector>& path)
+		{
+			assert(this->gridPoints > 1);
+			assert(path.size() > 0);
+			
+			::std::size_t dof = path(path.lower()).size();
+			
+			::rl::math::Vector velocity = this->velocity;
+			
+			if (0 == velocity.size())
+			{
+				if (nullptr == this->model)
+				{
+					throw Exception("rl::plan::Toppra::process() - No velocity limits and no model specified");
+				}
+				else if (nullptr != this->model->mdl)
+				{
+					velocity = this->model->mdl->getSpeed();
+				}
+				else if (nullptr != this->model->kin)
+				{
+					this->model->kin->getSpeed(velocity);
+				}
+			}
+			
+			assert(velocity.size() == dof);
+			assert(this->acceleration.size() == dof);
+			assert(nullptr == this->dynamic || this->torque.size() == dof);
+			
+			::std::size_t n = this->gridPoints - 1;
+			::rl::math::Real delta = path.duration() / n;
+			
+			::std::vector<::rl::math::Vector> q(n + 1);
+			::std::vector<::rl::math::Vector> qd(n + 1);
+			::std::vector<::std::vector<Constraint>> constraints(n + 1);
+			
+			// evaluate path derivatives and constraints per grid point, advancing through polynomials
+			
+			::std::size_t polynomial = 0;
+			::rl::math::Real x0 = path.lower();
+			
+			for (::std::size_t i = 0; i < n + 1; ++i)
+			{
+				::rl::math::Real s = path.lower() + i * delta;
+				
+				while (polynomial + 1 < path.size() && s > x0 + path[polynomial].duration())
+				{
+					x0 += path[polynomial].duration();
+					++polynomial;
+				}
+				
+				q[i] = path[polynomial](s - x0);
+				qd[i] = path[polynomial](s - x0, 1);
+				::rl::math::Vector qdd = path[polynomial](s - x0, 2);
+				
+				::std::vector<Constraint>& constraint = constraints[i];
+				constraint.reserve(1 + 3 * dof + (nullptr != this->dynamic ? 2 * dof : 0));
+				
+				constraint.push_back({0, -1, 0});
+				
+				for (::std::size_t j = 0; j < dof; ++j)
+				{
+					if (::std::abs(qd[i](j)) > 0)
+					{
+						constraint.push_back({0, 1, ::std::pow(velocity(j) / qd[i](j), 2)});
+					}
+					
+					constraint.push_back({qd[i](j), qdd(j), this->acceleration(j)});
+					constraint.push_back({-qd[i](j), -qdd(j), this->acceleration(j)});
+				}
+				
+				if (nullptr != this->dynamic)
+				{
+					// torque is a * u + b * x + c with inverse dynamics at zero, first, and second path derivatives
+					
+					this->dynamic->setPosition(q[i]);
+					this->dynamic->setVelocity(::rl::math::Vector::Zero(dof));
+					this->dynamic->setAcceleration(::rl::math::Vector::Zero(dof));
+					this->dynamic->inverseDynamics();
+					::rl::math::Vector c = this->dynamic->getTorque();
+					
+					this->dynamic->setAcceleration(qd[i]);
+					this->dynamic->inverseDynamics();
+					::rl::math::Vector a = this->dynamic->getTorque() - c;
+					
+					this->dynamic->setVelocity(qd[i]);
+					this->dynamic->setAcceleration(qdd);
+					this->dynamic->inverseDynamics();
+					::rl::math::Vector b = this->dynamic->getTorque() - c;
+					
+					for (::std::size_t j = 0; j < dof; ++j)
+					{
+						constraint.push_back({a(j), b(j), this->torque(j) - c(j)});
+						constraint.push_back({-a(j), -b(j), this->torque(j) + c(j)});
+					}
+				}
+			}
+			
+			// backward pass, controllable sets of squared path velocity ending at rest
+			
+			::std::vector<::rl::math::Real> min(n + 1, 0);
+			::std::vector<::rl::math::Real> max(n + 1, 0);
+			
+			for (::std::size_t i = n; i-- > 0;)
+			{
+				::std::vector<Constraint>& constraint = constraints[i];
+				constraint.push_back({2 * delta, 1, max[i + 1]});
+				constraint.push_back({-2 * delta, -1, -min[i + 1]});
+				
+				if (!Toppra::project(constraint, min[i], max[i]))
+				{
+					throw Exception("rl::plan::Toppra::process() - Path is not controllable with given limits");
+				}
+			}
+			
+			if (min[0] > ::std::sqrt(::std::numeric_limits<::rl::math::Real>::epsilon()))
+			{
+				throw Exception("rl::plan::Toppra::process() - Path cannot start at rest with given limits");
+			}
+			
+			// forward pass, greedy maximum path acceleration starting at rest
+			
+			::std::vector<::rl::math::Real> x(n + 1, 0);
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				::rl::math::Real u = ::std::numeric_limits<::rl::math::Real>::infinity();
+				
+				for (::std::size_t j = 0; j < constraints[i].size(); ++j)
+				{
+					if (constraints[i][j].a > 0)
+					{
+						u = ::std::min(u, (constraints[i][j].c - constraints[i][j].b * x[i]) / constraints[i][j].a);
+					}
+				}
+				
+				x[i + 1] = ::std::max(::std::min(x[i] + 2 * delta * u, max[i + 1]), min[i + 1]);
+			}
+			
+			::rl::math::Spline<::rl::math::Vector> trajectory;
+			
+			for (::std::size_t i = 0; i < n; ++i)
+			{
+				::rl::math::Real sd0 = ::std::sqrt(x[i]);
+				::rl::math::Real sd1 = ::std::sqrt(x[i + 1]);
+				
+				if (sd0 + sd1 <= 0)
+				{
+					throw Exception("rl::plan::Toppra::process() - Path cannot be traversed with given limits");
+				}
+				
+				::rl::math::Polynomial<::rl::math::Vector> polynomial = ::rl::math::Polynomial<::rl::math::Vector>::CubicFirst(
+					q[i],
+					q[i + 1],
+					qd[i] * sd0,
+					qd[i + 1] * sd1,
+					2 * delta / (sd0 + sd1)
+				);
+				trajectory.push_back(polynomial);
+			}
+			
+			return trajectory;
+		}
+		
+		::rl::math::Spline<::rl::math::Vector>
+		Toppra::process(const VectorList& path)
+		{
+			return this->process(Path(path));
+		}
+		
+		::rl::math::Spline<::rl::math::Vector>
+		Toppra::process(const Path& path)
+		{
+			assert(path.size() > 1);
+			
+			// indices of corners, skipping repeated waypoints and waypoints on a straight line
+			
+			::std::vector<::std::size_t> corners(1, 0);
+			
+			for (::std::size_t i = 1; i < path.size(); ++i)
+			{
+				::rl::math::Vector direction = path[i] - path[corners.back()];
+				
+				if (direction.norm() <= 0)
+				{
+					continue;
+				}
+				
+				if (corners.size() > 1)
+				{
+					::rl::math::Vector previous = path[corners.back()] - path[corners[corners.size() - 2]];
+					
+					if (previous.normalized().dot(direction.normalized()) > 1 - ::Eigen::NumTraits<::rl::math::Real>::dummy_precision())
+					{
+						corners.back() = i;
+						continue;
+					}
+				}
+				
+				corners.push_back(i);
+			}
+			
+			if (corners.size() < 2)
+			{
+				throw Exception("rl::plan::Toppra::process() - Path has zero length");
+			}
+			
+			::rl::math::Spline<::rl::math::Vector> trajectory;
+			
+			for (::std::size_t i = 0; i < corners.size() - 1; ++i)
+			{
+				::rl::math::Vector y0 = path[corners[i]];
+				::rl::math::Vector y1 = path[corners[i + 1]];
+				
+				::rl::math::Spline<::rl::math::Vector> segment;
+				::rl::math::Polynomial<::rl::math::Vector> linear = ::rl::math::Polynomial<::rl::math::Vector>::Linear(y0, y1, (y1 - y0).norm());
+				segment.push_back(linear);
+				
+				::rl::math::Spline<::rl::math::Vector> timed = this->process(segment);
+				trajectory.push_back(timed);
+			}
+			
+			return trajectory;
+		}
+		
+		bool
+		Toppra::project(const ::std::vector<Constraint>& constraints, ::rl::math::Real& min, ::rl::math::Real& max)
+		{
+			// Fourier-Motzkin elimination of u, pairing each upper with each lower bound
+			
+			min = -::std::numeric_limits<::rl::math::Real>::infinity();
+			max = ::std::numeric_limits<::rl::math::Real>::infinity();
+			
+			for (::std::size_t i = 0; i < constraints.size(); ++i)
+			{
+				const Constraint& upper = constraints[i];
+				
+				if (upper.a > 0)
+				{
+					for (::std::size_t j = 0; j < constraints.size(); ++j)
+					{
+						const Constraint& lower = constraints[j];
+						
+						if (lower.a < 0)
+						{
+							::rl::math::Real b = lower.b / lower.a - upper.b / upper.a;
+							::rl::math::Real c = lower.c / lower.a - upper.c / upper.a;
+							
+							if (b > 0)
+							{
+								min = ::std::max(min, c / b);
+							}
+							else if (b < 0)
+							{
+								max = ::std::min(max, c / b);
+							}
+							else if (c > 0)
+							{
+								return false;
+							}
+						}
+					}
+				}
+				else if (upper.a == 0)
+				{
+					if (upper.b > 0)
+					{
+						max = ::std::min(max, upper.c / upper.b);
+					}
+					else if (upper.b < 0)
+					{
+						min = ::std::max(min, upper.c / upper.b);
+					}
+					else if (upper.c < 0)
+					{
+						return false;
+					}
+				}
+			}
+			
+			return min <= max;
+		}
+		
+		void
+		Toppra::setAcceleration(const ::rl::math::Vector& acceleration)
+		{
+			this->acceleration = acceleration;
+		}
+		
+		void
+		Toppra::setDynamic(::rl::mdl::Dynamic* dynamic)
+		{
+			this->dynamic = dynamic;
+		}
+		
+		void
+		Toppra::setGridPoints(const ::std::size_t& gridPoints)
+		{
+			this->gridPoints = gridPoints;
+		}
+		
+		void
+		Toppra::setModel(Model* model)
+		{
+			this->model = model;
+		}
+		
+		void
+		Toppra::setTorque(const ::rl::math::Vector& torque)
+		{
+			this->torque = torque;
+		}
+		
+		void
+		Toppra::setVelocity(const ::rl::math::Vector& velocity)
+		{
+			this->velocity = velocity;
+		}
+	}
+}
@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_TOPPRA_H
+#define RL_PLAN_TOPPRA_H
+
+#include <vector>
+#include <rl/math/Spline.h>
+#include <rl/math/Vector.h>
+#include <rl/plan/export.h>
+
+#include "Path.h"
+#include "VectorList.h"
+
+namespace rl
+{
+	namespace mdl
+	{
+		class Dynamic;
+	}
+	
+	namespace plan
+	{
+		class Model;
+		
+		/**
+		 * Time-optimal path parameterization based on reachability analysis.
+		 *
+		 * Computes the fastest timing along a geometric path that respects
+		 * joint velocity, acceleration, and optionally torque limits. The path
+		 * is sampled at a fixed number of grid points, a backward pass
+		 * computes the controllable sets of squared path velocities and a
+		 * greedy forward pass selects the maximum path acceleration. Runtime
+		 * is linear in the number of grid points.
+		 *
+		 * Hung Pham and Quang-Cuong Pham. A new approach to time-optimal path
+		 * parameterization based on reachability analysis. IEEE Transactions on
+		 * Robotics, 34(3):645-659, June 2018.
+		 *
+		 * http://dx.doi.org/10.1109/TRO.2018.2819195
+		 */
+		class RL_PLAN_EXPORT Toppra
+		{
+		public:
+			Toppra();
+			
+			virtual ~Toppra();
+			
+			const ::rl::math::Vector& getAcceleration() const;
+			
+			::rl::mdl::Dynamic* getDynamic() const;
+			
+			::std::size_t getGridPoints() const;
+			
+			Model* getModel() const;
+			
+			const ::rl::math::Vector& getTorque() const;
+			
+			const ::rl::math::Vector& getVelocity() const;
+			
+			/**
+			 * Parameterize path given as function of path parameter.
+			 *
+			 * The trajectory starts and ends at rest.
+			 *
+			 * @return Trajectory as cubic Hermite spline between grid points.
+			 * @throws Exception If limits cannot be satisfied, e.g., torque
+			 * limits below gravity load, or if no velocity limits and no model
+			 * are specified.
+			 */
+			::rl::math::Spline<::rl::math::Vector> process(const ::rl::math::Spline<::rl::math::Vector>& path);
+			
+			/**
+			 * Parameterize path given as list of waypoints.
+			 *
+			 * Waypoints are connected by straight segments as verified by a
+			 * planner. The trajectory comes to rest at each waypoint where the
+			 * direction changes, waypoints on a straight line are passed without
+			 * stopping. Each segment is sampled with the given number of grid
+			 * points.
+			 */
+			::rl::math::Spline<::rl::math::Vector> process(const VectorList& path);
+			
+			/**
+			 * Parameterize path given as contiguous waypoints.
+			 *
+			 * @see process(const VectorList&)
+			 */
+			::rl::math::Spline<::rl::math::Vector> process(const Path& path);
+			
+			/**
+			 * Set maximum joint accelerations.
+			 */
+			void setAcceleration(const ::rl::math::Vector& acceleration);
+			
+			/**
+			 * Set dynamic model for torque limits, nullptr disables them.
+			 *
+			 * The current world gravity of the model is used.
+			 */
+			void setDynamic(::rl::mdl::Dynamic* dynamic);
+			
+			void setGridPoints(const ::std::size_t& gridPoints);
+			
+			void setModel(Model* model);
+			
+			/**
+			 * Set maximum joint torques, used with a dynamic model.
+			 */
+			void setTorque(const ::rl::math::Vector& torque);
+			
+			/**
+			 * Set maximum joint velocities.
+			 *
+			 * If empty, the speed limits of the kinematic model are used, a
+			 * model is then required.
+			 */
+			void setVelocity(const ::rl::math::Vector& velocity);
+			
+			::rl::math::Vector acceleration;
+			
+			::rl::mdl::Dynamic* dynamic;
+			
+			::std::size_t gridPoints;
+			
+			Model* model;
+			
+			::rl::math::Vector torque;
+			
+			::rl::math::Vector velocity;
+			
+		protected:
+			
+		private:
+			/** Linear constraint a * u + b * x <= c on path acceleration u and squared path velocity x. */
+			struct Constraint
+			{
+				::rl::math::Real a;
+				
+				::rl::math::Real b;
+				
+				::rl::math::Real c;
+			};
+			
+			static bool project(const ::std::vector<Constraint>& constraints, ::rl::math::Real& min, ::rl::math::Real& max);
+		};
+	}
+}
+
+#endif // RL_PLAN_TOPPRA_H
@@ -0,0 +1,132 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include "Exception.h"
+#include "VectorPool.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		VectorPool::VectorPool(const ::std::size_t& blockSize) :
+			block(0),
+			blocks(),
+			blockSize(blockSize),
+			index(0)
+		{
+		}
+		
+		VectorPool::~VectorPool()
+		{
+		}
+		
+		VectorPtr
+		VectorPool::allocate(const ::std::size_t& size)
+		{
+			assert(this->blockSize > 0);
+			
+			if (this->index == this->blockSize)
+			{
+				++this->block;
+				this->index = 0;
+			}
+			
+			if (this->block == this->blocks.size())
+			{
+				this->blocks.push_back(::std::make_shared<Block>(this->blockSize));
+			}
+			
+			::std::shared_ptr<Block>& block = this->blocks[this->block];
+			::rl::math::Vector* q = &(*block)[this->index];
+			++this->index;
+			
+			if (q->size() != static_cast<::std::ptrdiff_t>(size))
+			{
+				q->resize(size);
+			}
+			
+			return VectorPtr(block, q);
+		}
+		
+		VectorPtr
+		VectorPool::allocate(const ::rl::math::Vector& q)
+		{
+			VectorPtr ptr = this->allocate(q.size());
+			*ptr = q;
+			return ptr;
+		}
+		
+		::std::size_t
+		VectorPool::capacity() const
+		{
+			return this->blocks.size() * this->blockSize;
+		}
+		
+		void
+		VectorPool::clear()
+		{
+			this->block = 0;
+			this->index = 0;
+		}
+		
+		void
+		VectorPool::deallocate(const VectorPtr& q)
+		{
+			if (0 == this->index || q.get() != &(*this->blocks[this->block])[this->index - 1])
+			{
+				throw Exception("rl::plan::VectorPool::deallocate() - Configuration is not the most recently allocated one");
+			}
+			
+			--this->index;
+		}
+		
+		::std::size_t
+		VectorPool::getBlockSize() const
+		{
+			return this->blockSize;
+		}
+		
+		void
+		VectorPool::release()
+		{
+			this->blocks.clear();
+			this->clear();
+		}
+		
+		void
+		VectorPool::setBlockSize(const ::std::size_t& blockSize)
+		{
+			this->release();
+			this->blockSize = blockSize;
+		}
+		
+		::std::size_t
+		VectorPool::size() const
+		{
+			return this->block * this->blockSize + this->index;
+		}
+	}
+}
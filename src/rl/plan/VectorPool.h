@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_VECTORPOOL_H
+#define RL_PLAN_VECTORPOOL_H
+
+#include <memory>
+#include <vector>
+#include <rl/math/Vector.h>
+#include <rl/plan/export.h>
+
+#include "VectorPtr.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		/**
+		 * Block allocator for configurations.
+		 *
+		 * Configurations are handed out from blocks of preallocated vectors
+		 * with stable addresses, so a VectorPtr returned by allocate() does not
+		 * need its own control block and its address can be stored directly in
+		 * a Metric::Value. After clear(), all slots are reused in order and keep
+		 * their coefficient storage, so repeated planner runs with the same
+		 * number of degrees of freedom do not allocate.
+		 */
+		class RL_PLAN_EXPORT VectorPool
+		{
+		public:
+			VectorPool(const ::std::size_t& blockSize = 1024);
+			
+			virtual ~VectorPool();
+			
+			/**
+			 * Get configuration of given size from pool.
+			 *
+			 * The returned pointer shares ownership of its block, it remains
+			 * valid after clear(), but its slot will be handed out again.
+			 */
+			VectorPtr allocate(const ::std::size_t& size);
+			
+			/**
+			 * Get configuration from pool initialized with given value.
+			 */
+			VectorPtr allocate(const ::rl::math::Vector& q);
+			
+			::std::size_t capacity() const;
+			
+			/**
+			 * Make all slots available again without releasing memory.
+			 */
+			void clear();
+			
+			/**
+			 * Return most recently allocated configuration to pool.
+			 *
+			 * Used for discarding a candidate configuration, e.g., after a
+			 * failed collision check. Throws an Exception if the configuration
+			 * is not the most recently allocated one.
+			 */
+			void deallocate(const VectorPtr& q);
+			
+			::std::size_t getBlockSize() const;
+			
+			/**
+			 * Release all blocks.
+			 */
+			void release();
+			
+			void setBlockSize(const ::std::size_t& blockSize);
+			
+			::std::size_t size() const;
+			
+		protected:
+			
+		private:
+			typedef ::std::vector<::rl::math::Vector> Block;
+			
+			::std::size_t block;
+			
+			::std::vector<::std::shared_ptr<Block>> blocks;
+			
+			::std::size_t blockSize;
+			
+			::std::size_t index;
+		};
+	}
+}
+
+#endif // RL_PLAN_VECTORPOOL_H
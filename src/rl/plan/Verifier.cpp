@@ -24,6 +24,9 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <utility>
+
+#include "SimpleModel.h"
 #include "Verifier.h"
 
 namespace rl
@@ -32,7 +35,8 @@ namespace rl
 	{
 		Verifier::Verifier() :
 			delta(1),
-			model(nullptr)
+			model(nullptr),
+			models()
 		{
 		}
 		
@@ -52,12 +56,172 @@ namespace rl
 			return this->model;
 		}
 		
+		const ::std::vector<SimpleModel*>&
+		Verifier::getModels() const
+		{
+			return this->models.getModels();
+		}
+		
 		::std::size_t
 		Verifier::getSteps(const ::rl::math::Real& d)
 		{
 			return static_cast<::std::size_t>(::std::ceil(d / this->delta));
 		}
 		
+		::std::vector<bool>
+		Verifier::isColliding(const ::std::vector<Segment>& segments)
+		{
+			typedef ::std::pair<::std::size_t, ::std::size_t> Interval;
+			
+			struct State
+			{
+				::std::size_t midpoint;
+				
+				::std::size_t segment;
+			};
+			
+			::std::vector<bool> colliding(segments.size(), false);
+			::std::vector<::std::size_t> steps(segments.size());
+			::std::vector<::std::vector<Interval>> intervals(segments.size());
+			
+			for (::std::size_t i = 0; i < segments.size(); ++i)
+			{
+				assert(segments[i].u->size() == this->getModel()->getDofPosition());
+				assert(segments[i].v->size() == this->getModel()->getDofPosition());
+				
+				steps[i] = this->getSteps(segments[i].d);
+				
+				if (steps[i] > 1)
+				{
+					intervals[i].emplace_back(1, steps[i] - 1);
+				}
+			}
+			
+			::std::vector<State> states;
+			::std::vector<unsigned char> results;
+			::std::vector<Interval> next;
+			
+			while (true)
+			{
+				states.clear();
+				
+				for (::std::size_t i = 0; i < segments.size(); ++i)
+				{
+					next.clear();
+					
+					for (::std::size_t j = 0; j < intervals[i].size(); ++j)
+					{
+						State state;
+						state.midpoint = (intervals[i][j].first + intervals[i][j].second) / 2;
+						state.segment = i;
+						states.push_back(state);
+						
+						if (intervals[i][j].first < state.midpoint)
+						{
+							next.emplace_back(intervals[i][j].first, state.midpoint - 1);
+						}
+						
+						if (intervals[i][j].second > state.midpoint)
+						{
+							next.emplace_back(state.midpoint + 1, intervals[i][j].second);
+						}
+					}
+					
+					intervals[i].swap(next);
+				}
+				
+				if (states.empty())
+				{
+					break;
+				}
+				
+				results.assign(states.size(), 0);
+				
+				this->models.begin();
+				
+#ifdef _OPENMP
+				int threads = this->models.getThreads();
+				
+#pragma omp parallel num_threads(threads) if (threads > 1)
+#endif
+				{
+					SimpleModel* model = this->models.getModel(this->getModel());
+					::rl::math::Vector inter(model->getDofPosition());
+					
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#if _OPENMP < 200805
+					for (::std::ptrdiff_t i = 0; i < states.size(); ++i)
+#else
+					for (::std::size_t i = 0; i < states.size(); ++i)
+#endif
+#else
+					for (::std::size_t i = 0; i < states.size(); ++i)
+#endif
+					{
+						const Segment& segment = segments[states[i].segment];
+						
+						model->interpolate(
+							*segment.u,
+							*segment.v,
+							static_cast<::rl::math::Real>(states[i].midpoint) / static_cast<::rl::math::Real>(steps[states[i].segment]),
+							inter
+						);
+						
+						results[i] = model->isColliding(inter) ? 1 : 0;
+					}
+				}
+				
+				this->models.end(this->getModel());
+				
+				for (::std::size_t i = 0; i < states.size(); ++i)
+				{
+					if (results[i] > 0)
+					{
+						colliding[states[i].segment] = true;
+						intervals[states[i].segment].clear();
+					}
+				}
+			}
+			
+			return colliding;
+		}
+		
+		::std::vector<bool>
+		Verifier::isColliding(const ::std::vector<::rl::math::Vector>& states)
+		{
+			::std::vector<unsigned char> results(states.size(), 0);
+			
+			this->models.begin();
+			
+#ifdef _OPENMP
+			int threads = this->models.getThreads();
+			
+#pragma omp parallel num_threads(threads) if (threads > 1)
+#endif
+			{
+				SimpleModel* model = this->models.getModel(this->getModel());
+				
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#if _OPENMP < 200805
+				for (::std::ptrdiff_t i = 0; i < states.size(); ++i)
+#else
+				for (::std::size_t i = 0; i < states.size(); ++i)
+#endif
+#else
+				for (::std::size_t i = 0; i < states.size(); ++i)
+#endif
+				{
+					results[i] = model->isColliding(states[i]) ? 1 : 0;
+				}
+			}
+			
+			this->models.end(this->getModel());
+			
+			return ::std::vector<bool>(results.begin(), results.end());
+		}
+		
 		void
 		Verifier::setDelta(const ::rl::math::Real& delta)
 		{
@@ -69,5 +233,25 @@ namespace rl
 		{
 			this->model = model;
 		}
+		
+		void
+		Verifier::setModels(const ::std::vector<SimpleModel*>& models)
+		{
+			this->models.setModels(models);
+		}
+		
+		Verifier::Segment::Segment() :
+			u(nullptr),
+			v(nullptr),
+			d(0)
+		{
+		}
+		
+		Verifier::Segment::Segment(const ::rl::math::Vector* u, const ::rl::math::Vector* v, const ::rl::math::Real& d) :
+			u(u),
+			v(v),
+			d(d)
+		{
+		}
 	}
 }
@@ -27,9 +27,12 @@
 #ifndef RL_PLAN_VERIFIER_H
 #define RL_PLAN_VERIFIER_H
 
+#include <vector>
 #include <rl/math/Vector.h>
 #include <rl/plan/export.h>
 
+#include "WorkerModels.h"
+
 namespace rl
 {
 	namespace plan
@@ -39,6 +42,19 @@ namespace rl
 		class RL_PLAN_EXPORT Verifier
 		{
 		public:
+			struct Segment
+			{
+				Segment();
+				
+				Segment(const ::rl::math::Vector* u, const ::rl::math::Vector* v, const ::rl::math::Real& d);
+				
+				const ::rl::math::Vector* u;
+				
+				const ::rl::math::Vector* v;
+				
+				::rl::math::Real d;
+			};
+			
 			Verifier();
 			
 			virtual ~Verifier();
@@ -47,18 +63,59 @@ namespace rl
 			
 			SimpleModel* getModel() const;
 			
+			const ::std::vector<SimpleModel*>& getModels() const;
+			
 			virtual ::std::size_t getSteps(const ::rl::math::Real& d);
 			
 			virtual bool isColliding(const ::rl::math::Vector& u, const ::rl::math::Vector& v, const ::rl::math::Real& d) = 0;
 			
+			/**
+			 * Verify multiple segments.
+			 *
+			 * Intermediate states are checked in recursive midpoint order, with
+			 * all segments advancing one level of recursion per round. Checking
+			 * a segment stops at its first colliding state. With OpenMP, the
+			 * states of a round are distributed over threads, each using its own
+			 * model from getModels().
+			 *
+			 * This matches the result of the single segment check of verifiers
+			 * testing all intermediate states. Verifiers skipping states, e.g.,
+			 * based on clearance, override this.
+			 *
+			 * @return Collision result per segment.
+			 */
+			virtual ::std::vector<bool> isColliding(const ::std::vector<Segment>& segments);
+			
+			/**
+			 * Check multiple states for collision.
+			 *
+			 * Used for states not covered by segments, e.g., new end points.
+			 * With OpenMP, states are distributed over threads as in batch
+			 * verification of segments.
+			 *
+			 * @return Collision result per state.
+			 */
+			::std::vector<bool> isColliding(const ::std::vector<::rl::math::Vector>& states);
+			
 			void setDelta(const ::rl::math::Real& delta);
 			
 			void setModel(SimpleModel* model);
 			
+			/**
+			 * Set models used by worker threads in batch verification.
+			 *
+			 * If empty, segments are verified with getModel() only. Queries of
+			 * worker models are added to the counters of getModel().
+			 */
+			void setModels(const ::std::vector<SimpleModel*>& models);
+			
 			::rl::math::Real delta;
 			
 			SimpleModel* model;
 			
+			/** Models for worker threads in batch verification. */
+			WorkerModels models;
+			
 		protected:
 			
 		private:
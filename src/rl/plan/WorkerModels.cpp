@@ -0,0 +1,114 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "SimpleModel.h"
+#include "WorkerModels.h"
+
+namespace rl
+{
+	namespace plan
+	{
+		WorkerModels::WorkerModels() :
+			freeQueries(),
+			models(),
+			totalQueries()
+		{
+		}
+		
+		WorkerModels::~WorkerModels()
+		{
+		}
+		
+		void
+		WorkerModels::begin()
+		{
+			this->freeQueries.resize(this->models.size());
+			this->totalQueries.resize(this->models.size());
+			
+			for (::std::size_t i = 0; i < this->models.size(); ++i)
+			{
+				this->freeQueries[i] = this->models[i]->getFreeQueries();
+				this->totalQueries[i] = this->models[i]->getTotalQueries();
+			}
+		}
+		
+		void
+		WorkerModels::end(SimpleModel* model)
+		{
+			for (::std::size_t i = 0; i < this->models.size() && i < this->totalQueries.size(); ++i)
+			{
+				if (this->models[i] != model)
+				{
+					model->addQueries(
+						this->models[i]->getFreeQueries() - this->freeQueries[i],
+						this->models[i]->getTotalQueries() - this->totalQueries[i]
+					);
+				}
+			}
+			
+			this->freeQueries.clear();
+			this->totalQueries.clear();
+		}
+		
+		SimpleModel*
+		WorkerModels::getModel(SimpleModel* fallback) const
+		{
+#ifdef _OPENMP
+			return this->models.empty() ? fallback : this->models[::omp_get_thread_num()];
+#else
+			return fallback;
+#endif
+		}
+		
+		const ::std::vector<SimpleModel*>&
+		WorkerModels::getModels() const
+		{
+			return this->models;
+		}
+		
+		int
+		WorkerModels::getThreads() const
+		{
+#ifdef _OPENMP
+			return ::std::max(1, ::std::min(::omp_get_max_threads(), static_cast<int>(this->models.size())));
+#else
+			return 1;
+#endif
+		}
+		
+		void
+		WorkerModels::setModels(const ::std::vector<SimpleModel*>& models)
+		{
+			this->models = models;
+		}
+	}
+}
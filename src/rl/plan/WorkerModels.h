@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef RL_PLAN_WORKERMODELS_H
+#define RL_PLAN_WORKERMODELS_H
+
+#include <vector>
+#include <rl/plan/export.h>
+
+namespace rl
+{
+	namespace plan
+	{
+		class SimpleModel;
+		
+		/**
+		 * Models used by worker threads of parallel queries.
+		 *
+		 * Each model needs its own kinematics and scene instance. Within an
+		 * OpenMP parallel region, getModel() returns the model of the calling
+		 * thread. Without models or without OpenMP, queries use the given
+		 * fallback model in the calling thread.
+		 */
+		class RL_PLAN_EXPORT WorkerModels
+		{
+		public:
+			WorkerModels();
+			
+			virtual ~WorkerModels();
+			
+			/**
+			 * Record query counters of worker models before a parallel region.
+			 */
+			void begin();
+			
+			/**
+			 * Add queries of worker models since begin() to query counters of model.
+			 */
+			void end(SimpleModel* model);
+			
+			/**
+			 * Get model of calling thread, fallback if no models are set.
+			 */
+			SimpleModel* getModel(SimpleModel* fallback) const;
+			
+			const ::std::vector<SimpleModel*>& getModels() const;
+			
+			/**
+			 * Get number of threads for a parallel region, at most one per model.
+			 */
+			int getThreads() const;
+			
+			void setModels(const ::std::vector<SimpleModel*>& models);
+			
+		protected:
+			
+		private:
+			::std::vector<::std::size_t> freeQueries;
+			
+			::std::vector<SimpleModel*> models;
+			
+			::std::vector<::std::size_t> totalQueries;
+		};
+	}
+}
+
+#endif // RL_PLAN_WORKERMODELS_H
@@ -24,7 +24,10 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <functional>
 
 #include "DistanceModel.h"
 #include "Viewer.h"
@@ -56,9 +59,12 @@ namespace rl
 			begin(nullptr),
 			end(nullptr),
 			graph(),
+			grid(),
+			levels(),
 			queue(),
 			randDistribution(0, 1),
-			randEngine(::std::random_device()())
+			randEngine(::std::random_device()()),
+			sequence(0)
 		{
 		}
 		
@@ -83,8 +89,25 @@ namespace rl
 		WorkspaceSphereExplorer::addVertex(const WorkspaceSphere& sphere)
 		{
 			Vertex vertex = ::boost::add_vertex(this->graph);
+			this->graph[vertex].index = ::boost::num_vertices(this->graph) - 1;
 			this->graph[vertex].sphere = sphere;
 			
+			// spheres without positive radius cover no point
+			if (sphere.radius > 0)
+			{
+				int level;
+				::std::frexp(sphere.radius, &level);
+				
+				this->grid[WorkspaceSphereExplorer::cell(level, *sphere.center, 0)].push_back(vertex);
+				
+				::std::vector<int>::iterator i = ::std::lower_bound(this->levels.begin(), this->levels.end(), level);
+				
+				if (this->levels.end() == i || *i != level)
+				{
+					this->levels.insert(i, level);
+				}
+			}
+			
 #ifndef PRINT_WORKSPACE_PATH
 			if (nullptr != this->viewer)
 			{
@@ -96,6 +119,33 @@ namespace rl
 			return vertex;
 		}
 		
+		WorkspaceSphereExplorer::Cell
+		WorkspaceSphereExplorer::cell(const int& level, const ::rl::math::Vector3& point, const ::rl::math::Real& offset)
+		{
+			Cell cell;
+			cell[0] = level;
+			
+			for (::std::size_t i = 0; i < 3; ++i)
+			{
+				cell[i + 1] = static_cast<::std::int64_t>(::std::floor(::std::ldexp(point(i), -level - 1) + offset));
+			}
+			
+			return cell;
+		}
+		
+		::std::size_t
+		WorkspaceSphereExplorer::CellHash::operator()(const Cell& cell) const
+		{
+			::std::size_t hash = 0;
+			
+			for (::std::size_t i = 0; i < cell.size(); ++i)
+			{
+				hash ^= ::std::hash<::std::int64_t>()(cell[i]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			}
+			
+			return hash;
+		}
+		
 		bool
 		WorkspaceSphereExplorer::explore()
 		{
@@ -110,13 +160,20 @@ namespace rl
 			
 			start.priority = (*this->goal - *start.center).norm() - start.radius;
 			
-			this->queue.insert(start);
+			this->push(start);
 			
 			while (!this->queue.empty())
 			{
-				WorkspaceSphere top = *this->queue.begin();
+				QueueEntry entry = this->queue.top();
+				this->queue.pop();
+				
+				// sphere is discarded if its center was covered by a later vertex while queued
+				if (this->isCovered(*entry.sphere.center, nullptr, entry.first))
+				{
+					continue;
+				}
 				
-				this->queue.erase(this->queue.begin());
+				const WorkspaceSphere& top = entry.sphere;
 				
 				if (top.radius >= this->radius)
 				{
@@ -153,23 +210,6 @@ namespace rl
 						return true;
 					}
 					
-					::std::multiset<WorkspaceSphere>::iterator i = this->queue.begin();
-					::std::multiset<WorkspaceSphere>::iterator j;
-					
-					while (i != this->queue.end())
-					{
-						if ((*i->center - *top.center).norm() < top.radius)
-						{
-							j = i;
-							++i;
-							this->queue.erase(j);
-						}
-						else
-						{
-							++i;
-						}
-					}
-					
 					for (::std::size_t i = 0; i < ::std::ceil(this->samples * top.radius); ++i)
 //for (::std::size_t i = 0; i < this->samples; ++i) // TODO
 					{
@@ -206,7 +246,7 @@ namespace rl
 										break;
 									}
 									
-									this->queue.insert(sphere);
+									this->push(sphere);
 								}
 							}
 						}
@@ -241,6 +281,12 @@ namespace rl
 			return this->model;
 		}
 		
+		::std::size_t
+		WorkspaceSphereExplorer::getNumVertices() const
+		{
+			return ::boost::num_vertices(this->graph);
+		}
+		
 		WorkspaceSphereList
 		WorkspaceSphereExplorer::getPath() const
 		{
@@ -309,27 +355,52 @@ namespace rl
 		bool
 		WorkspaceSphereExplorer::isCovered(const ::rl::math::Vector3& point) const
 		{
-			for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
-			{
-				if ((point - *this->graph[*i.first].sphere.center).norm() < this->graph[*i.first].sphere.radius)
-				{
-					return true;
-				}
-			}
-			
-			return false;
+			return this->isCovered(point, nullptr, 0);
 		}
 		
 		bool
 		WorkspaceSphereExplorer::isCovered(const Vertex& parent, const ::rl::math::Vector3& point) const
 		{
-			for (VertexIteratorPair i = ::boost::vertices(this->graph); i.first != i.second; ++i.first)
+			return this->isCovered(point, &parent, 0);
+		}
+		
+		bool
+		WorkspaceSphereExplorer::isCovered(const ::rl::math::Vector3& point, const Vertex* parent, const ::std::size_t& first) const
+		{
+			for (::std::size_t i = 0; i < this->levels.size(); ++i)
 			{
-				if (parent != this->graph[*i.first].sphere.parent)
+				// covering centers are closer than half a cell, so they lie in the two cells per axis nearest to point
+				Cell nearest = WorkspaceSphereExplorer::cell(this->levels[i], point, static_cast<::rl::math::Real>(-0.5));
+				Cell cell = nearest;
+				
+				for (cell[1] = nearest[1]; cell[1] <= nearest[1] + 1; ++cell[1])
 				{
-					if ((point - *this->graph[*i.first].sphere.center).norm() < this->graph[*i.first].sphere.radius)
+					for (cell[2] = nearest[2]; cell[2] <= nearest[2] + 1; ++cell[2])
 					{
-						return true;
+						for (cell[3] = nearest[3]; cell[3] <= nearest[3] + 1; ++cell[3])
+						{
+							::std::unordered_map<Cell, ::std::vector<Vertex>, CellHash>::const_iterator vertices = this->grid.find(cell);
+							
+							if (this->grid.end() == vertices)
+							{
+								continue;
+							}
+							
+							for (::std::size_t j = 0; j < vertices->second.size(); ++j)
+							{
+								const VertexBundle& vertex = this->graph[vertices->second[j]];
+								
+								if (vertex.index < first || (nullptr != parent && *parent == vertex.sphere.parent))
+								{
+									continue;
+								}
+								
+								if ((point - *vertex.sphere.center).norm() < vertex.sphere.radius)
+								{
+									return true;
+								}
+							}
+						}
 					}
 				}
 			}
@@ -337,6 +408,30 @@ namespace rl
 			return false;
 		}
 		
+		void
+		WorkspaceSphereExplorer::push(const WorkspaceSphere& sphere)
+		{
+			this->queue.push(QueueEntry(sphere, ::boost::num_vertices(this->graph), this->sequence++));
+		}
+		
+		WorkspaceSphereExplorer::QueueEntry::QueueEntry(const WorkspaceSphere& sphere, const ::std::size_t& first, const ::std::size_t& sequence) :
+			first(first),
+			sequence(sequence),
+			sphere(sphere)
+		{
+		}
+		
+		bool
+		WorkspaceSphereExplorer::QueueEntry::operator<(const QueueEntry& rhs) const
+		{
+			if (this->sphere.priority != rhs.sphere.priority)
+			{
+				return rhs.sphere.priority < this->sphere.priority;
+			}
+			
+			return this->sequence > rhs.sequence;
+		}
+		
 		::std::uniform_real_distribution<::rl::math::Real>::result_type
 		WorkspaceSphereExplorer::rand()
 		{
@@ -347,7 +442,10 @@ namespace rl
 		WorkspaceSphereExplorer::reset()
 		{
 			this->graph.clear();
-			this->queue.clear();
+			this->grid.clear();
+			this->levels.clear();
+			this->queue = ::std::priority_queue<QueueEntry>();
+			this->sequence = 0;
 			this->begin = nullptr;
 			this->end = nullptr;
 		}
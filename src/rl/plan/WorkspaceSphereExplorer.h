@@ -27,9 +27,13 @@
 #ifndef RL_PLAN_WORKSPACESPHEREEXPLORER_H
 #define RL_PLAN_WORKSPACESPHEREEXPLORER_H
 
+#include <array>
+#include <cstdint>
 #include <list>
+#include <queue>
 #include <random>
-#include <set>
+#include <unordered_map>
+#include <vector>
 #include <boost/graph/adjacency_list.hpp>
 #include <rl/math/AlignedBox.h>
 #include <rl/math/Vector.h>
@@ -82,6 +86,8 @@ namespace rl
 			
 			DistanceModel* getModel() const;
 			
+			::std::size_t getNumVertices() const;
+			
 			WorkspaceSphereList getPath() const;
 			
 			::rl::math::Real getRadius() const;
@@ -94,6 +100,12 @@ namespace rl
 			
 			Viewer* getViewer() const;
 			
+			/**
+			 * Test if point lies within an explored sphere.
+			 *
+			 * Uses a hierarchical hash grid over sphere centers, so only spheres
+			 * of nearby cells are tested.
+			 */
 			bool isCovered(const ::rl::math::Vector3& point) const;
 			
 			void reset();
@@ -137,8 +149,38 @@ namespace rl
 			Viewer* viewer;
 			
 		protected:
+			/** Cell of hash grid, consisting of level and integer coordinates. */
+			typedef ::std::array<::std::int64_t, 4> Cell;
+			
+			struct CellHash
+			{
+				::std::size_t operator()(const Cell& cell) const;
+			};
+			
+			/**
+			 * Queued sphere.
+			 *
+			 * Ordered by priority and then by insertion, with the highest entry
+			 * having the lowest priority value.
+			 */
+			struct QueueEntry
+			{
+				QueueEntry(const WorkspaceSphere& sphere, const ::std::size_t& first, const ::std::size_t& sequence);
+				
+				bool operator<(const QueueEntry& rhs) const;
+				
+				/** Number of vertices when queued, later vertices covering the center discard the sphere. */
+				::std::size_t first;
+				
+				::std::size_t sequence;
+				
+				WorkspaceSphere sphere;
+			};
+			
 			struct VertexBundle
 			{
+				::std::size_t index;
+				
 				WorkspaceSphere sphere;
 			};
 			
@@ -165,8 +207,22 @@ namespace rl
 			
 			Vertex addVertex(const WorkspaceSphere& sphere);
 			
+			/**
+			 * Cell of level containing point, shifted by offset in units of the cell size.
+			 */
+			static Cell cell(const int& level, const ::rl::math::Vector3& point, const ::rl::math::Real& offset);
+			
 			bool isCovered(const Vertex& parent, const ::rl::math::Vector3& point) const;
 			
+			/**
+			 * Test if point lies within a sphere of the vertices starting at index first.
+			 *
+			 * Vertices whose sphere has the specified parent are ignored.
+			 */
+			bool isCovered(const ::rl::math::Vector3& point, const Vertex* parent, const ::std::size_t& first) const;
+			
+			void push(const WorkspaceSphere& sphere);
+			
 			::std::uniform_real_distribution<::rl::math::Real>::result_type rand();
 			
 			Vertex begin;
@@ -175,12 +231,26 @@ namespace rl
 			
 			Graph graph;
 			
-			::std::multiset<WorkspaceSphere> queue;
+			/**
+			 * Vertices by grid cell of their center.
+			 *
+			 * A sphere with radius r is stored in the level l with 2^(l-1) <= r < 2^l
+			 * and cell size 2^(l+1), so covering spheres of a point are found in the
+			 * 2x2x2 cells nearest to it.
+			 */
+			::std::unordered_map<Cell, ::std::vector<Vertex>, CellHash> grid;
+			
+			/** Sorted levels of hash grid containing vertices. */
+			::std::vector<int> levels;
+			
+			::std::priority_queue<QueueEntry> queue;
 			
 			::std::uniform_real_distribution<::rl::math::Real> randDistribution;
 			
 			::std::mt19937 randEngine;
 			
+			::std::size_t sequence;
+			
 		private:
 			
 		};
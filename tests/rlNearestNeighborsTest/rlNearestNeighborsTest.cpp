@@ -1,8 +1,12 @@
+#include <atomic>
 #include <chrono>
 #include <iostream>
+#include <thread>
 #include <vector>
+#include <rl/math/ConcurrentNearestNeighbors.h>
 #include <rl/math/GnatNearestNeighbors.h>
 #include <rl/math/KdtreeBoundingBoxNearestNeighbors.h>
+#include <rl/math/KdtreeBucketNearestNeighbors.h>
 #include <rl/math/KdtreeNearestNeighbors.h>
 #include <rl/math/LinearNearestNeighbors.h>
 #include <rl/math/Vector.h>
@@ -11,10 +15,12 @@
 
 #include "iterator.h"
 
+#define CHECKS 1000
 #define DIM 6
 #define K 30
 #define N 100000
 #define QUERIES 100
+#define THREADS 4
 
 template<typename NearestNeighbors>
 std::vector<std::vector<typename NearestNeighbors::Neighbor>>
@@ -103,6 +109,9 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 	std::cout << "** KdtreeBoundingBoxNearestNeighbors<MetricSquared> ***************************" << std::endl;
 	std::vector<std::vector<rl::math::KdtreeBoundingBoxNearestNeighbors<MetricSquared>::Neighbor>> kdtreeBoundingBox = test<rl::math::KdtreeBoundingBoxNearestNeighbors<MetricSquared>>(points, queries, iterative, true);
 	
+	std::cout << "** KdtreeBucketNearestNeighbors<MetricSquared> ********************************" << std::endl;
+	std::vector<std::vector<rl::math::KdtreeBucketNearestNeighbors<MetricSquared>::Neighbor>> kdtreeBucket = test<rl::math::KdtreeBucketNearestNeighbors<MetricSquared>>(points, queries, iterative, true);
+	
 	std::cout << "** KdtreeNearestNeighbors<MetricSquared> **************************************" << std::endl;
 	std::vector<std::vector<rl::math::KdtreeNearestNeighbors<MetricSquared>::Neighbor>> kdtree = test<rl::math::KdtreeNearestNeighbors<MetricSquared>>(points, queries, iterative, true);
 	
@@ -137,6 +146,15 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 				exit(EXIT_FAILURE);
 			}
 			
+			if (!Eigen::internal::isApprox(linear[i][j].first, std::sqrt(kdtreeBucket[i][j].first)) ||
+				!linear[i][j].second->isApprox(*kdtreeBucket[i][j].second))
+			{
+				std::cerr << "rlNearestNeighborsTest: LinearNearestNeighbors<Metric> != KdtreeBucketNearestNeighbors<MetricSquared>" << std::endl;
+				std::cerr << "[" << i << "][" << j << "] " << linear[i][j].first << " LinearNearestNeighbors<Metric>: " << linear[i][j].second->transpose() << std::endl;
+				std::cerr << "[" << i << "][" << j << "] " << std::sqrt(kdtreeBucket[i][j].first) << " KdtreeBucketNearestNeighbors<MetricSquared>: " << kdtreeBucket[i][j].second->transpose() << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			
 			if (!Eigen::internal::isApprox(linear[i][j].first, std::sqrt(kdtree[i][j].first)) ||
 				!linear[i][j].second->isApprox(*kdtree[i][j].second))
 			{
@@ -149,6 +167,201 @@ test(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Ve
 	}
 }
 
+template<typename NearestNeighbors>
+void
+throughput(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Vector>& queries)
+{
+	std::vector<const rl::math::Vector*> points2;
+	points2.reserve(points.size());
+	
+	for (std::size_t i = 0; i < points.size(); ++i)
+	{
+		points2.push_back(&points[i]);
+	}
+	
+	NearestNeighbors nearestNeighbors(points2.begin(), points2.end());
+	nearestNeighbors.setChecks(CHECKS);
+	
+	std::vector<typename NearestNeighbors::Neighbor> neighbors;
+	
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		nearestNeighbors.nearest(&queries[i], K, neighbors);
+	}
+	
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	
+	std::cout << "approximate search throughput (" << CHECKS << " checks) " << queries.size() / std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() << " queries/s" << std::endl;
+}
+
+template<typename NearestNeighbors>
+void
+rebuild(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Vector>& queries)
+{
+	std::vector<std::vector<typename NearestNeighbors::Neighbor>> results(2);
+	
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		NearestNeighbors nearestNeighbors;
+		nearestNeighbors.setRebuild(1 == i);
+		
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		
+		for (std::size_t j = 0; j < points.size(); ++j)
+		{
+			nearestNeighbors.push(&points[j]);
+		}
+		
+		std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+		
+		std::cout << "push (rebuild " << (1 == i ? "on" : "off") << ") " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 << " ms" << std::endl;
+		
+		start = std::chrono::steady_clock::now();
+		
+		for (std::size_t j = 0; j < queries.size(); ++j)
+		{
+			std::vector<typename NearestNeighbors::Neighbor> neighbors = nearestNeighbors.nearest(&queries[j], K);
+			results[i].insert(results[i].end(), neighbors.begin(), neighbors.end());
+		}
+		
+		stop = std::chrono::steady_clock::now();
+		
+		std::cout << "nearest (rebuild " << (1 == i ? "on" : "off") << ") " << std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count() * 1000 << " ms" << std::endl;
+	}
+	
+	if (results[0].size() != results[1].size())
+	{
+		std::cerr << "rlNearestNeighborsTest: " << results[0].size() << " neighbors (rebuild off) != " << results[1].size() << " neighbors (rebuild on)" << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	
+	for (std::size_t i = 0; i < results[0].size(); ++i)
+	{
+		if (!Eigen::internal::isApprox(results[0][i].first, results[1][i].first))
+		{
+			std::cerr << "rlNearestNeighborsTest: " << results[0][i].first << " (rebuild off) != " << results[1][i].first << " (rebuild on)" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+void
+concurrent(const std::vector<rl::math::Vector>& points, const std::vector<rl::math::Vector>& queries)
+{
+	typedef rl::math::metrics::L2Squared<const rl::math::Vector*> MetricSquared;
+	
+	rl::math::ConcurrentNearestNeighbors<rl::math::KdtreeBucketNearestNeighbors<MetricSquared>> nearestNeighbors;
+	rl::math::LinearNearestNeighbors<MetricSquared> linearNearestNeighbors;
+	
+	std::atomic<bool> done(false);
+	std::vector<std::size_t> searches(THREADS, 0);
+	std::vector<std::thread> threads;
+	
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	
+	for (std::size_t i = 0; i < THREADS; ++i)
+	{
+		threads.emplace_back([&, i]() {
+			for (std::size_t j = i; !done; j = (j + THREADS) % queries.size())
+			{
+				nearestNeighbors.nearest(&queries[j], K);
+				++searches[i];
+			}
+		});
+	}
+	
+	for (std::size_t i = 0; i < points.size(); ++i)
+	{
+		nearestNeighbors.push(&points[i]);
+		linearNearestNeighbors.push(&points[i]);
+	}
+	
+	done = true;
+	
+	for (std::size_t i = 0; i < threads.size(); ++i)
+	{
+		threads[i].join();
+	}
+	
+	std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+	
+	double time = std::chrono::duration_cast<std::chrono::duration<double>>(stop - start).count();
+	std::size_t total = 0;
+	
+	for (std::size_t i = 0; i < searches.size(); ++i)
+	{
+		total += searches[i];
+	}
+	
+	std::cout << "concurrent insertion time (" << THREADS << " search threads) " << time * 1000 << " ms" << std::endl;
+	std::cout << "concurrent search throughput " << total / time << " queries/s" << std::endl;
+	
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		std::vector<rl::math::LinearNearestNeighbors<MetricSquared>::Neighbor> linear = linearNearestNeighbors.nearest(&queries[i], K);
+		std::vector<rl::math::ConcurrentNearestNeighbors<rl::math::KdtreeBucketNearestNeighbors<MetricSquared>>::Neighbor> concurrent = nearestNeighbors.nearest(&queries[i], K);
+		
+		for (std::size_t j = 0; j < linear.size(); ++j)
+		{
+			if (linear.size() != concurrent.size() ||
+				!Eigen::internal::isApprox(linear[j].first, concurrent[j].first) ||
+				!linear[j].second->isApprox(*concurrent[j].second))
+			{
+				std::cerr << "rlNearestNeighborsTest: LinearNearestNeighbors<MetricSquared> != ConcurrentNearestNeighbors<MetricSquared>" << std::endl;
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+}
+
+void
+benchmark(const std::size_t& dim)
+{
+	typedef rl::math::metrics::L2Squared<const rl::math::Vector*> MetricSquared;
+	
+	std::vector<rl::math::Vector> points;
+	points.reserve(N);
+	
+	for (std::size_t i = 0; i < N; ++i)
+	{
+		points.push_back(rl::math::Vector::Random(dim));
+	}
+	
+	std::vector<rl::math::Vector> queries;
+	
+	for (std::size_t i = 0; i < QUERIES; ++i)
+	{
+		queries.push_back(rl::math::Vector::Random(dim));
+	}
+	
+	std::cout << "== " << dim << " dimensions ===================================================" << std::endl << std::endl;
+	
+	std::cout << "** KdtreeBucketNearestNeighbors<MetricSquared> ********************************" << std::endl;
+	std::vector<std::vector<rl::math::KdtreeBucketNearestNeighbors<MetricSquared>::Neighbor>> kdtreeBucket = test<rl::math::KdtreeBucketNearestNeighbors<MetricSquared>>(points, queries, false, true);
+	
+	std::cout << "** KdtreeNearestNeighbors<MetricSquared> **************************************" << std::endl;
+	std::vector<std::vector<rl::math::KdtreeNearestNeighbors<MetricSquared>::Neighbor>> kdtree = test<rl::math::KdtreeNearestNeighbors<MetricSquared>>(points, queries, false, true);
+	
+	for (std::size_t i = 0; i < kdtree.size(); ++i)
+	{
+		for (std::size_t j = 0; j < kdtree[i].size(); ++j)
+		{
+			if (!Eigen::internal::isApprox(kdtree[i][j].first, kdtreeBucket[i][j].first) ||
+				!kdtree[i][j].second->isApprox(*kdtreeBucket[i][j].second))
+			{
+				std::cerr << "rlNearestNeighborsTest: KdtreeNearestNeighbors<MetricSquared> != KdtreeBucketNearestNeighbors<MetricSquared>" << std::endl;
+				std::cerr << "[" << i << "][" << j << "] " << kdtree[i][j].first << " KdtreeNearestNeighbors<MetricSquared>: " << kdtree[i][j].second->transpose() << std::endl;
+				std::cerr << "[" << i << "][" << j << "] " << kdtreeBucket[i][j].first << " KdtreeBucketNearestNeighbors<MetricSquared>: " << kdtreeBucket[i][j].second->transpose() << std::endl;
+				exit(EXIT_FAILURE);
+			}
+		}
+	}
+	
+	std::cout << std::endl;
+}
+
 int
 main(int argc, char** argv)
 {
@@ -202,5 +415,51 @@ main(int argc, char** argv)
 	std::cout << std::endl << "-------------------------------------------------------------------------------" << std::endl << std::endl;
 	test(points, queries, true);
 	
+	std::cout << std::endl;
+	
+	for (std::size_t dim = 6; dim <= 14; dim += 2)
+	{
+		benchmark(dim);
+	}
+	
+	typedef rl::math::metrics::L2<const rl::math::Vector*> Metric;
+	typedef rl::math::metrics::L2Squared<const rl::math::Vector*> MetricSquared;
+	
+	queries.clear();
+	
+	for (std::size_t i = 0; i < 100 * QUERIES; ++i)
+	{
+		queries.push_back(rl::math::Vector::Random(DIM));
+	}
+	
+	std::cout << "===============================================================================" << std::endl << std::endl;
+	
+	std::cout << "** KdtreeBoundingBoxNearestNeighbors<MetricSquared> ***************************" << std::endl;
+	throughput<rl::math::KdtreeBoundingBoxNearestNeighbors<MetricSquared>>(points, queries);
+	
+	std::cout << "** KdtreeBucketNearestNeighbors<MetricSquared> ********************************" << std::endl;
+	throughput<rl::math::KdtreeBucketNearestNeighbors<MetricSquared>>(points, queries);
+	
+	std::cout << "** KdtreeNearestNeighbors<MetricSquared> **************************************" << std::endl;
+	throughput<rl::math::KdtreeNearestNeighbors<MetricSquared>>(points, queries);
+	
+	queries.resize(QUERIES);
+	
+	std::cout << "===============================================================================" << std::endl << std::endl;
+	
+	std::cout << "** GnatNearestNeighbors<Metric> ***********************************************" << std::endl;
+	rebuild<rl::math::GnatNearestNeighbors<Metric>>(points, queries);
+	
+	std::cout << "** KdtreeBoundingBoxNearestNeighbors<MetricSquared> ***************************" << std::endl;
+	rebuild<rl::math::KdtreeBoundingBoxNearestNeighbors<MetricSquared>>(points, queries);
+	
+	std::cout << "** KdtreeNearestNeighbors<MetricSquared> **************************************" << std::endl;
+	rebuild<rl::math::KdtreeNearestNeighbors<MetricSquared>>(points, queries);
+	
+	std::cout << "===============================================================================" << std::endl << std::endl;
+	
+	std::cout << "** ConcurrentNearestNeighbors<KdtreeBucketNearestNeighbors<MetricSquared>> ****" << std::endl;
+	concurrent(points, queries);
+	
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef PRISMATICKINEMATIC_H
+#define PRISMATICKINEMATIC_H
+
+#include <memory>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/Prismatic.h>
+#include <rl/mdl/World.h>
+
+/**
+ * Create kinematic chain of prismatic joints along x-, y-, and z-axis.
+ *
+ * Joint i translates along axis i with a range of [-10, 10], so that
+ * configurations directly correspond to positions of the last body.
+ */
+inline std::shared_ptr<rl::mdl::Kinematic>
+createPrismaticKinematic(const std::size_t& dof)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = std::make_shared<rl::mdl::Kinematic>();
+	
+	std::shared_ptr<rl::mdl::World> world = std::make_shared<rl::mdl::World>();
+	kinematic->add(world);
+	
+	rl::mdl::Frame* previous = world.get();
+	
+	for (std::size_t i = 0; i < dof; ++i)
+	{
+		std::shared_ptr<rl::mdl::Body> link = std::make_shared<rl::mdl::Body>();
+		kinematic->add(link);
+		
+		std::shared_ptr<rl::mdl::Prismatic> joint = std::make_shared<rl::mdl::Prismatic>();
+		joint->setMaximum(rl::math::Vector::Constant(1, 10));
+		joint->setMinimum(rl::math::Vector::Constant(1, -10));
+		joint->S.setZero();
+		joint->S(3 + i, 0) = 1;
+		kinematic->add(joint, previous, link.get());
+		
+		previous = link.get();
+	}
+	
+	kinematic->update();
+	
+	return kinematic;
+}
+
+#endif // PRISMATICKINEMATIC_H
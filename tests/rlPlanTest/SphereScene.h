@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#ifndef SPHERESCENE_H
+#define SPHERESCENE_H
+
+#include <rl/sg/Body.h>
+#include <rl/sg/DistanceScene.h>
+#include <rl/sg/Model.h>
+#include <rl/sg/Shape.h>
+#include <rl/sg/SimpleScene.h>
+
+/**
+ * Scene of spheres with exact collision and distance queries.
+ *
+ * Allows testing planners, verifiers, and optimizers against analytic
+ * distances without a collision library or scene files.
+ */
+class SphereShape : public rl::sg::Shape
+{
+public:
+	SphereShape(rl::sg::Body* body, const rl::math::Real& radius) :
+		rl::sg::Shape(body),
+		radius(radius),
+		transform(rl::math::Transform::Identity())
+	{
+		this->getBody()->add(this);
+	}
+	
+	virtual ~SphereShape()
+	{
+		this->getBody()->remove(this);
+	}
+	
+	rl::math::Vector3 getCenter() const
+	{
+		return this->getBody()->getFrame() * this->transform.translation();
+	}
+	
+	rl::math::Transform getTransform() const
+	{
+		return this->transform;
+	}
+	
+	void setTransform(const rl::math::Transform& transform)
+	{
+		this->transform = transform;
+	}
+	
+	rl::math::Real radius;
+	
+private:
+	rl::math::Transform transform;
+};
+
+class SphereBody : public rl::sg::Body
+{
+public:
+	SphereBody(rl::sg::Model* model) :
+		rl::sg::Body(model),
+		frame(rl::math::Transform::Identity())
+	{
+		this->getModel()->add(this);
+	}
+	
+	virtual ~SphereBody()
+	{
+		while (this->shapes.size() > 0)
+		{
+			delete this->shapes[0];
+		}
+		
+		this->getModel()->remove(this);
+	}
+	
+	rl::sg::Shape* create(::SoVRMLShape* shape)
+	{
+		return new SphereShape(this, 0);
+	}
+	
+	rl::math::Transform getFrame() const
+	{
+		return this->frame;
+	}
+	
+	void setFrame(const rl::math::Transform& frame)
+	{
+		this->frame = frame;
+	}
+	
+private:
+	rl::math::Transform frame;
+};
+
+class SphereModel : public rl::sg::Model
+{
+public:
+	SphereModel(rl::sg::Scene* scene) :
+		rl::sg::Model(scene)
+	{
+		this->getScene()->add(this);
+	}
+	
+	virtual ~SphereModel()
+	{
+		while (this->bodies.size() > 0)
+		{
+			delete this->bodies[0];
+		}
+		
+		this->getScene()->remove(this);
+	}
+	
+	rl::sg::Body* create()
+	{
+		return new SphereBody(this);
+	}
+};
+
+class SphereScene : public rl::sg::SimpleScene, public rl::sg::DistanceScene
+{
+public:
+	SphereScene() :
+		rl::sg::Scene(),
+		rl::sg::SimpleScene(),
+		rl::sg::DistanceScene()
+	{
+	}
+	
+	virtual ~SphereScene()
+	{
+		while (this->models.size() > 0)
+		{
+			delete this->models[0];
+		}
+	}
+	
+	using rl::sg::SimpleScene::areColliding;
+	
+	bool areColliding(rl::sg::Shape* first, rl::sg::Shape* second)
+	{
+		rl::math::Vector3 point1;
+		rl::math::Vector3 point2;
+		return this->distance(first, second, point1, point2) < 0;
+	}
+	
+	rl::sg::Model* create()
+	{
+		return new SphereModel(this);
+	}
+	
+	/**
+	 * Add body with a single sphere to model.
+	 */
+	SphereBody* createSphere(rl::sg::Model* model, const rl::math::Real& radius)
+	{
+		SphereBody* body = static_cast<SphereBody*>(model->create());
+		new SphereShape(body, radius);
+		return body;
+	}
+	
+	using rl::sg::DistanceScene::distance;
+	
+	rl::math::Real distance(rl::sg::Shape* first, rl::sg::Shape* second, rl::math::Vector3& point1, rl::math::Vector3& point2)
+	{
+		SphereShape* sphere1 = static_cast<SphereShape*>(first);
+		SphereShape* sphere2 = static_cast<SphereShape*>(second);
+		rl::math::Vector3 center1 = sphere1->getCenter();
+		rl::math::Vector3 center2 = sphere2->getCenter();
+		rl::math::Vector3 direction = (center2 - center1).normalized();
+		point1 = center1 + sphere1->radius * direction;
+		point2 = center2 - sphere2->radius * direction;
+		return (center2 - center1).norm() - sphere1->radius - sphere2->radius;
+	}
+	
+	rl::math::Real distance(rl::sg::Shape* shape, const rl::math::Vector3& point, rl::math::Vector3& point1, rl::math::Vector3& point2)
+	{
+		SphereShape* sphere = static_cast<SphereShape*>(shape);
+		rl::math::Vector3 center = sphere->getCenter();
+		point1 = center + sphere->radius * (point - center).normalized();
+		point2 = point;
+		return (point - center).norm() - sphere->radius;
+	}
+};
+
+#endif // SPHERESCENE_H
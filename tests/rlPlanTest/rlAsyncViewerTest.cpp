@@ -0,0 +1,381 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <rl/plan/AsyncViewer.h>
+#include <rl/plan/VectorList.h>
+
+/**
+ * Viewer recording forwarded calls.
+ */
+class RecordingViewer : public rl::plan::Viewer
+{
+public:
+	RecordingViewer() :
+		configurations(),
+		edges(0),
+		paths(),
+		points(),
+		resets(0),
+		vertices()
+	{
+	}
+	
+	void drawConfiguration(const rl::math::Vector& q)
+	{
+		this->configurations.push_back(q);
+	}
+	
+	void drawConfigurationEdge(const rl::math::Vector& q0, const rl::math::Vector& q1, const bool& free = true)
+	{
+		++this->edges;
+	}
+	
+	void drawConfigurationPath(const rl::plan::VectorList& path)
+	{
+		this->paths.push_back(path);
+	}
+	
+	void drawConfigurationVertex(const rl::math::Vector& q, const bool& free = true)
+	{
+		this->vertices.push_back(q);
+	}
+	
+	void drawLine(const rl::math::Vector& xyz0, const rl::math::Vector& xyz1) {}
+	
+	void drawPoint(const rl::math::Vector& xyz)
+	{
+		this->points.push_back(xyz);
+	}
+	
+	void drawSphere(const rl::math::Vector& center, const rl::math::Real& radius) {}
+	
+	void drawWork(const rl::math::Transform& t) {}
+	
+	void drawWorkEdge(const rl::math::Vector& q0, const rl::math::Vector& q1)
+	{
+		++this->edges;
+	}
+	
+	void drawWorkPath(const rl::plan::VectorList& path) {}
+	
+	void drawWorkVertex(const rl::math::Vector& q)
+	{
+		this->vertices.push_back(q);
+	}
+	
+	void reset()
+	{
+		++this->resets;
+	}
+	
+	void resetEdges() {}
+	
+	void resetLines() {}
+	
+	void resetPoints() {}
+	
+	void resetSpheres() {}
+	
+	void resetVertices() {}
+	
+	void showMessage(const std::string& message) {}
+	
+	std::vector<rl::math::Vector> configurations;
+	
+	std::size_t edges;
+	
+	std::vector<rl::plan::VectorList> paths;
+	
+	std::vector<rl::math::Vector> points;
+	
+	std::size_t resets;
+	
+	std::vector<rl::math::Vector> vertices;
+};
+
+rl::math::Vector
+createVector(const rl::math::Real& x, const rl::math::Real& y)
+{
+	rl::math::Vector q(2);
+	q << x, y;
+	return q;
+}
+
+void
+produce(rl::plan::AsyncViewer* viewer, std::size_t thread, std::size_t n, std::atomic<std::size_t>* finished)
+{
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		viewer->drawConfigurationVertex(createVector(thread, i));
+	}
+	
+	finished->fetch_add(1);
+}
+
+bool
+checkConcurrent(const std::size_t& capacity, const bool& drops)
+{
+	const std::size_t n = 2000;
+	const std::size_t threads = 4;
+	
+	RecordingViewer recorder;
+	rl::plan::AsyncViewer viewer(&recorder, capacity);
+	
+	std::atomic<std::size_t> finished(0);
+	std::vector<std::thread> producers;
+	
+	for (std::size_t i = 0; i < threads; ++i)
+	{
+		producers.push_back(std::thread(produce, &viewer, i, n, &finished));
+	}
+	
+	while (finished.load() < threads)
+	{
+		viewer.process();
+	}
+	
+	for (std::size_t i = 0; i < producers.size(); ++i)
+	{
+		producers[i].join();
+	}
+	
+	viewer.process();
+	
+	if (threads * n != recorder.vertices.size() + viewer.getDropped())
+	{
+		std::cerr << "Forwarded " << recorder.vertices.size() << " and dropped " << viewer.getDropped() << " of " << threads * n << " vertices" << std::endl;
+		return false;
+	}
+	
+	if (!drops && viewer.getDropped() > 0)
+	{
+		std::cerr << "Dropped " << viewer.getDropped() << " vertices below capacity" << std::endl;
+		return false;
+	}
+	
+	// calls of each thread are forwarded in order
+	
+	std::vector<rl::math::Real> last(threads, -1);
+	
+	for (std::size_t i = 0; i < recorder.vertices.size(); ++i)
+	{
+		std::size_t thread = static_cast<std::size_t>(recorder.vertices[i](0));
+		
+		if (thread >= threads || recorder.vertices[i](1) <= last[thread])
+		{
+			std::cerr << "Vertex " << recorder.vertices[i].transpose() << " forwarded out of order" << std::endl;
+			return false;
+		}
+		
+		last[thread] = recorder.vertices[i](1);
+	}
+	
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	// calls are dropped at capacity and forwarded in order
+	
+	{
+		RecordingViewer recorder;
+		rl::plan::AsyncViewer viewer(&recorder, 16);
+		
+		if (16 != viewer.getCapacity())
+		{
+			std::cerr << "Capacity " << viewer.getCapacity() << " instead of 16" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		for (std::size_t i = 0; i < 20; ++i)
+		{
+			viewer.drawPoint(createVector(i, 0));
+		}
+		
+		if (4 != viewer.getDropped())
+		{
+			std::cerr << "Dropped " << viewer.getDropped() << " instead of 4 calls at capacity" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (16 != viewer.process() || 16 != recorder.points.size())
+		{
+			std::cerr << "Forwarded " << recorder.points.size() << " instead of 16 points" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		for (std::size_t i = 0; i < recorder.points.size(); ++i)
+		{
+			if (i != recorder.points[i](0))
+			{
+				std::cerr << "Point " << i << " forwarded out of order" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		
+		// queue is usable again after process()
+		
+		viewer.drawPoint(createVector(20, 0));
+		
+		if (1 != viewer.process() || 17 != recorder.points.size() || 4 != viewer.getDropped())
+		{
+			std::cerr << "Point after process() not forwarded" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	// only the latest configuration and path are forwarded
+	
+	{
+		RecordingViewer recorder;
+		rl::plan::AsyncViewer viewer(&recorder);
+		
+		for (std::size_t i = 0; i < 10; ++i)
+		{
+			viewer.drawConfiguration(createVector(i, 0));
+			
+			rl::plan::VectorList path;
+			path.push_back(createVector(0, 0));
+			path.push_back(createVector(i, 0));
+			viewer.drawConfigurationPath(path);
+			
+			viewer.drawPoint(createVector(i, 0));
+		}
+		
+		viewer.process();
+		
+		if (1 != recorder.configurations.size() || 9 != recorder.configurations.back()(0))
+		{
+			std::cerr << "Configurations not coalesced to latest" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (1 != recorder.paths.size() || 9 != recorder.paths.back().back()(0))
+		{
+			std::cerr << "Paths not coalesced to latest" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (10 != recorder.points.size())
+		{
+			std::cerr << "Points coalesced" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	// edges and vertices are decimated, strides restart after reset()
+	
+	{
+		RecordingViewer recorder;
+		rl::plan::AsyncViewer viewer(&recorder);
+		viewer.setEdgeStride(4);
+		viewer.setVertexStride(3);
+		
+		for (std::size_t i = 0; i < 9; ++i)
+		{
+			viewer.drawConfigurationEdge(createVector(i, 0), createVector(i + 1, 0));
+			viewer.drawConfigurationVertex(createVector(i, 0));
+		}
+		
+		viewer.process();
+		
+		if (3 != recorder.edges)
+		{
+			std::cerr << "Forwarded " << recorder.edges << " instead of 3 edges with stride 4" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (3 != recorder.vertices.size() || 0 != recorder.vertices[0](0) || 3 != recorder.vertices[1](0) || 6 != recorder.vertices[2](0))
+		{
+			std::cerr << "Forwarded wrong vertices with stride 3" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		viewer.reset();
+		viewer.drawConfigurationVertex(createVector(9, 0));
+		viewer.process();
+		
+		if (4 != recorder.vertices.size() || 9 != recorder.vertices.back()(0))
+		{
+			std::cerr << "Vertex stride not restarted after reset()" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	// reset() discards calls queued before it
+	
+	{
+		RecordingViewer recorder;
+		rl::plan::AsyncViewer viewer(&recorder);
+		
+		for (std::size_t i = 0; i < 5; ++i)
+		{
+			viewer.drawPoint(createVector(i, 0));
+		}
+		
+		viewer.drawConfiguration(createVector(0, 0));
+		viewer.reset();
+		
+		for (std::size_t i = 5; i < 7; ++i)
+		{
+			viewer.drawPoint(createVector(i, 0));
+		}
+		
+		viewer.process();
+		
+		if (1 != recorder.resets)
+		{
+			std::cerr << "Forwarded " << recorder.resets << " instead of 1 reset" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (2 != recorder.points.size() || 5 != recorder.points[0](0) || 6 != recorder.points[1](0))
+		{
+			std::cerr << "Points queued before reset() not discarded" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (!recorder.configurations.empty())
+		{
+			std::cerr << "Configuration queued before reset() not discarded" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	// concurrent producers with processing in calling thread
+	
+	if (!checkConcurrent(8192, false) || !checkConcurrent(64, true))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <rl/math/Constants.h>
+#include <rl/plan/ChompOptimizer.h>
+#include <rl/plan/DistanceModel.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/VectorList.h>
+
+#include "PrismaticKinematic.h"
+#include "SphereScene.h"
+
+/**
+ * Optimizer with access to its cost terms.
+ */
+class CostChompOptimizer : public rl::plan::ChompOptimizer
+{
+public:
+	using rl::plan::ChompOptimizer::cost;
+	
+	using rl::plan::ChompOptimizer::smoothness;
+	
+	rl::math::Real total(const rl::plan::VectorList& path)
+	{
+		rl::math::Matrix x(path.front().size(), path.size());
+		std::size_t i = 0;
+		
+		for (rl::plan::VectorList::const_iterator j = path.begin(); j != path.end(); ++i, ++j)
+		{
+			x.col(i) = *j;
+		}
+		
+		rl::math::Matrix gradient;
+		return this->smoothness(x) + this->getWeight() * this->cost(x, gradient);
+	}
+};
+
+int
+main(int argc, char** argv)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = createPrismaticKinematic(2);
+	
+	// sphere of radius 0.5 moving in xy-plane, obstacle of radius 1 at (3, 0, 0)
+	
+	SphereScene scene;
+	
+	rl::sg::Model* robot = scene.create();
+	
+	for (std::size_t i = 0; i + 1 < kinematic->getBodies(); ++i)
+	{
+		robot->create();
+	}
+	
+	scene.createSphere(robot, static_cast<rl::math::Real>(0.5));
+	
+	rl::sg::Model* obstacles = scene.create();
+	rl::sg::Body* obstacle = scene.createSphere(obstacles, 1);
+	obstacle->setFrame(rl::math::Transform(rl::math::Translation(3, 0, 0)));
+	
+	rl::plan::DistanceModel model;
+	model.mdl = kinematic.get();
+	model.model = robot;
+	model.scene = &scene;
+	
+	rl::plan::RecursiveVerifier verifier;
+	verifier.setDelta(static_cast<rl::math::Real>(0.01));
+	verifier.setModel(&model);
+	
+	CostChompOptimizer optimizer;
+	optimizer.setClearance(static_cast<rl::math::Real>(0.5));
+	optimizer.setLength(static_cast<rl::math::Real>(0.2));
+	optimizer.setModel(&model);
+	optimizer.setVerifier(&verifier);
+	
+	// obstacle cost gradient matches central differences near the obstacle
+	
+	rl::math::Real h = static_cast<rl::math::Real>(1.0e-5);
+	rl::math::Vector gradient(2);
+	rl::math::Vector gradientMinus(2);
+	rl::math::Vector gradientPlus(2);
+	rl::math::Vector q(2);
+	
+	for (std::size_t i = 0; i < 16; ++i)
+	{
+		// clearance between 0.1 and 0.4 in all directions around the obstacle
+		
+		rl::math::Real angle = i * 2 * rl::math::constants::pi / 16;
+		rl::math::Real radius = static_cast<rl::math::Real>(1.6) + static_cast<rl::math::Real>(0.02) * i;
+		q << 3 + radius * std::cos(angle), radius * std::sin(angle);
+		
+		rl::math::Real cost = optimizer.cost(&model, q, gradient);
+		
+		if (cost <= 0)
+		{
+			std::cerr << "No obstacle cost in " << q.transpose() << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		for (std::size_t j = 0; j < 2; ++j)
+		{
+			rl::math::Vector qMinus = q;
+			qMinus(j) -= h;
+			rl::math::Vector qPlus = q;
+			qPlus(j) += h;
+			
+			rl::math::Real difference = (optimizer.cost(&model, qPlus, gradientPlus) - optimizer.cost(&model, qMinus, gradientMinus)) / (2 * h);
+			
+			if (std::abs(gradient(j) - difference) > static_cast<rl::math::Real>(1.0e-4))
+			{
+				std::cerr << "Gradient " << gradient.transpose() << " in " << q.transpose() << " differs from finite difference " << difference << " in joint " << j << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+	}
+	
+	q << 0, 3;
+	
+	if (0 != optimizer.cost(&model, q, gradient) || !gradient.isZero())
+	{
+		std::cerr << "Obstacle cost beyond clearance in " << q.transpose() << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// detour passing the obstacle closely is smoothed without collision
+	
+	rl::plan::VectorList path;
+	q << 0, static_cast<rl::math::Real>(1.7);
+	path.push_back(q);
+	q << 2, static_cast<rl::math::Real>(1.6);
+	path.push_back(q);
+	q << 3, static_cast<rl::math::Real>(2.5);
+	path.push_back(q);
+	q << 4, static_cast<rl::math::Real>(1.6);
+	path.push_back(q);
+	q << 6, static_cast<rl::math::Real>(1.7);
+	path.push_back(q);
+	
+	rl::plan::VectorList original = path;
+	optimizer.subdivide(original, optimizer.getLength());
+	rl::math::Real before = optimizer.total(original);
+	
+	optimizer.process(path);
+	
+	if (path.size() != original.size() || path.front() != original.front() || path.back() != original.back())
+	{
+		std::cerr << "End points or number of waypoints changed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	rl::math::Real after = optimizer.total(path);
+	
+	if (after > before)
+	{
+		std::cerr << "Total cost increased from " << before << " to " << after << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (after >= before * static_cast<rl::math::Real>(0.9))
+	{
+		std::cerr << "Total cost not reduced from " << before << " (" << after << ")" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	rl::plan::VectorList::const_iterator i = path.begin();
+	rl::plan::VectorList::const_iterator j = ++path.begin();
+	
+	for (; j != path.end(); ++i, ++j)
+	{
+		if (model.isColliding(*i) || verifier.isColliding(*i, *j, model.distance(*i, *j)))
+		{
+			std::cerr << "Optimized path collides between " << i->transpose() << " and " << j->transpose() << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+#include <rl/plan/DistanceField.h>
+#include <rl/plan/Exception.h>
+#include <rl/plan/SimpleModel.h>
+
+#include "SphereScene.h"
+
+bool
+checkLoad(rl::plan::DistanceField& field, const std::string& filename, rl::plan::SimpleModel& model)
+{
+	try
+	{
+		field.load(filename, &model);
+		return true;
+	}
+	catch (const rl::plan::Exception&)
+	{
+		return false;
+	}
+}
+
+rl::math::Real
+exactDistance(const std::vector<SphereBody*>& obstacles, const std::vector<rl::math::Real>& radii, const rl::math::Vector3& point)
+{
+	rl::math::Real distance = std::numeric_limits<rl::math::Real>::max();
+	
+	for (std::size_t i = 0; i < obstacles.size(); ++i)
+	{
+		distance = std::min(distance, (point - obstacles[i]->getFrame().translation()).norm() - radii[i]);
+	}
+	
+	return distance;
+}
+
+int
+main(int argc, char** argv)
+{
+	// robot sphere overlapping the obstacles is not part of the field
+	
+	SphereScene scene;
+	
+	rl::sg::Model* robot = scene.create();
+	scene.createSphere(robot, 1);
+	
+	std::vector<SphereBody*> obstacles;
+	std::vector<rl::math::Real> radii;
+	
+	rl::sg::Model* obstacleModel = scene.create();
+	obstacles.push_back(scene.createSphere(obstacleModel, static_cast<rl::math::Real>(0.6)));
+	obstacles.back()->setFrame(rl::math::Transform(rl::math::Translation(static_cast<rl::math::Real>(0.5), 0, 0)));
+	radii.push_back(static_cast<rl::math::Real>(0.6));
+	obstacles.push_back(scene.createSphere(obstacleModel, static_cast<rl::math::Real>(0.4)));
+	obstacles.back()->setFrame(rl::math::Transform(rl::math::Translation(-1, static_cast<rl::math::Real>(0.5), static_cast<rl::math::Real>(0.3))));
+	radii.push_back(static_cast<rl::math::Real>(0.4));
+	
+	rl::plan::SimpleModel model;
+	model.model = robot;
+	model.scene = &scene;
+	
+	rl::plan::DistanceField field;
+	field.setBoundingBox(rl::math::AlignedBox3(rl::math::Vector3::Constant(-2), rl::math::Vector3::Constant(2)));
+	field.setResolution(static_cast<rl::math::Real>(0.1));
+	field.build(std::vector<rl::plan::SimpleModel*>(1, &model));
+	
+	if (field.empty())
+	{
+		std::cerr << "Distance field empty after build()" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// interpolation of exact distances differs by at most getError()
+	
+	rl::math::Real error = field.getError();
+	
+	std::mt19937 engine(0);
+	std::uniform_real_distribution<rl::math::Real> distribution(static_cast<rl::math::Real>(-1.9), static_cast<rl::math::Real>(1.9));
+	
+	std::size_t inside = 0;
+	std::size_t outside = 0;
+	
+	for (std::size_t i = 0; i < 10000; ++i)
+	{
+		rl::math::Vector3 point(distribution(engine), distribution(engine), distribution(engine));
+		rl::math::Real exact = exactDistance(obstacles, radii, point);
+		rl::math::Real distance = field.distance(point);
+		
+		if (exact > 2 * error)
+		{
+			// all corners of the grid cell outside of obstacles
+			
+			if (std::abs(distance - exact) > error)
+			{
+				std::cerr << "Distance " << distance << " in " << point.transpose() << " differs from " << exact << " by more than " << error << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			++outside;
+		}
+		else if (exact < -2 * error)
+		{
+			// all corners of the grid cell inside of obstacles
+			
+			if (distance >= 0 || std::abs(distance - exact) > 2 * error)
+			{
+				std::cerr << "Distance " << distance << " in " << point.transpose() << " inside obstacle with distance " << exact << std::endl;
+				return EXIT_FAILURE;
+			}
+			
+			++inside;
+		}
+	}
+	
+	if (0 == inside || 0 == outside)
+	{
+		std::cerr << "Points not sampled inside and outside of obstacles" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// saved field is only loaded for unchanged obstacles
+	
+	std::string filename = "rlDistanceFieldTest.bin";
+	field.save(filename);
+	
+	rl::plan::DistanceField loaded;
+	loaded.setBoundingBox(field.getBoundingBox());
+	loaded.setResolution(field.getResolution());
+	
+	if (!checkLoad(loaded, filename, model))
+	{
+		std::cerr << "Distance field not loaded for unchanged scene" << std::endl;
+		std::remove(filename.c_str());
+		return EXIT_FAILURE;
+	}
+	
+	rl::math::Vector3 point(1, 1, 1);
+	
+	if (loaded.distance(point) != field.distance(point))
+	{
+		std::cerr << "Loaded distance field differs" << std::endl;
+		std::remove(filename.c_str());
+		return EXIT_FAILURE;
+	}
+	
+	obstacles.back()->setFrame(rl::math::Transform(rl::math::Translation(-1, static_cast<rl::math::Real>(0.6), static_cast<rl::math::Real>(0.3))));
+	
+	if (checkLoad(loaded, filename, model))
+	{
+		std::cerr << "Distance field loaded after obstacle was moved" << std::endl;
+		std::remove(filename.c_str());
+		return EXIT_FAILURE;
+	}
+	
+	obstacles.back()->setFrame(rl::math::Transform(rl::math::Translation(-1, static_cast<rl::math::Real>(0.5), static_cast<rl::math::Real>(0.3))));
+	robot->getBody(0)->setFrame(rl::math::Transform(rl::math::Translation(1, 1, 1)));
+	
+	if (!checkLoad(loaded, filename, model))
+	{
+		std::cerr << "Distance field not loaded after robot was moved" << std::endl;
+		std::remove(filename.c_str());
+		return EXIT_FAILURE;
+	}
+	
+	loaded.setResolution(static_cast<rl::math::Real>(0.2));
+	
+	if (checkLoad(loaded, filename, model))
+	{
+		std::cerr << "Distance field loaded with different resolution" << std::endl;
+		std::remove(filename.c_str());
+		return EXIT_FAILURE;
+	}
+	
+	std::remove(filename.c_str());
+	
+	return EXIT_SUCCESS;
+}
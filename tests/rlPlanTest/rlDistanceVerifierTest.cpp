@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <rl/plan/DistanceModel.h>
+#include <rl/plan/DistanceVerifier.h>
+#include <rl/plan/RecursiveVerifier.h>
+
+#include "PrismaticKinematic.h"
+#include "SphereScene.h"
+
+int
+main(int argc, char** argv)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = createPrismaticKinematic(2);
+	
+	// sphere of radius 0.5 moving in xy-plane, obstacle of radius 1 at (3, 0, 0)
+	
+	SphereScene scene;
+	
+	rl::sg::Model* robot = scene.create();
+	
+	for (std::size_t i = 0; i + 1 < kinematic->getBodies(); ++i)
+	{
+		robot->create();
+	}
+	
+	scene.createSphere(robot, static_cast<rl::math::Real>(0.5));
+	
+	rl::sg::Model* obstacles = scene.create();
+	rl::sg::Body* obstacle = scene.createSphere(obstacles, 1);
+	obstacle->setFrame(rl::math::Transform(rl::math::Translation(3, 0, 0)));
+	
+	rl::plan::DistanceModel model;
+	model.mdl = kinematic.get();
+	model.model = robot;
+	model.scene = &scene;
+	
+	rl::plan::DistanceVerifier verifier;
+	verifier.setDelta(static_cast<rl::math::Real>(0.01));
+	verifier.setModel(&model);
+	verifier.setRadii(rl::math::Vector::Ones(2));
+	
+	rl::plan::RecursiveVerifier recursive;
+	recursive.setDelta(static_cast<rl::math::Real>(0.01));
+	recursive.setModel(&model);
+	
+	rl::math::Vector u(2);
+	rl::math::Vector v(2);
+	
+	// passes obstacle with clearance 0.05
+	u << 0, static_cast<rl::math::Real>(1.55);
+	v << 6, static_cast<rl::math::Real>(1.55);
+	
+	if (verifier.isColliding(u, v, model.distance(u, v)))
+	{
+		std::cerr << "Free segment " << u.transpose() << " -> " << v.transpose() << " rejected" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (0 == verifier.getCertifiedSteps())
+	{
+		std::cerr << "No states certified for free segment" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	verifier.reset();
+	
+	if (0 != verifier.getCertifiedSteps())
+	{
+		std::cerr << "Certified steps " << verifier.getCertifiedSteps() << " != 0 after reset()" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// crosses obstacle with end points far away
+	u << 0, 0;
+	v << 6, 0;
+	
+	if (!verifier.isColliding(u, v, model.distance(u, v)))
+	{
+		std::cerr << "Colliding segment " << u.transpose() << " -> " << v.transpose() << " accepted" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// certification must not change result of checking all intermediate states
+	
+	std::mt19937 engine(argc > 1 ? std::atoi(argv[1]) : 0);
+	std::uniform_real_distribution<rl::math::Real> distribution(-1, 7);
+	
+	std::vector<rl::math::Vector> points;
+	std::vector<rl::plan::Verifier::Segment> segments;
+	std::size_t colliding = 0;
+	
+	for (std::size_t i = 0; i < 400; ++i)
+	{
+		u << distribution(engine), distribution(engine) - 3;
+		points.push_back(u);
+	}
+	
+	for (std::size_t i = 0; i < points.size(); i += 2)
+	{
+		if (model.isColliding(points[i]) || model.isColliding(points[i + 1]))
+		{
+			continue;
+		}
+		
+		rl::math::Real d = model.distance(points[i], points[i + 1]);
+		bool expected = recursive.isColliding(points[i], points[i + 1], d);
+		
+		if (verifier.isColliding(points[i], points[i + 1], d) != expected)
+		{
+			std::cerr << "Segment " << points[i].transpose() << " -> " << points[i + 1].transpose() << " colliding " << !expected << " != " << expected << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		segments.push_back(rl::plan::Verifier::Segment(&points[i], &points[i + 1], d));
+		colliding += expected ? 1 : 0;
+	}
+	
+	if (0 == colliding || segments.size() == colliding)
+	{
+		std::cerr << "Random segments are all free or all colliding" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	std::vector<bool> batch = verifier.isColliding(segments);
+	
+	for (std::size_t i = 0; i < segments.size(); ++i)
+	{
+		if (batch[i] != recursive.isColliding(*segments[i].u, *segments[i].v, segments[i].d))
+		{
+			std::cerr << "Batch result of segment " << i << " differs" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+#include <rl/math/Constants.h>
+#include <rl/math/LinearNearestNeighbors.h>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/Fixed.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/Revolute.h>
+#include <rl/mdl/World.h>
+#include <rl/plan/JointMetric.h>
+#include <rl/plan/LinearBlockNearestNeighbors.h>
+#include <rl/plan/Model.h>
+
+std::shared_ptr<rl::mdl::Kinematic>
+createKinematic()
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = std::make_shared<rl::mdl::Kinematic>();
+	
+	std::shared_ptr<rl::mdl::World> world = std::make_shared<rl::mdl::World>();
+	kinematic->add(world);
+	
+	std::shared_ptr<rl::mdl::Body> link0 = std::make_shared<rl::mdl::Body>();
+	kinematic->add(link0);
+	
+	std::shared_ptr<rl::mdl::Fixed> fixed0 = std::make_shared<rl::mdl::Fixed>();
+	kinematic->add(fixed0, world.get(), link0.get());
+	
+	rl::mdl::Frame* previous = link0.get();
+	
+	for (std::size_t i = 0; i < 3; ++i)
+	{
+		std::shared_ptr<rl::mdl::Body> link = std::make_shared<rl::mdl::Body>();
+		kinematic->add(link);
+		
+		std::shared_ptr<rl::mdl::Revolute> joint = std::make_shared<rl::mdl::Revolute>();
+		joint->setMaximum(rl::math::Vector::Constant(1, rl::math::constants::pi));
+		joint->setMinimum(rl::math::Vector::Constant(1, -rl::math::constants::pi));
+		joint->wraparound(0) = 1 != i;
+		kinematic->add(joint, previous, link.get());
+		
+		previous = link.get();
+	}
+	
+	kinematic->update();
+	
+	return kinematic;
+}
+
+bool
+compare(const std::vector<rl::plan::NearestNeighbors::Neighbor>& block, const std::vector<rl::math::LinearNearestNeighbors<rl::plan::JointMetric>::Neighbor>& linear, const char* name)
+{
+	if (block.size() != linear.size())
+	{
+		std::cerr << name << ": " << block.size() << " neighbors (block) != " << linear.size() << " neighbors (linear)" << std::endl;
+		return false;
+	}
+	
+	for (std::size_t i = 0; i < block.size(); ++i)
+	{
+		if (!Eigen::internal::isApprox(block[i].first, linear[i].first) || block[i].second.first != linear[i].second.first)
+		{
+			std::cerr << name << ": neighbor " << i << " distance " << block[i].first << " (block) != " << linear[i].first << " (linear)" << std::endl;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = createKinematic();
+	
+	rl::plan::Model model;
+	model.mdl = kinematic.get();
+	
+	rl::math::Vector weights(3);
+	weights << 1, 2, static_cast<rl::math::Real>(0.5);
+	
+	rl::plan::LinearBlockNearestNeighbors blockNearestNeighbors(&model);
+	blockNearestNeighbors.setWeights(weights);
+	
+	rl::plan::JointMetric metric(&model, true);
+	metric.setWeights(weights);
+	
+	rl::math::LinearNearestNeighbors<rl::plan::JointMetric> linearNearestNeighbors(metric);
+	
+	std::mt19937 randomEngine(0);
+	std::uniform_real_distribution<rl::math::Real> randomDistribution(-rl::math::constants::pi, rl::math::constants::pi);
+	
+	// 43 points, last block of eight is partially filled
+	std::vector<rl::math::Vector> points(43, rl::math::Vector(3));
+	
+	for (std::size_t i = 0; i < points.size(); ++i)
+	{
+		for (std::ptrdiff_t j = 0; j < points[i].size(); ++j)
+		{
+			points[i](j) = randomDistribution(randomEngine);
+		}
+		
+		blockNearestNeighbors.push(rl::plan::Metric::Value(&points[i], nullptr));
+		linearNearestNeighbors.push(rl::plan::Metric::Value(&points[i], nullptr));
+	}
+	
+	std::vector<rl::math::Vector> queries(100, rl::math::Vector(3));
+	
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		for (std::ptrdiff_t j = 0; j < queries[i].size(); ++j)
+		{
+			queries[i](j) = randomDistribution(randomEngine);
+		}
+	}
+	
+	// close to points[0] only across wraparound of first joint
+	queries[0] = points[0];
+	queries[0](0) += queries[0](0) > 0 ? -2 * rl::math::constants::pi + static_cast<rl::math::Real>(0.01) : 2 * rl::math::constants::pi - static_cast<rl::math::Real>(0.01);
+	
+	for (std::size_t i = 0; i < queries.size(); ++i)
+	{
+		rl::plan::Metric::Value query(&queries[i], nullptr);
+		
+		for (std::size_t k = 1; k <= 10; k += 3)
+		{
+			if (!compare(blockNearestNeighbors.nearest(query, k), linearNearestNeighbors.nearest(query, k), "nearest"))
+			{
+				return EXIT_FAILURE;
+			}
+		}
+		
+		if (!compare(blockNearestNeighbors.radius(query, 2), linearNearestNeighbors.radius(query, 2), "radius"))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	
+	std::vector<rl::plan::NearestNeighbors::Neighbor> nearest = blockNearestNeighbors.nearest(rl::plan::Metric::Value(&queries[0], nullptr), 1);
+	
+	if (nearest.empty() || &points[0] != nearest[0].second.first)
+	{
+		std::cerr << "nearest neighbor across wraparound not found" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <rl/plan/Path.h>
+
+bool
+check(const rl::plan::Path& path, const std::vector<rl::math::Vector>& expected, const std::string& what)
+{
+	if (path.size() != expected.size() || path.empty() != expected.empty())
+	{
+		std::cerr << what << ": size " << path.size() << " != " << expected.size() << std::endl;
+		return false;
+	}
+	
+	if (path.capacity() < path.size())
+	{
+		std::cerr << what << ": capacity " << path.capacity() << " < size " << path.size() << std::endl;
+		return false;
+	}
+	
+	for (std::size_t i = 0; i < expected.size(); ++i)
+	{
+		if (path[i] != expected[i])
+		{
+			std::cerr << what << ": configuration " << i << " " << path[i].transpose() << " != " << expected[i].transpose() << std::endl;
+			return false;
+		}
+	}
+	
+	rl::plan::VectorList list = path.toList();
+	
+	if (list.size() != expected.size() || !std::equal(list.begin(), list.end(), expected.begin()))
+	{
+		std::cerr << what << ": toList() differs" << std::endl;
+		return false;
+	}
+	
+	if (!expected.empty() && (path.front() != expected.front() || path.back() != expected.back()))
+	{
+		std::cerr << what << ": front() or back() differs" << std::endl;
+		return false;
+	}
+	
+	return true;
+}
+
+rl::math::Vector
+configuration(const std::size_t& i)
+{
+	rl::math::Vector q(3);
+	q << i, 2 * i, -static_cast<rl::math::Real>(i);
+	return q;
+}
+
+int
+main(int argc, char** argv)
+{
+	rl::plan::Path path;
+	std::vector<rl::math::Vector> expected;
+	std::size_t n = 0;
+	
+	if (!check(path, expected, "default"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	for (std::size_t i = 0; i < 5; ++i, ++n)
+	{
+		path.push_back(configuration(n));
+		expected.push_back(configuration(n));
+	}
+	
+	if (!check(path, expected, "push_back()") || 3 != path.getDof())
+	{
+		return EXIT_FAILURE;
+	}
+	
+	// insert in front of gap at the end, then behind gap at index 2
+	
+	path.insert(1, configuration(n));
+	expected.insert(expected.begin() + 1, configuration(n++));
+	path.insert(4, configuration(n));
+	expected.insert(expected.begin() + 4, configuration(n++));
+	
+	if (!check(path, expected, "insert() across gap"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	// erase in front of gap at index 5, then range across gap at index 0
+	
+	path.erase(0);
+	expected.erase(expected.begin());
+	path.erase(2, 4);
+	expected.erase(expected.begin() + 2, expected.begin() + 4);
+	
+	if (!check(path, expected, "erase() across gap"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	// fill capacity with gap in the middle, so growing has to move columns behind the gap
+	
+	std::size_t capacity = path.capacity();
+	
+	while (path.size() <= capacity)
+	{
+		path.insert(1, configuration(n));
+		expected.insert(expected.begin() + 1, configuration(n++));
+	}
+	
+	if (!check(path, expected, "resize() with tail") || path.capacity() <= capacity)
+	{
+		return EXIT_FAILURE;
+	}
+	
+	rl::plan::Path copy;
+	copy = path;
+	std::vector<rl::math::Vector> copied = expected;
+	
+	copy.erase(0);
+	copied.erase(copied.begin());
+	copy.push_back(configuration(n));
+	copied.push_back(configuration(n++));
+	
+	if (!check(copy, copied, "operator=(Path) copy") || !check(path, expected, "operator=(Path) original"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	rl::plan::VectorList list;
+	expected.clear();
+	
+	for (std::size_t i = 0; i < 4; ++i, ++n)
+	{
+		list.push_back(configuration(n));
+		expected.push_back(configuration(n));
+	}
+	
+	path = list;
+	
+	if (!check(path, expected, "operator=(VectorList)"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	path.insert(2, configuration(n));
+	expected.insert(expected.begin() + 2, configuration(n++));
+	
+	if (!check(path, expected, "insert() after operator=(VectorList)"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	capacity = path.capacity();
+	path.clear();
+	expected.clear();
+	
+	if (!check(path, expected, "clear()") || path.capacity() != capacity)
+	{
+		return EXIT_FAILURE;
+	}
+	
+	path.push_back(configuration(n));
+	expected.push_back(configuration(n++));
+	path.insert(0, configuration(n));
+	expected.insert(expected.begin(), configuration(n++));
+	
+	if (!check(path, expected, "insert() after clear()"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	// random edits against std::vector
+	
+	std::mt19937 engine(argc > 1 ? std::atoi(argv[1]) : 0);
+	
+	for (std::size_t i = 0; i < 2000; ++i)
+	{
+		std::size_t j = std::uniform_int_distribution<std::size_t>(0, expected.size())(engine);
+		
+		if (expected.size() < 2 || std::uniform_int_distribution<int>(0, 2)(engine) > 0)
+		{
+			path.insert(j, configuration(n));
+			expected.insert(expected.begin() + j, configuration(n++));
+		}
+		else
+		{
+			std::size_t first = std::min(j, expected.size() - 1);
+			std::size_t last = std::uniform_int_distribution<std::size_t>(first + 1, std::min(first + 3, expected.size()))(engine);
+			path.erase(first, last);
+			expected.erase(expected.begin() + first, expected.begin() + last);
+		}
+		
+		if (!check(path, expected, "random edit " + std::to_string(i)))
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	
+	while (!expected.empty())
+	{
+		path.pop_back();
+		expected.pop_back();
+	}
+	
+	if (!check(path, expected, "pop_back()"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,184 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <rl/plan/LinearNearestNeighbors.h>
+#include <rl/plan/Prm.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/UniformSampler.h>
+#include <rl/plan/VectorList.h>
+
+#include "PrismaticKinematic.h"
+
+/**
+ * Model with a wall at the first joint in [-0.5, 0.5] and a gap with the
+ * second joint above 5, so that start and goal cannot be connected directly.
+ */
+class WallModel : public rl::plan::SimpleModel
+{
+public:
+	using rl::plan::SimpleModel::isColliding;
+	
+	bool isColliding(const rl::math::Vector& q)
+	{
+		return std::abs(q(0)) <= static_cast<rl::math::Real>(0.5) && q(1) < 5;
+	}
+};
+
+bool
+isFree(WallModel& model, rl::plan::Verifier& verifier, const rl::plan::VectorList& path)
+{
+	rl::plan::VectorList::const_iterator i = path.begin();
+	rl::plan::VectorList::const_iterator j = ++path.begin();
+	
+	for (; i != path.end() && j != path.end(); ++i, ++j)
+	{
+		if (verifier.isColliding(*i, *j, model.distance(*i, *j)))
+		{
+			return false;
+		}
+	}
+	
+	return !path.empty();
+}
+
+int
+main(int argc, char** argv)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = createPrismaticKinematic(2);
+	
+	WallModel model;
+	model.mdl = kinematic.get();
+	
+	rl::plan::RecursiveVerifier verifier;
+	verifier.setDelta(static_cast<rl::math::Real>(0.01));
+	verifier.setModel(&model);
+	
+	rl::plan::UniformSampler sampler;
+	sampler.seed(0);
+	sampler.setModel(&model);
+	
+	rl::plan::LinearNearestNeighbors nearestNeighbors(&model);
+	
+	rl::math::Vector start(2);
+	start << -2, 0;
+	rl::math::Vector goal(2);
+	goal << 2, 0;
+	
+	rl::plan::Prm prm;
+	prm.setDuration(std::chrono::seconds(10));
+	prm.setGoal(&goal);
+	prm.setMaxRadius(5);
+	prm.setModel(&model);
+	prm.setNearestNeighbors(&nearestNeighbors);
+	prm.setSampler(&sampler);
+	prm.setStart(&start);
+	prm.setVerifier(&verifier);
+	
+	// cancel from within solve() before any sample was added
+	
+	prm.setProgress(
+		std::bind(&rl::plan::Planner::cancel, &prm),
+		std::chrono::steady_clock::duration::zero()
+	);
+	
+	if (prm.solve())
+	{
+		std::cerr << "Canceled solve() succeeded" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (!prm.isCanceled())
+	{
+		std::cerr << "Cancel request not recorded" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// next solve() without reset() starts with a cleared request
+	
+	prm.setProgress(
+		std::function<void(const std::chrono::steady_clock::duration&)>(),
+		std::chrono::seconds(1)
+	);
+	
+	if (!prm.solve())
+	{
+		std::cerr << "solve() after cancel() failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (prm.isCanceled())
+	{
+		std::cerr << "Cancel request not cleared" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (!isFree(model, verifier, prm.getPath()))
+	{
+		std::cerr << "Path after cancel() not collision-free" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// cancel() before solve() is discarded as well
+	
+	prm.reset();
+	prm.cancel();
+	
+	if (!prm.solve())
+	{
+		std::cerr << "solve() after cancel() and reset() failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// samples are added in batches
+	
+	prm.reset();
+	prm.setBatchSize(16);
+	
+	if (!prm.solve())
+	{
+		std::cerr << "solve() with batches failed" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (0 != (prm.getNumVertices() - 2) % 16)
+	{
+		std::cerr << "Roadmap with " << prm.getNumVertices() << " vertices not built in batches" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (!isFree(model, verifier, prm.getPath()))
+	{
+		std::cerr << "Path with batches not collision-free" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
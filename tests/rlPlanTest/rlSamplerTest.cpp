@@ -0,0 +1,206 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <rl/plan/HaltonSampler.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/SobolSampler.h>
+#include <rl/plan/UniformSampler.h>
+
+#include "PrismaticKinematic.h"
+
+/**
+ * Model with a slab at the first joint in [-5, 5] covering half of the
+ * configuration space.
+ */
+class SlabModel : public rl::plan::SimpleModel
+{
+public:
+	using rl::plan::SimpleModel::isColliding;
+	
+	bool isColliding(const rl::math::Vector& q)
+	{
+		++this->totalQueries;
+		return std::abs(q(0)) <= 5;
+	}
+};
+
+bool
+checkSequence(rl::plan::UniformSampler& sampler, const std::string& name)
+{
+	const std::size_t n = 1000;
+	
+	rl::math::Vector maximum = sampler.getModel()->getMaximum();
+	rl::math::Vector minimum = sampler.getModel()->getMinimum();
+	
+	sampler.seed(1);
+	
+	std::vector<rl::math::Vector> samples;
+	
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		samples.push_back(sampler.generate());
+		
+		if (samples.back().size() != maximum.size())
+		{
+			std::cerr << name << " sample " << i << " has wrong size " << samples.back().size() << std::endl;
+			return false;
+		}
+		
+		if ((samples.back().array() < minimum.array()).any() || (samples.back().array() > maximum.array()).any())
+		{
+			std::cerr << name << " sample " << i << " out of range: " << samples.back().transpose() << std::endl;
+			return false;
+		}
+	}
+	
+	// same seed restarts the same sequence
+	
+	sampler.seed(1);
+	
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (sampler.generate() != samples[i])
+		{
+			std::cerr << name << " sample " << i << " differs after seed()" << std::endl;
+			return false;
+		}
+	}
+	
+	// different seed scrambles the sequence differently
+	
+	sampler.seed(2);
+	
+	std::size_t equal = 0;
+	
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		if (sampler.generate() == samples[i])
+		{
+			++equal;
+		}
+	}
+	
+	if (equal == n)
+	{
+		std::cerr << name << " sequence not changed by different seed" << std::endl;
+		return false;
+	}
+	
+	return true;
+}
+
+bool
+checkCollisionFree(rl::plan::Sampler& sampler, SlabModel& model, const std::string& name)
+{
+	const std::size_t n = 500;
+	
+	std::vector<rl::math::Vector> samples = sampler.generateCollisionFree(n);
+	
+	if (samples.size() != n)
+	{
+		std::cerr << name << " generated " << samples.size() << " instead of " << n << " samples" << std::endl;
+		return false;
+	}
+	
+	for (std::size_t i = 0; i < samples.size(); ++i)
+	{
+		if (model.isColliding(samples[i]))
+		{
+			std::cerr << name << " sample " << i << " in collision: " << samples[i].transpose() << std::endl;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+int
+main(int argc, char** argv)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = createPrismaticKinematic(3);
+	
+	SlabModel model;
+	model.mdl = kinematic.get();
+	
+	rl::plan::HaltonSampler haltonSampler;
+	haltonSampler.setModel(&model);
+	
+	if (!checkSequence(haltonSampler, "HaltonSampler"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	rl::plan::SobolSampler sobolSampler;
+	sobolSampler.setModel(&model);
+	
+	if (!checkSequence(sobolSampler, "SobolSampler"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	// batch generation in calling thread and with worker models
+	
+	rl::plan::UniformSampler uniformSampler;
+	uniformSampler.seed(0);
+	uniformSampler.setModel(&model);
+	
+	if (!checkCollisionFree(uniformSampler, model, "UniformSampler"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	std::vector<std::shared_ptr<rl::mdl::Kinematic>> kinematics;
+	std::vector<std::shared_ptr<SlabModel>> workers;
+	std::vector<rl::plan::SimpleModel*> models;
+	
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		kinematics.push_back(createPrismaticKinematic(3));
+		workers.push_back(std::make_shared<SlabModel>());
+		workers.back()->mdl = kinematics.back().get();
+		models.push_back(workers.back().get());
+	}
+	
+	uniformSampler.setModels(models);
+	
+	if (!checkCollisionFree(uniformSampler, model, "UniformSampler with worker models"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	haltonSampler.setModels(models);
+	
+	if (!checkCollisionFree(haltonSampler, model, "HaltonSampler with worker models"))
+	{
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/Fixed.h>
+#include <rl/mdl/Kinematic.h>
+#include <rl/mdl/Prismatic.h>
+#include <rl/mdl/World.h>
+#include <rl/plan/RecursiveVerifier.h>
+#include <rl/plan/ShortcutOptimizer.h>
+#include <rl/plan/SimpleModel.h>
+#include <rl/plan/VectorList.h>
+#include <rl/plan/Viewer.h>
+
+/**
+ * Model with an obstacle containing only configurations with the first
+ * joint exactly at 1 and the second joint above 0.
+ *
+ * Straight segments crossing the obstacle touch it in at most one
+ * configuration, it can only be hit by the vertices of partial shortcuts
+ * keeping the original motion of the first joint.
+ */
+class PlaneModel : public rl::plan::SimpleModel
+{
+public:
+	using rl::plan::SimpleModel::isColliding;
+	
+	bool isColliding(const rl::math::Vector& q)
+	{
+		++this->totalQueries;
+		return 1 == q(0) && q(1) > 0;
+	}
+};
+
+/**
+ * Viewer checking each intermediate path drawn by the optimizer.
+ */
+class PathViewer : public rl::plan::Viewer
+{
+public:
+	PathViewer(rl::plan::SimpleModel* model) :
+		colliding(0),
+		model(model)
+	{
+	}
+	
+	void drawConfiguration(const rl::math::Vector& q) {}
+	
+	void drawConfigurationEdge(const rl::math::Vector& q0, const rl::math::Vector& q1, const bool& free = true) {}
+	
+	void drawConfigurationPath(const rl::plan::VectorList& path)
+	{
+		for (rl::plan::VectorList::const_iterator i = path.begin(); i != path.end(); ++i)
+		{
+			if (this->model->isColliding(*i))
+			{
+				std::cerr << "Intermediate path collides in " << i->transpose() << std::endl;
+				++this->colliding;
+			}
+		}
+	}
+	
+	void drawConfigurationVertex(const rl::math::Vector& q, const bool& free = true) {}
+	
+	void drawLine(const rl::math::Vector& xyz0, const rl::math::Vector& xyz1) {}
+	
+	void drawPoint(const rl::math::Vector& xyz) {}
+	
+	void drawSphere(const rl::math::Vector& center, const rl::math::Real& radius) {}
+	
+	void drawWork(const rl::math::Transform& t) {}
+	
+	void drawWorkEdge(const rl::math::Vector& q0, const rl::math::Vector& q1) {}
+	
+	void drawWorkPath(const rl::plan::VectorList& path) {}
+	
+	void drawWorkVertex(const rl::math::Vector& q) {}
+	
+	void reset() {}
+	
+	void resetEdges() {}
+	
+	void resetLines() {}
+	
+	void resetPoints() {}
+	
+	void resetSpheres() {}
+	
+	void resetVertices() {}
+	
+	void showMessage(const std::string& message) {}
+	
+	std::size_t colliding;
+	
+	rl::plan::SimpleModel* model;
+};
+
+std::shared_ptr<rl::mdl::Kinematic>
+createKinematic()
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = std::make_shared<rl::mdl::Kinematic>();
+	
+	std::shared_ptr<rl::mdl::World> world = std::make_shared<rl::mdl::World>();
+	kinematic->add(world);
+	
+	std::shared_ptr<rl::mdl::Body> link0 = std::make_shared<rl::mdl::Body>();
+	kinematic->add(link0);
+	
+	std::shared_ptr<rl::mdl::Fixed> fixed0 = std::make_shared<rl::mdl::Fixed>();
+	kinematic->add(fixed0, world.get(), link0.get());
+	
+	rl::mdl::Frame* previous = link0.get();
+	
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		std::shared_ptr<rl::mdl::Body> link = std::make_shared<rl::mdl::Body>();
+		kinematic->add(link);
+		
+		std::shared_ptr<rl::mdl::Prismatic> joint = std::make_shared<rl::mdl::Prismatic>();
+		joint->setMaximum(rl::math::Vector::Constant(1, 10));
+		joint->setMinimum(rl::math::Vector::Constant(1, -10));
+		kinematic->add(joint, previous, link.get());
+		
+		previous = link.get();
+	}
+	
+	kinematic->update();
+	
+	return kinematic;
+}
+
+int
+main(int argc, char** argv)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = createKinematic();
+	
+	PlaneModel model;
+	model.mdl = kinematic.get();
+	
+	rl::plan::RecursiveVerifier verifier;
+	verifier.setDelta(static_cast<rl::math::Real>(0.01));
+	verifier.setModel(&model);
+	
+	PathViewer viewer(&model);
+	
+	rl::math::Vector a(2);
+	a << 0, 0;
+	rl::math::Vector b(2);
+	b << 1, 0;
+	rl::math::Vector c(2);
+	c << 2, 1;
+	
+	// partial shortcuts across b moving only the second joint hit the obstacle in a new vertex
+	
+	for (std::size_t i = 0; i < 20; ++i)
+	{
+		rl::plan::ShortcutOptimizer optimizer;
+		optimizer.seed(i);
+		optimizer.setBatchSize(1);
+		optimizer.setModel(&model);
+		optimizer.setPartialRatio(1);
+		optimizer.setVerifier(&verifier);
+		optimizer.setViewer(&viewer);
+		
+		rl::plan::VectorList path;
+		path.push_back(a);
+		path.push_back(b);
+		path.push_back(c);
+		
+		optimizer.process(path);
+		
+		if (0 == optimizer.getStatistics().applied)
+		{
+			std::cerr << "No shortcut applied with seed " << i << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (viewer.colliding > 0)
+		{
+			std::cerr << "Shortcut with colliding configuration applied with seed " << i << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+	
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <rl/plan/SimpleModel.h>
+
+#include "PrismaticKinematic.h"
+#include "SphereScene.h"
+
+int
+main(int argc, char** argv)
+{
+	std::shared_ptr<rl::mdl::Kinematic> kinematic = createPrismaticKinematic(2);
+	
+	// sphere of radius 0.5 moving in xy-plane, obstacle of radius 1 at (3, 0, 0)
+	
+	SphereScene scene;
+	
+	rl::sg::Model* robot = scene.create();
+	
+	for (std::size_t i = 0; i + 1 < kinematic->getBodies(); ++i)
+	{
+		robot->create();
+	}
+	
+	scene.createSphere(robot, static_cast<rl::math::Real>(0.5));
+	
+	rl::sg::Model* obstacles = scene.create();
+	rl::sg::Body* obstacle = scene.createSphere(obstacles, 1);
+	obstacle->setFrame(rl::math::Transform(rl::math::Translation(3, 0, 0)));
+	
+	rl::plan::SimpleModel model;
+	model.mdl = kinematic.get();
+	model.model = robot;
+	model.scene = &scene;
+	model.setCacheSize(100);
+	
+	rl::math::Vector q(2);
+	q << 0, 0;
+	
+	if (model.isColliding(q) || model.isColliding(q))
+	{
+		std::cerr << "Free configuration " << q.transpose() << " colliding" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (1 != model.getCacheHits())
+	{
+		std::cerr << "Cache hits " << model.getCacheHits() << " != 1 for repeated query" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// cached results are discarded after moving obstacle onto configuration
+	
+	obstacle->setFrame(rl::math::Transform(rl::math::Translation(1, 0, 0)));
+	
+	if (!model.isColliding(q))
+	{
+		std::cerr << "Cached result used after moving obstacle" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// cached results are discarded after adding obstacle onto configuration
+	
+	q << 0, 3;
+	
+	if (model.isColliding(q))
+	{
+		std::cerr << "Free configuration " << q.transpose() << " colliding" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	scene.createSphere(scene.create(), 1)->setFrame(rl::math::Transform(rl::math::Translation(0, 3, 0)));
+	
+	if (!model.isColliding(q))
+	{
+		std::cerr << "Cached result used after adding obstacle" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	// cached results are discarded after updating pairs
+	
+	std::size_t misses = model.getCacheMisses();
+	model.updatePairs();
+	model.isColliding(q);
+	
+	if (misses + 1 != model.getCacheMisses())
+	{
+		std::cerr << "Cached result used after updating pairs" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
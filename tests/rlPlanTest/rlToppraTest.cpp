@@ -0,0 +1,258 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <rl/math/Spline.h>
+#include <rl/mdl/Body.h>
+#include <rl/mdl/Dynamic.h>
+#include <rl/mdl/Prismatic.h>
+#include <rl/mdl/World.h>
+#include <rl/plan/Exception.h>
+#include <rl/plan/Path.h>
+#include <rl/plan/Toppra.h>
+
+bool
+check(const rl::math::Spline<rl::math::Vector>& trajectory, const rl::math::Real& q0, const rl::math::Real& q1, const rl::math::Real& duration, const rl::math::Real& velocity, const rl::math::Real& acceleration)
+{
+	rl::math::Real epsilon = Eigen::NumTraits<rl::math::Real>::dummy_precision();
+	
+	bool result = true;
+	
+	// time-optimal duration of discretized path approaches analytic bang-bang solution
+	if (std::abs(trajectory.duration() - duration) > static_cast<rl::math::Real>(0.01) * duration)
+	{
+		std::cerr << "duration " << trajectory.duration() << " != " << duration << std::endl;
+		result = false;
+	}
+	
+	if (std::abs(trajectory(trajectory.lower())(0) - q0) > epsilon || std::abs(trajectory(trajectory.upper())(0) - q1) > epsilon)
+	{
+		std::cerr << "f(" << trajectory.lower() << ") != " << q0 << " or f(" << trajectory.upper() << ") != " << q1 << std::endl;
+		result = false;
+	}
+	
+	if (std::abs(trajectory(trajectory.lower(), 1)(0)) > epsilon || std::abs(trajectory(trajectory.upper(), 1)(0)) > epsilon)
+	{
+		std::cerr << "trajectory does not start and end at rest" << std::endl;
+		result = false;
+	}
+	
+	// derivatives of cubics over short intervals lose precision
+	rl::math::Real tolerance = static_cast<rl::math::Real>(1.0e-6);
+	
+	for (std::size_t i = 0; i < trajectory.size(); ++i)
+	{
+		const rl::math::Polynomial<rl::math::Vector>& polynomial = trajectory[i];
+		
+		for (std::size_t j = 0; j < 2; ++j)
+		{
+			rl::math::Real x = 0 == j ? polynomial.lower() : polynomial.upper();
+			
+			if (std::abs(polynomial(x, 1)(0)) > velocity * (1 + tolerance))
+			{
+				std::cerr << "abs(fd(" << x << ")) = " << std::abs(polynomial(x, 1)(0)) << " > " << velocity << " in polynomial " << i << std::endl;
+				result = false;
+			}
+			
+			if (std::abs(polynomial(x, 2)(0)) > acceleration * (1 + tolerance))
+			{
+				std::cerr << "abs(fdd(" << x << ")) = " << std::abs(polynomial(x, 2)(0)) << " > " << acceleration << " in polynomial " << i << std::endl;
+				result = false;
+			}
+		}
+	}
+	
+	return result;
+}
+
+rl::math::Real
+bangBang(const rl::math::Real& distance, const rl::math::Real& velocity, const rl::math::Real& acceleration)
+{
+	if (distance >= velocity * velocity / acceleration)
+	{
+		return distance / velocity + velocity / acceleration;
+	}
+	else
+	{
+		return 2 * std::sqrt(distance / acceleration);
+	}
+}
+
+/**
+ * Create single prismatic joint moving body of given mass along x-axis.
+ */
+std::shared_ptr<rl::mdl::Dynamic>
+createDynamic(const rl::math::Real& mass)
+{
+	std::shared_ptr<rl::mdl::Dynamic> dynamic = std::make_shared<rl::mdl::Dynamic>();
+	
+	std::shared_ptr<rl::mdl::World> world = std::make_shared<rl::mdl::World>();
+	world->setGravity(rl::math::Vector3(0, 0, static_cast<rl::math::Real>(9.81)));
+	dynamic->add(world);
+	
+	std::shared_ptr<rl::mdl::Body> body = std::make_shared<rl::mdl::Body>();
+	body->setMass(mass);
+	body->setInertia(1, 1, 1, 0, 0, 0);
+	dynamic->add(body);
+	
+	std::shared_ptr<rl::mdl::Prismatic> joint = std::make_shared<rl::mdl::Prismatic>();
+	joint->S.setZero();
+	joint->S(3, 0) = 1;
+	dynamic->add(joint, world.get(), body.get());
+	
+	dynamic->update();
+	
+	return dynamic;
+}
+
+int
+main(int argc, char** argv)
+{
+	rl::math::Real velocity = 1;
+	rl::math::Real acceleration = 2;
+	
+	rl::plan::Toppra toppra;
+	toppra.setAcceleration(rl::math::Vector::Constant(1, acceleration));
+	toppra.setGridPoints(1000);
+	toppra.setVelocity(rl::math::Vector::Constant(1, velocity));
+	
+	bool result = true;
+	
+	// long distance reaching maximum velocity and short distance only accelerating and decelerating
+	
+	rl::math::Real distances[] = {2, static_cast<rl::math::Real>(0.2)};
+	
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		rl::plan::Path path;
+		path.push_back(rl::math::Vector::Constant(1, 0));
+		path.push_back(rl::math::Vector::Constant(1, distances[i]));
+		
+		if (!check(toppra.process(path), 0, distances[i], bangBang(distances[i], velocity, acceleration), velocity, acceleration))
+		{
+			std::cerr << "segment of length " << distances[i] << " failed" << std::endl;
+			result = false;
+		}
+	}
+	
+	// waypoints on a straight line are passed without stopping
+	
+	rl::plan::Path line;
+	line.push_back(rl::math::Vector::Constant(1, 0));
+	line.push_back(rl::math::Vector::Constant(1, 1));
+	line.push_back(rl::math::Vector::Constant(1, 1));
+	line.push_back(rl::math::Vector::Constant(1, 2));
+	
+	if (!check(toppra.process(line), 0, 2, bangBang(2, velocity, acceleration), velocity, acceleration))
+	{
+		std::cerr << "straight line with intermediate waypoints failed" << std::endl;
+		result = false;
+	}
+	
+	// trajectory stops at waypoint where direction changes
+	
+	rl::plan::Path reversal;
+	reversal.push_back(rl::math::Vector::Constant(1, 0));
+	reversal.push_back(rl::math::Vector::Constant(1, 2));
+	reversal.push_back(rl::math::Vector::Constant(1, 1));
+	
+	rl::math::Spline<rl::math::Vector> trajectory = toppra.process(reversal);
+	
+	if (!check(trajectory, 0, 1, bangBang(2, velocity, acceleration) + bangBang(1, velocity, acceleration), velocity, acceleration))
+	{
+		std::cerr << "path with reversal failed" << std::endl;
+		result = false;
+	}
+	
+	rl::math::Real maximum = 0;
+	
+	for (std::size_t i = 0; i < trajectory.size(); ++i)
+	{
+		maximum = std::max(maximum, std::max(trajectory[i](trajectory[i].lower())(0), trajectory[i](trajectory[i].upper())(0)));
+	}
+	
+	if (maximum > 2 + Eigen::NumTraits<rl::math::Real>::dummy_precision())
+	{
+		std::cerr << "trajectory overshoots waypoint with " << maximum << " > 2" << std::endl;
+		result = false;
+	}
+	
+	// force limit of joint moving mass perpendicular to gravity limits acceleration to force / mass
+	
+	std::shared_ptr<rl::mdl::Dynamic> dynamic = createDynamic(static_cast<rl::math::Real>(0.5));
+	
+	toppra.setAcceleration(rl::math::Vector::Constant(1, 10));
+	toppra.setDynamic(dynamic.get());
+	toppra.setTorque(rl::math::Vector::Constant(1, 1));
+	
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		rl::plan::Path path;
+		path.push_back(rl::math::Vector::Constant(1, 0));
+		path.push_back(rl::math::Vector::Constant(1, distances[i]));
+		
+		if (!check(toppra.process(path), 0, distances[i], bangBang(distances[i], velocity, acceleration), velocity, acceleration))
+		{
+			std::cerr << "segment of length " << distances[i] << " with force limit failed" << std::endl;
+			result = false;
+		}
+	}
+	
+	// force limit below gravity load along joint axis cannot be satisfied
+	
+	dynamic->setWorldGravity(rl::math::Vector3(static_cast<rl::math::Real>(9.81), 0, 0));
+	
+	try
+	{
+		toppra.process(line);
+		std::cerr << "process() with force limit below gravity load did not throw" << std::endl;
+		result = false;
+	}
+	catch (const rl::plan::Exception& e)
+	{
+	}
+	
+	toppra.setAcceleration(rl::math::Vector::Constant(1, acceleration));
+	toppra.setDynamic(nullptr);
+	
+	// velocity limits of model are required if none are set
+	
+	toppra.setVelocity(rl::math::Vector());
+	
+	try
+	{
+		toppra.process(line);
+		std::cerr << "process() without velocity limits and model did not throw" << std::endl;
+		result = false;
+	}
+	catch (const rl::plan::Exception& e)
+	{
+	}
+	
+	return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2009, Markus Rickert
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+#include <cstdlib>
+#include <iostream>
+#include <rl/plan/Exception.h>
+#include <rl/plan/VectorPool.h>
+
+int
+main(int argc, char** argv)
+{
+	rl::plan::VectorPool pool(2);
+	
+	rl::plan::VectorPtr q0 = pool.allocate(3);
+	rl::plan::VectorPtr q1 = pool.allocate(rl::math::Vector::Constant(3, 1));
+	rl::plan::VectorPtr q2 = pool.allocate(3);
+	
+	if (3 != pool.size() || 4 != pool.capacity())
+	{
+		std::cerr << "size " << pool.size() << " != 3 or capacity " << pool.capacity() << " != 4" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	if (!q1->isApprox(rl::math::Vector::Constant(3, 1)))
+	{
+		std::cerr << "allocate(q) != q" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		pool.deallocate(q1);
+		std::cerr << "deallocate() of configuration other than most recent one did not throw" << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch (const rl::plan::Exception& e)
+	{
+	}
+	
+	if (3 != pool.size())
+	{
+		std::cerr << "size " << pool.size() << " != 3 after rejected deallocate()" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	pool.deallocate(q2);
+	
+	if (2 != pool.size())
+	{
+		std::cerr << "size " << pool.size() << " != 2 after deallocate()" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	rl::plan::VectorPtr q3 = pool.allocate(3);
+	
+	if (q3.get() != q2.get())
+	{
+		std::cerr << "deallocated slot not reused" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	pool.clear();
+	
+	if (0 != pool.size() || 4 != pool.capacity())
+	{
+		std::cerr << "size " << pool.size() << " != 0 or capacity " << pool.capacity() << " != 4 after clear()" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	try
+	{
+		pool.deallocate(q0);
+		std::cerr << "deallocate() on empty pool did not throw" << std::endl;
+		return EXIT_FAILURE;
+	}
+	catch (const rl::plan::Exception& e)
+	{
+	}
+	
+	rl::plan::VectorPtr q4 = pool.allocate(3);
+	
+	if (q4.get() != q0.get())
+	{
+		std::cerr << "slot not reused after clear()" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	pool.release();
+	
+	if (0 != pool.size() || 0 != pool.capacity())
+	{
+		std::cerr << "size " << pool.size() << " != 0 or capacity " << pool.capacity() << " != 0 after release()" << std::endl;
+		return EXIT_FAILURE;
+	}
+	
+	return EXIT_SUCCESS;
+}
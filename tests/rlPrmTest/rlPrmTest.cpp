@@ -24,19 +24,25 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //
 
+#include <cstdio>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <stdexcept>
+#include <vector>
+#include <boost/graph/incremental_components.hpp>
 #include <boost/lexical_cast.hpp>
 #include <rl/math/Constants.h>
 #include <rl/mdl/Kinematic.h>
 #include <rl/mdl/XmlFactory.h>
+#include <rl/plan/Exception.h>
 #include <rl/plan/KdtreeNearestNeighbors.h>
 #include <rl/plan/Prm.h>
 #include <rl/plan/RecursiveVerifier.h>
 #include <rl/plan/SimpleModel.h>
 #include <rl/plan/SimpleOptimizer.h>
 #include <rl/plan/UniformSampler.h>
+#include <rl/sg/Body.h>
 #include <rl/sg/Model.h>
 #include <rl/sg/XmlFactory.h>
 
@@ -56,6 +62,56 @@
 #include <rl/sg/solid/Scene.h>
 #endif // RL_SG_SOLID
 
+class RepairPrm : public rl::plan::Prm
+{
+public:
+	/**
+	 * Check that no vertex collides, that verified edges are collision-free,
+	 * and that vertex indices and connected components are consistent.
+	 */
+	bool isConsistent()
+	{
+		std::vector<bool> indices(boost::num_vertices(this->graph), false);
+		
+		for (VertexIteratorPair i = boost::vertices(this->graph); i.first != i.second; ++i.first)
+		{
+			if (this->getModel()->isColliding(*this->graph[*i.first].q))
+			{
+				std::cerr << "Colliding vertex remains in roadmap" << std::endl;
+				return false;
+			}
+			
+			if (this->graph[*i.first].index >= indices.size() || indices[this->graph[*i.first].index])
+			{
+				std::cerr << "Vertex index " << this->graph[*i.first].index << " is out of range or not unique" << std::endl;
+				return false;
+			}
+			
+			indices[this->graph[*i.first].index] = true;
+		}
+		
+		for (EdgeIteratorPair i = boost::edges(this->graph); i.first != i.second; ++i.first)
+		{
+			Vertex u = boost::source(*i.first, this->graph);
+			Vertex v = boost::target(*i.first, this->graph);
+			
+			if (this->graph[*i.first].verified && this->getVerifier()->isColliding(*this->graph[u].q, *this->graph[v].q, this->graph[*i.first].weight))
+			{
+				std::cerr << "Colliding edge remains verified in roadmap" << std::endl;
+				return false;
+			}
+			
+			if (!boost::same_component(u, v, this->ds))
+			{
+				std::cerr << "Connected vertices are in different components" << std::endl;
+				return false;
+			}
+		}
+		
+		return true;
+	}
+};
+
 int
 main(int argc, char** argv)
 {
@@ -190,21 +246,141 @@ main(int argc, char** argv)
 		
 		std::cout << "NumVertices: " << planner.getNumVertices() << "  NumEdges: " << planner.getNumEdges() << std::endl;
 		
-		if (solved)
+		if (!solved)
 		{
-			if (boost::lexical_cast<std::size_t>(argv[4]) >= planner.getNumVertices() &&
-				boost::lexical_cast<std::size_t>(argv[5]) >= planner.getNumEdges())
-			{
-				return EXIT_SUCCESS;
-			}
-			else
-			{
-				std::cerr << "NumVertices and NumEdges are more than expected for this test case.";
-				return EXIT_FAILURE;
-			}
+			return EXIT_FAILURE;
 		}
 		
-		return EXIT_FAILURE;
+		if (boost::lexical_cast<std::size_t>(argv[4]) < planner.getNumVertices() ||
+			boost::lexical_cast<std::size_t>(argv[5]) < planner.getNumEdges())
+		{
+			std::cerr << "NumVertices and NumEdges are more than expected for this test case.";
+			return EXIT_FAILURE;
+		}
+		
+		std::stringstream filename;
+		filename << argv[0] << "-" << argv[1];
+		
+		for (int i = 12; i < argc; ++i)
+		{
+			filename << "_" << argv[i];
+		}
+		
+		filename << ".roadmap";
+		
+		std::cout << "save() ... " << std::endl;
+		planner.save(filename.str());
+		
+		rl::plan::KdtreeNearestNeighbors nearestNeighbors2(&model);
+		RepairPrm planner2;
+		planner2.setModel(&model);
+		planner2.setNearestNeighbors(&nearestNeighbors2);
+		planner2.setSampler(&sampler);
+		planner2.setVerifier(&verifier);
+		planner2.setStart(&start);
+		planner2.setGoal(&goal);
+		
+		std::cout << "load() ... " << std::endl;
+		planner2.load(filename.str());
+		
+		if (planner.getNumVertices() != planner2.getNumVertices() || planner.getNumEdges() != planner2.getNumEdges())
+		{
+			std::cerr << "Loaded roadmap has " << planner2.getNumVertices() << " vertices and " << planner2.getNumEdges() << " edges instead of " << planner.getNumVertices() << " and " << planner.getNumEdges() << std::endl;
+			std::remove(filename.str().c_str());
+			return EXIT_FAILURE;
+		}
+		
+		if (!planner2.solve())
+		{
+			std::cerr << "solve() with loaded roadmap failed" << std::endl;
+			std::remove(filename.str().c_str());
+			return EXIT_FAILURE;
+		}
+		
+		// roadmap is stale after moving an obstacle or changing the kinematics
+		
+		rl::sg::Body* obstacle = scene->getModel(1)->getBody(0);
+		rl::math::Transform frame = obstacle->getFrame();
+		rl::math::Transform moved = frame;
+		moved.translation().z() += 1;
+		obstacle->setFrame(moved);
+		
+		bool rejected = false;
+		
+		try
+		{
+			planner2.load(filename.str());
+		}
+		catch (const rl::plan::Exception& e)
+		{
+			rejected = true;
+		}
+		
+		obstacle->setFrame(frame);
+		
+		if (!rejected)
+		{
+			std::cerr << "load() did not reject roadmap after moving obstacle" << std::endl;
+			std::remove(filename.str().c_str());
+			return EXIT_FAILURE;
+		}
+		
+		kinematic->world().translation().z() += 1;
+		
+		rejected = false;
+		
+		try
+		{
+			planner2.load(filename.str());
+		}
+		catch (const rl::plan::Exception& e)
+		{
+			rejected = true;
+		}
+		
+		kinematic->world() = world;
+		
+		std::remove(filename.str().c_str());
+		
+		if (!rejected)
+		{
+			std::cerr << "load() did not reject roadmap after changing kinematics" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		// raise floor of obstacle to height of last body in goal configuration
+		
+		model.setPosition(goal);
+		model.updateFrames();
+		
+		moved = frame;
+		moved.translation().z() += model.getFrame(model.getBodies() - 1).translation().z();
+		obstacle->setFrame(moved);
+		
+		if (!model.isColliding(goal))
+		{
+			std::cerr << "Goal configuration does not collide with moved obstacle" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		std::size_t vertices = planner2.getNumVertices();
+		
+		std::cout << "repair() ... " << std::endl;
+		planner2.repair(std::vector<rl::sg::Body*>(1, obstacle));
+		std::cout << "NumVertices: " << planner2.getNumVertices() << "  NumEdges: " << planner2.getNumEdges() << std::endl;
+		
+		if (planner2.getNumVertices() >= vertices)
+		{
+			std::cerr << "repair() did not remove colliding vertices" << std::endl;
+			return EXIT_FAILURE;
+		}
+		
+		if (!planner2.isConsistent())
+		{
+			return EXIT_FAILURE;
+		}
+		
+		return EXIT_SUCCESS;
 	}
 	catch (const std::exception& e)
 	{